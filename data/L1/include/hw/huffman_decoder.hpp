@@ -34,11 +34,11 @@ typedef ap_uint<48> bitBufferType;
 namespace details {
 
 enum blockStatus { PENDING = 0, FINISH = 1 };
-void loadBitStream(bitBufferType& bitbuffer,
-                   ap_uint<6>& bits_cntr,
-                   hls::stream<ap_uint<16> >& inStream,
-                   hls::stream<bool>& inEos,
-                   bool& done) {
+inline void loadBitStream(bitBufferType& bitbuffer,
+                          ap_uint<6>& bits_cntr,
+                          hls::stream<ap_uint<16> >& inStream,
+                          hls::stream<bool>& inEos,
+                          bool& done) {
 #pragma HLS INLINE off
     while (bits_cntr < 32 && (done == false)) {
     loadBitStream:
@@ -49,11 +49,11 @@ void loadBitStream(bitBufferType& bitbuffer,
     }
 }
 
-void loadBitStreamLL(bitBufferTypeLL& bitbuffer,
-                     ap_uint<6>& bits_cntr,
-                     hls::stream<ap_uint<16> >& inStream,
-                     hls::stream<bool>& inEos,
-                     bool& done) {
+inline void loadBitStreamLL(bitBufferTypeLL& bitbuffer,
+                            ap_uint<6>& bits_cntr,
+                            hls::stream<ap_uint<16> >& inStream,
+                            hls::stream<bool>& inEos,
+                            bool& done) {
     if (bits_cntr < 16 && (done == false)) {
     loadBitStream:
         uint16_t tmp_dt = (uint16_t)inStream.read();
@@ -63,12 +63,12 @@ void loadBitStreamLL(bitBufferTypeLL& bitbuffer,
     }
 }
 
-void discardBitStream(bitBufferType& bitbuffer, ap_uint<6>& bits_cntr, ap_uint<6> n_bits) {
+inline void discardBitStream(bitBufferType& bitbuffer, ap_uint<6>& bits_cntr, ap_uint<6> n_bits) {
     bitbuffer >>= n_bits;
     bits_cntr -= n_bits;
 }
 
-void discardBitStreamLL(bitBufferTypeLL& bitbuffer, ap_uint<6>& bits_cntr, ap_uint<6> n_bits) {
+inline void discardBitStreamLL(bitBufferTypeLL& bitbuffer, ap_uint<6>& bits_cntr, ap_uint<6> n_bits) {
 #pragma HLS INLINE off
     bitbuffer >>= n_bits;
     bits_cntr -= n_bits;
@@ -164,16 +164,16 @@ ByteGenStatic:
     return ret;
 }
 
-uint8_t huffmanBytegen(bitBufferType& _bitbuffer,
-                       ap_uint<6>& bits_cntr,
-                       hls::stream<ap_uint<17> >& outStream,
-                       hls::stream<bool>& inEos,
-                       hls::stream<ap_uint<16> >& inStream,
-                       const uint32_t* array_codes,
-                       const uint32_t* array_codes_extra,
-                       const uint32_t* array_codes_dist,
-                       const uint32_t* array_codes_dist_extra,
-                       bool& done) {
+inline uint8_t huffmanBytegen(bitBufferType& _bitbuffer,
+                              ap_uint<6>& bits_cntr,
+                              hls::stream<ap_uint<17> >& outStream,
+                              hls::stream<bool>& inEos,
+                              hls::stream<ap_uint<16> >& inStream,
+                              const uint32_t* array_codes,
+                              const uint32_t* array_codes_extra,
+                              const uint32_t* array_codes_dist,
+                              const uint32_t* array_codes_dist_extra,
+                              bool& done) {
 #pragma HLS INLINE
     uint16_t lit_mask = 511; // Adjusted according to 8 bit
     uint16_t dist_mask = 511;
@@ -277,29 +277,29 @@ ByteGen:
     return ret;
 }
 
-uint8_t huffmanBytegenLL(bitBufferTypeLL& _bitbuffer,
-                         ap_uint<6>& bits_cntr,
-                         hls::stream<ap_uint<16> >& outStream,
-                         hls::stream<bool>& inEos,
-                         hls::stream<ap_uint<16> >& inStream,
-                         ap_uint<16> (&codeOffsets)[2][15],
-                         ap_uint<9> (&bl1Codes)[2][2],
-                         ap_uint<9> (&bl2Codes)[2][4],
-                         ap_uint<9> (&bl3Codes)[2][8],
-                         ap_uint<9> (&bl4Codes)[2][16],
-                         ap_uint<9> (&bl5Codes)[2][32],
-                         ap_uint<9> (&bl6Codes)[2][64],
-                         ap_uint<9> (&bl7Codes)[2][128],
-                         ap_uint<9> (&bl8Codes)[2][256],
-                         ap_uint<9> (&bl9Codes)[2][256],
-                         ap_uint<9> (&bl10Codes)[2][256],
-                         ap_uint<9> (&bl11Codes)[2][256],
-                         ap_uint<9> (&bl12Codes)[2][256],
-                         ap_uint<9> (&bl13Codes)[2][256],
-                         ap_uint<9> (&bl14Codes)[2][256],
-                         ap_uint<9> (&bl15Codes)[2][256],
-                         bool& done,
-                         uint8_t ignoreValue) {
+inline uint8_t huffmanBytegenLL(bitBufferTypeLL& _bitbuffer,
+                                ap_uint<6>& bits_cntr,
+                                hls::stream<ap_uint<16> >& outStream,
+                                hls::stream<bool>& inEos,
+                                hls::stream<ap_uint<16> >& inStream,
+                                ap_uint<16> (&codeOffsets)[2][15],
+                                ap_uint<9> (&bl1Codes)[2][2],
+                                ap_uint<9> (&bl2Codes)[2][4],
+                                ap_uint<9> (&bl3Codes)[2][8],
+                                ap_uint<9> (&bl4Codes)[2][16],
+                                ap_uint<9> (&bl5Codes)[2][32],
+                                ap_uint<9> (&bl6Codes)[2][64],
+                                ap_uint<9> (&bl7Codes)[2][128],
+                                ap_uint<9> (&bl8Codes)[2][256],
+                                ap_uint<9> (&bl9Codes)[2][256],
+                                ap_uint<9> (&bl10Codes)[2][256],
+                                ap_uint<9> (&bl11Codes)[2][256],
+                                ap_uint<9> (&bl12Codes)[2][256],
+                                ap_uint<9> (&bl13Codes)[2][256],
+                                ap_uint<9> (&bl14Codes)[2][256],
+                                ap_uint<9> (&bl15Codes)[2][256],
+                                bool& done,
+                                uint8_t ignoreValue) {
     ap_uint<15> validCodeOffset[2];
     ap_uint<4> current_bits[2];
 #pragma HLS ARRAY_PARTITION variable = current_bits complete dim = 0
@@ -436,22 +436,22 @@ ByteGen:
     return ret;
 }
 
-void byteGen(bitBufferTypeLL& _bitbuffer,
-             ap_uint<6>& bits_cntr,
-             ap_uint<16>* codeOffsets,
-             ap_uint<9>* bl1Codes,
-             ap_uint<9>* bl2Codes,
-             ap_uint<9>* bl3Codes,
-             ap_uint<9>* bl4Codes,
-             ap_uint<9>* bl5Codes,
-             ap_uint<9>* bl6Codes,
-             ap_uint<9>* bl7Codes,
-             ap_uint<5>* lens,
-             hls::stream<bool>& inEos,
-             hls::stream<ap_uint<16> >& inStream,
-             ap_uint<9> nlen,
-             ap_uint<9> ndist,
-             bool& done) {
+inline void byteGen(bitBufferTypeLL& _bitbuffer,
+                    ap_uint<6>& bits_cntr,
+                    ap_uint<16>* codeOffsets,
+                    ap_uint<9>* bl1Codes,
+                    ap_uint<9>* bl2Codes,
+                    ap_uint<9>* bl3Codes,
+                    ap_uint<9>* bl4Codes,
+                    ap_uint<9>* bl5Codes,
+                    ap_uint<9>* bl6Codes,
+                    ap_uint<9>* bl7Codes,
+                    ap_uint<5>* lens,
+                    hls::stream<bool>& inEos,
+                    hls::stream<ap_uint<16> >& inStream,
+                    ap_uint<9> nlen,
+                    ap_uint<9> ndist,
+                    bool& done) {
     loadBitStreamLL(_bitbuffer, bits_cntr, inStream, inEos, done);
     uint8_t copy = 0;
     uint8_t extra_copy = 0;
@@ -535,7 +535,7 @@ bytegen:
     }
 }
 
-void code_generator_array_dyn(
+inline void code_generator_array_dyn(
     uint8_t curr_table, uint16_t* lens, ap_uint<9> codes, uint32_t* table, uint32_t* table_extra, uint32_t bits) {
 /**
  * @brief This module regenerates the code values based on bit length
@@ -743,25 +743,25 @@ code_gen:
     }
 }
 
-void code_generator_array_dyn_new(uint8_t curr_table,
-                                  ap_uint<5>* lens,
-                                  ap_uint<9> codes,
-                                  ap_uint<16>* codeOffsets,
-                                  ap_uint<9>* bl1Codes,
-                                  ap_uint<9>* bl2Codes,
-                                  ap_uint<9>* bl3Codes,
-                                  ap_uint<9>* bl4Codes,
-                                  ap_uint<9>* bl5Codes,
-                                  ap_uint<9>* bl6Codes,
-                                  ap_uint<9>* bl7Codes,
-                                  ap_uint<9>* bl8Codes,
-                                  ap_uint<9>* bl9Codes,
-                                  ap_uint<9>* bl10Codes,
-                                  ap_uint<9>* bl11Codes,
-                                  ap_uint<9>* bl12Codes,
-                                  ap_uint<9>* bl13Codes,
-                                  ap_uint<9>* bl14Codes,
-                                  ap_uint<9>* bl15Codes) {
+inline void code_generator_array_dyn_new(uint8_t curr_table,
+                                         ap_uint<5>* lens,
+                                         ap_uint<9> codes,
+                                         ap_uint<16>* codeOffsets,
+                                         ap_uint<9>* bl1Codes,
+                                         ap_uint<9>* bl2Codes,
+                                         ap_uint<9>* bl3Codes,
+                                         ap_uint<9>* bl4Codes,
+                                         ap_uint<9>* bl5Codes,
+                                         ap_uint<9>* bl6Codes,
+                                         ap_uint<9>* bl7Codes,
+                                         ap_uint<9>* bl8Codes,
+                                         ap_uint<9>* bl9Codes,
+                                         ap_uint<9>* bl10Codes,
+                                         ap_uint<9>* bl11Codes,
+                                         ap_uint<9>* bl12Codes,
+                                         ap_uint<9>* bl13Codes,
+                                         ap_uint<9>* bl14Codes,
+                                         ap_uint<9>* bl15Codes) {
     uint16_t min = 15;
     uint16_t max = 0;
 
@@ -206,7 +206,8 @@ void lzPreProcessingUnitLL(hls::stream<SIZE_DT>& inLitLen,
     bool read = false;
     bool fdone = false;
 
-    if (litlen == 0) {
+    // a block may start with a match when it refers to a preset dictionary
+    if (litlen == 0 && matchlen == 0) {
         outVal.range(OWIDTH - 1, 0) = 0;
         outVal.range(OWIDTH + 3, OWIDTH) = matchlen;
         outVal.range(OWIDTH + 7, OWIDTH + 4) = litlen;
@@ -226,19 +227,21 @@ void lzPreProcessingUnitLL(hls::stream<SIZE_DT>& inLitLen,
             l_matchloc = 0;
             read = (matchlen || litlen) ? false : true;
         } else {
-            l_matchlen = (offset > PARALLEL_BYTES)
-                             ? ((matchlen > PARALLEL_BYTES) ? (SIZE_DT)PARALLEL_BYTES : (SIZE_DT)matchlen)
-                             : (matchlen > offset) ? (SIZE_DT)offset : (SIZE_DT)matchlen;
-            if (offset < 6 * PARALLEL_BYTES) {
+            l_matchlen = (matchlen > PARALLEL_BYTES) ? (SIZE_DT)PARALLEL_BYTES : (SIZE_DT)matchlen;
+            if (offset < PARALLEL_BYTES) {
+                // overlapping match, replicated from the last output bytes,
+                // match location carries the offset
+                l_stateinfo.range(0, 0) = 0;
+                l_stateinfo.range(2, 1) = 2;
+                l_matchloc = offset;
+            } else if (offset < 6 * PARALLEL_BYTES) {
                 l_stateinfo.range(0, 0) = 1;
                 l_stateinfo.range(2, 1) = 1;
+                l_matchloc = litCount - offset;
             } else {
                 l_stateinfo.range(0, 0) = 0;
                 l_stateinfo.range(2, 1) = 1;
-            }
-            l_matchloc = litCount - offset;
-            if (offset < PARALLEL_BYTES) {
-                offset = offset << 1;
+                l_matchloc = litCount - offset;
             }
             l_litlen = 0;
             litCount += l_matchlen;
@@ -1081,9 +1084,9 @@ void streamMultiDistributor(hls::stream<ap_uint<(DATA_WIDTH * 8) + DATA_WIDTH> >
  * @param checkSum2 2nd checksum input
  * @param output error output
  */
-void chckSumComparator(hls::stream<ap_uint<32> >& checkSum1,
-                       hls::stream<ap_uint<32> >& checkSum2,
-                       hls::stream<bool>& output) {
+inline void chckSumComparator(hls::stream<ap_uint<32> >& checkSum1,
+                              hls::stream<ap_uint<32> >& checkSum2,
+                              hls::stream<bool>& output) {
     auto chk1 = checkSum1.read();
     auto chk2 = checkSum2.read();
     output << (chk1 != chk2);
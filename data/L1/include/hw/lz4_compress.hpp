@@ -283,6 +283,23 @@ namespace xf {
                 endOfStream << true;
             }
 
+            // 字典复制两份：一份给 lzCompress 插入哈希字典，一份给 Booster 预置历史
+            template <class data_t>
+            static void lz4DictDup(hls::stream<data_t>& dictStream,
+                hls::stream<ap_uint<8> >& compressDictStream,
+                hls::stream<ap_uint<8> >& boosterDictStream,
+                uint32_t dict_size,
+                uint32_t input_size) {
+#pragma HLS INLINE off
+                if (input_size == 0) return;
+                for (uint32_t i = 0; i < dict_size; ++i) {
+#pragma HLS PIPELINE II = 1
+                    ap_uint<8> ch = dictStream.read();
+                    compressDictStream << ch;
+                    boosterDictStream << ch;
+                }
+            }
+
         } // namespace details
     } // namespace compression
 } // namespace xf
@@ -314,7 +331,7 @@ namespace xf {
 
         template <class data_t, int DATAWIDTH = 512, int BURST_SIZE = 16, int NUM_BLOCK = 8,
             int M_LEN = 6, int MIN_MAT = 4, int LZ_MAX_OFFSET_LIM = 65536, int OFFSET_WIN = 65536,
-            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096, int MIN_B_SIZE = 128>
+            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096, int MIN_B_SIZE = 128, int LAZY_STEPS = 0>
         void hlsLz4Core(hls::stream<data_t>& inStream,
             hls::stream<data_t>& outStream,
             hls::stream<bool>& outStreamEos,
@@ -336,14 +353,99 @@ namespace xf {
 #pragma HLS DATAFLOW
             xf::compression::lzCompress<M_LEN, MIN_MAT, LZ_MAX_OFFSET_LIM>(inStream, compressdStream, input_size);
             xf::compression::lzBestMatchFilter<M_LEN, OFFSET_WIN>(compressdStream, bestMatchStream, input_size);
-            xf::compression::lzBooster<MAX_M_LEN>(bestMatchStream, boosterStream, input_size);
+            // LAZY_STEPS 为 0 时使用贪心 lzBooster，1/2 时使用 lzLazyBooster
+            xf::compression::details::lzBoosterStage<MAX_M_LEN, LAZY_STEPS>::run(bestMatchStream, boosterStream, input_size);
+            xf::compression::lz4Compress<MAX_LIT_CNT, NUM_BLOCK>(
+                boosterStream, outStream, max_lit_limit, input_size, outStreamEos, compressedSize, core_idx);
+        }
+
+        // 多字节 LZ4 核：每拍读入 PARALLEL_BYTES 字节，匹配查找、选优过滤和 Booster 都按字处理，
+        // 之后 lzTokenSerializer 每拍给 lz4Compress 一条记录（一个字面量或一整段匹配），lz4Compress 每拍写一个输出字节。
+        // 因此输入速率约为 min(PARALLEL_BYTES, 每条记录平均覆盖的字节数, 压缩比) 字节/拍：
+        // 64KB 文本块上每条记录约 7 字节、压缩比约 3.7，PARALLEL_BYTES = 8 时约 3.7 字节/拍，
+        // 不可压缩数据仍为 1 字节/拍；
+        // 压缩率略低于 hlsLz4Core（见 lzMultiByteCompress、lzMultiByteBooster），不支持 LAZY_STEPS
+        template <int PARALLEL_BYTES, int NUM_BLOCK = 8,
+            int M_LEN = 6, int MIN_MAT = 4, int LZ_MAX_OFFSET_LIM = 65536,
+            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096>
+        void hlsLz4MultiByteCore(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+            hls::stream<ap_uint<8> >& outStream,
+            hls::stream<bool>& outStreamEos,
+            hls::stream<uint32_t>& compressedSize,
+            uint32_t max_lit_limit[NUM_BLOCK],
+            uint32_t input_size,
+            uint32_t core_idx) {
+#pragma HLS INLINE off
+            hls::stream<ap_uint<PARALLEL_BYTES * 32> > compressdStream("compressdStream");
+            hls::stream<ap_uint<PARALLEL_BYTES * 32> > bestMatchStream("bestMatchStream");
+            hls::stream<IntVectorStream_dt<32, PARALLEL_BYTES> > boosterStream("boosterStream");
+            hls::stream<ap_uint<32> > tokenStream("tokenStream");
+#pragma HLS STREAM variable = compressdStream depth = 32
+#pragma HLS STREAM variable = bestMatchStream depth = 32
+#pragma HLS STREAM variable = boosterStream  depth = 64
+#pragma HLS STREAM variable = tokenStream    depth = 32
+#pragma HLS BIND_STORAGE variable = compressdStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = bestMatchStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = boosterStream  type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = tokenStream    type = FIFO impl = SRL
+
+#pragma HLS DATAFLOW
+            xf::compression::lzMultiByteCompress<PARALLEL_BYTES, M_LEN, MIN_MAT, LZ_MAX_OFFSET_LIM>(
+                inStream, compressdStream, input_size);
+            xf::compression::lzMultiByteBestMatchFilter<PARALLEL_BYTES, M_LEN>(compressdStream, bestMatchStream,
+                input_size);
+            xf::compression::lzMultiByteBooster<PARALLEL_BYTES, MAX_M_LEN>(bestMatchStream, boosterStream, input_size);
+            xf::compression::lzTokenSerializer<PARALLEL_BYTES>(boosterStream, tokenStream, input_size);
+            xf::compression::lz4Compress<MAX_LIT_CNT, NUM_BLOCK>(
+                tokenStream, outStream, max_lit_limit, input_size, outStreamEos, compressedSize, core_idx);
+        }
+
+        // 带预置字典的 LZ4 核：每个非空块前从 dictStream 读入 dict_size 字节（最多 64KB）的字典，
+        // 与 LZ4_loadDict 相同，块内匹配可以引用字典；解压端需用同一字典（见 lz4CoreDecompressEngine）
+        template <class data_t, int DATAWIDTH = 512, int BURST_SIZE = 16, int NUM_BLOCK = 8,
+            int M_LEN = 6, int MIN_MAT = 4, int LZ_MAX_OFFSET_LIM = 65536, int OFFSET_WIN = 65536,
+            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096, int MIN_B_SIZE = 128, int LAZY_STEPS = 0>
+        void hlsLz4Core(hls::stream<data_t>& inStream,
+            hls::stream<data_t>& dictStream,
+            hls::stream<data_t>& outStream,
+            hls::stream<bool>& outStreamEos,
+            hls::stream<uint32_t>& compressedSize,
+            uint32_t max_lit_limit[NUM_BLOCK],
+            uint32_t input_size,
+            uint32_t dict_size,
+            uint32_t core_idx) {
+#pragma HLS INLINE off
+            hls::stream<ap_uint<8> > compressDictStream("compressDictStream");
+            hls::stream<ap_uint<8> > boosterDictStream("boosterDictStream");
+            hls::stream<ap_uint<32> > compressdStream("compressdStream");
+            hls::stream<ap_uint<32> > bestMatchStream("bestMatchStream");
+            hls::stream<ap_uint<32> > boosterStream("boosterStream");
+#pragma HLS STREAM variable = compressDictStream depth = 32
+#pragma HLS STREAM variable = boosterDictStream  depth = 32
+#pragma HLS STREAM variable = compressdStream depth = 32
+#pragma HLS STREAM variable = bestMatchStream depth = 32
+#pragma HLS STREAM variable = boosterStream  depth = 64
+#pragma HLS BIND_STORAGE variable = compressDictStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = boosterDictStream  type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = compressdStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = bestMatchStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = boosterStream  type = FIFO impl = SRL
+
+#pragma HLS DATAFLOW
+            xf::compression::details::lz4DictDup<data_t>(
+                dictStream, compressDictStream, boosterDictStream, dict_size, input_size);
+            xf::compression::lzCompress<M_LEN, MIN_MAT, LZ_MAX_OFFSET_LIM>(
+                inStream, compressDictStream, compressdStream, input_size, dict_size);
+            xf::compression::lzBestMatchFilter<M_LEN, OFFSET_WIN>(compressdStream, bestMatchStream, input_size);
+            xf::compression::details::lzBoosterStage<MAX_M_LEN, LAZY_STEPS>::run(
+                bestMatchStream, boosterDictStream, boosterStream, input_size, dict_size);
             xf::compression::lz4Compress<MAX_LIT_CNT, NUM_BLOCK>(
                 boosterStream, outStream, max_lit_limit, input_size, outStreamEos, compressedSize, core_idx);
         }
 
         template <class data_t, int DATAWIDTH = 512, int BURST_SIZE = 16, int NUM_BLOCK = 8,
             int M_LEN = 6, int MIN_MAT = 4, int LZ_MAX_OFFSET_LIM = 65536, int OFFSET_WIN = 65536,
-            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096, int MIN_B_SIZE = 128>
+            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096, int MIN_B_SIZE = 128, int LAZY_STEPS = 0>
         void hlsLz4(const data_t* in, data_t* out,
             const uint32_t input_idx[NUM_BLOCK],
             const uint32_t output_idx[NUM_BLOCK],
@@ -369,7 +471,8 @@ namespace xf {
 
             for (uint8_t i = 0; i < NUM_BLOCK; i++) {
 #pragma HLS UNROLL
-                hlsLz4Core<ap_uint<8>, DATAWIDTH, BURST_SIZE, NUM_BLOCK>(
+                hlsLz4Core<ap_uint<8>, DATAWIDTH, BURST_SIZE, NUM_BLOCK, M_LEN, MIN_MAT, LZ_MAX_OFFSET_LIM, OFFSET_WIN,
+                    MAX_M_LEN, MAX_LIT_CNT, MIN_B_SIZE, LAZY_STEPS>(
                     inStream[i], outStream[i], outStreamEos[i], compressedSize[i],
                     max_lit_limit, input_size[i], i);
             }
@@ -380,7 +483,7 @@ namespace xf {
 
         template <class data_t, int DATAWIDTH = 512, int BURST_SIZE = 16, int NUM_BLOCK = 8,
             int M_LEN = 6, int MIN_MAT = 4, int LZ_MAX_OFFSET_LIM = 65536, int OFFSET_WIN = 65536,
-            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096, int MIN_B_SIZE = 128>
+            int MAX_M_LEN = 255, int MAX_LIT_CNT = 4096, int MIN_B_SIZE = 128, int LAZY_STEPS = 0>
         void lz4CompressMM(const data_t* in, data_t* out, uint32_t* compressd_size, const uint32_t input_size) {
 #pragma HLS INLINE off
             uint32_t block_idx = 0;
@@ -429,7 +532,8 @@ namespace xf {
                     max_lit_limit[j] = 0;
                 }
 
-                hlsLz4<data_t, DATAWIDTH, BURST_SIZE, NUM_BLOCK>(in, out, input_idx, output_idx,
+                hlsLz4<data_t, DATAWIDTH, BURST_SIZE, NUM_BLOCK, M_LEN, MIN_MAT, LZ_MAX_OFFSET_LIM, OFFSET_WIN,
+                    MAX_M_LEN, MAX_LIT_CNT, MIN_B_SIZE, LAZY_STEPS>(in, out, input_idx, output_idx,
                     input_block_size, output_block_size, max_lit_limit);
 
                 for (uint32_t k = 0; k < nblocks; k++) {
@@ -491,10 +491,26 @@ inline void lz4MultiByteDecompress(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& in
     offsetStream << 0;
 }
 
+/**
+ * @brief LZ4 block decompression core with a preset dictionary (prefix), equivalent to
+ * LZ4_decompress_safe_usingDict: matches of the block may reach back into the last
+ * dict_size bytes of the dictionary.
+ *
+ * @tparam PARALLEL_BYTES number of bytes processed per cycle
+ * @tparam HISTORY_SIZE history buffer size, at most 64K bytes
+ *
+ * @param inStream compressed block input
+ * @param dictStream dictionary input, ceil(dict_size / PARALLEL_BYTES) words
+ * @param outStream decompressed output with byte strobe
+ * @param blockSizeStream compressed block size
+ * @param dict_size dictionary size in bytes, at most HISTORY_SIZE
+ */
 template <int PARALLEL_BYTES, int HISTORY_SIZE>
 void lz4CoreDecompressEngine(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                             hls::stream<ap_uint<PARALLEL_BYTES * 8> >& dictStream,
                              hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream,
-                             hls::stream<uint32_t>& blockSizeStream) {
+                             hls::stream<uint32_t>& blockSizeStream,
+                             uint32_t dict_size) {
     typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
     typedef ap_uint<16> offset_dt;
 
@@ -527,7 +543,18 @@ void lz4CoreDecompressEngine(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream
     lz4MultiByteDecompress<PARALLEL_BYTES>(inStream, litlenStream, litStream, offsetStream, matchlenStream,
                                            blockInfoStream);
     details::lzPreProcessingUnitLL<uint32_t, PARALLEL_BYTES>(litlenStream, matchlenStream, offsetStream, lzInfoStream);
-    lzMultiByteDecompressLL<PARALLEL_BYTES, HISTORY_SIZE, 16, ap_uint<17> >(litStream, lzInfoStream, outStream);
+    lzMultiByteDecompressLL<PARALLEL_BYTES, HISTORY_SIZE, 16, ap_uint<17> >(litStream, lzInfoStream, dictStream,
+                                                                            outStream, dict_size);
+}
+
+template <int PARALLEL_BYTES, int HISTORY_SIZE>
+void lz4CoreDecompressEngine(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                             hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream,
+                             hls::stream<uint32_t>& blockSizeStream) {
+#pragma HLS INLINE
+    // Intentionally left empty: with dict_size 0 the dictionary stream is never read
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > dictStream("dictStream");
+    lz4CoreDecompressEngine<PARALLEL_BYTES, HISTORY_SIZE>(inStream, dictStream, outStream, blockSizeStream, 0);
 }
 
 /**
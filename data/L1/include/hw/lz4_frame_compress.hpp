@@ -0,0 +1,528 @@
+/*
+ * (c) Copyright 2019-2022 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef _XFCOMPRESSION_LZ4_FRAME_COMPRESS_HPP_
+#define _XFCOMPRESSION_LZ4_FRAME_COMPRESS_HPP_
+
+/**
+ * @file lz4_frame_compress.hpp
+ * @brief Header for the block-parallel LZ4 frame compressor.
+ *
+ * The input is split into independent blocks which are compressed by several
+ * LZ4 cores in parallel and written back in order as one complete LZ4 frame:
+ * frame header, block size words, stored blocks for incompressible data,
+ * optional block checksums, end mark and xxHash32 content checksum, optionally
+ * followed by a seek table.
+ *
+ * This file is part of Vitis Data Compression Library.
+ */
+
+#include "hls_stream.h"
+
+#include <ap_int.h>
+#include <assert.h>
+#include <stdint.h>
+
+#include "xf_utils_hw/stream_n_to_one.hpp"
+#include "xf_utils_hw/stream_one_to_n.hpp"
+#include "block_packer.hpp"
+#include "lz4_compress.hpp"
+#include "lz4_specs.hpp"
+#include "xxhash.hpp"
+
+namespace xf {
+namespace compression {
+namespace details {
+
+/**
+ * @brief Splits the input into blocks and tags every word with the core that compresses its block.
+ * Blocks go to the cores in round-robin order, the block size is sent to the core ahead of its data.
+ */
+template <int PARALLEL_BYTES, int NUM_CORE_LOG2, int BLOCK_SIZE>
+void lz4FrameSplit(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                   hls::stream<ap_uint<PARALLEL_BYTES * 8> >& distStream,
+                   hls::stream<bool>& distStreamEos,
+                   hls::stream<ap_uint<NUM_CORE_LOG2> >& tagStream,
+                   hls::stream<bool>& tagStreamEos,
+                   hls::stream<uint32_t> blockSizeStream[1 << NUM_CORE_LOG2],
+                   hls::stream<ap_uint<32> >& checksumSeedStream,
+                   hls::stream<ap_uint<PARALLEL_BYTES * 8> >& checksumStream,
+                   hls::stream<ap_uint<32> >& checksumLenStream,
+                   hls::stream<bool>& checksumEndStream,
+                   uint32_t input_size) {
+    const uint32_t c_blockWords = BLOCK_SIZE / PARALLEL_BYTES;
+    const int c_numCores = 1 << NUM_CORE_LOG2;
+
+    uint32_t nWords = (input_size + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+    uint32_t leftBytes = input_size;
+    uint32_t blockWordIdx = 0;
+    ap_uint<NUM_CORE_LOG2> core = 0;
+
+    // the whole frame content is one xxhash32 message with seed 0
+    checksumSeedStream << 0;
+    checksumLenStream << input_size;
+    checksumEndStream << false;
+    checksumEndStream << true;
+
+split_loop:
+    for (uint32_t i = 0; i < nWords; ++i) {
+#pragma HLS PIPELINE II = 1
+        if (blockWordIdx == 0) {
+            uint32_t blockSize = (leftBytes > (uint32_t)BLOCK_SIZE) ? (uint32_t)BLOCK_SIZE : leftBytes;
+            blockSizeStream[core] << blockSize;
+            leftBytes -= blockSize;
+        }
+        ap_uint<PARALLEL_BYTES * 8> inValue = inStream.read();
+        distStream << inValue;
+        distStreamEos << false;
+        tagStream << core;
+        tagStreamEos << false;
+        checksumStream << inValue;
+
+        if (++blockWordIdx == c_blockWords) {
+            blockWordIdx = 0;
+            ++core;
+        }
+    }
+    distStreamEos << true;
+    tagStreamEos << true;
+    for (int c = 0; c < c_numCores; ++c) {
+#pragma HLS UNROLL
+        blockSizeStream[c] << 0;
+    }
+}
+
+template <int PARALLEL_BYTES>
+void lz4FrameBlockToBytes(ap_uint<PARALLEL_BYTES * 8>* rawBuf,
+                          hls::stream<ap_uint<8> >& outStream,
+                          uint32_t block_size) {
+    ap_uint<PARALLEL_BYTES * 8> inValue = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+#pragma HLS PIPELINE II = 1
+        if (i % PARALLEL_BYTES == 0) inValue = rawBuf[i / PARALLEL_BYTES];
+        outStream << inValue.range(7, 0);
+        inValue >>= 8;
+    }
+}
+
+/**
+ * @brief Collects the LZ4 block payload into the compressed buffer.
+ * An output that reached the block size, or hit the literal limit, is reported as the block size,
+ * so the caller stores the block uncompressed.
+ */
+template <int PARALLEL_BYTES>
+void lz4FrameBytesToBlock(hls::stream<ap_uint<8> >& inStream,
+                          hls::stream<bool>& inStreamEos,
+                          hls::stream<uint32_t>& inSizeStream,
+                          uint32_t max_lit_limit[1],
+                          ap_uint<PARALLEL_BYTES * 8>* compBuf,
+                          hls::stream<uint32_t>& compSizeStream,
+                          uint32_t block_size) {
+    ap_uint<PARALLEL_BYTES * 8> outValue = 0;
+    uint32_t idx = 0;
+    for (bool eos = inStreamEos.read(); !eos; eos = inStreamEos.read()) {
+#pragma HLS PIPELINE II = 1
+        outValue.range(PARALLEL_BYTES * 8 - 1, (PARALLEL_BYTES - 1) * 8) = inStream.read();
+        ++idx;
+        if (idx % PARALLEL_BYTES == 0) {
+            compBuf[idx / PARALLEL_BYTES - 1] = outValue;
+        }
+        outValue >>= 8;
+    }
+    if (idx % PARALLEL_BYTES) {
+        compBuf[idx / PARALLEL_BYTES] = outValue >> ((PARALLEL_BYTES - 1 - idx % PARALLEL_BYTES) * 8);
+    }
+    inStream.read();
+
+    uint32_t compSize = inSizeStream.read();
+    if (max_lit_limit[0] || compSize >= block_size) compSize = block_size;
+    compSizeStream << compSize;
+}
+
+template <int PARALLEL_BYTES, int BLOCK_SIZE, int LAZY_STEPS>
+void lz4FrameCompressBlock(ap_uint<PARALLEL_BYTES * 8>* rawBuf,
+                           ap_uint<PARALLEL_BYTES * 8>* compBuf,
+                           hls::stream<uint32_t>& compSizeStream,
+                           uint32_t block_size) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<8> > coreInStream("coreInStream");
+    hls::stream<ap_uint<8> > coreOutStream("coreOutStream");
+    hls::stream<bool> coreOutStreamEos("coreOutStreamEos");
+    hls::stream<uint32_t> coreSizeStream("coreSizeStream");
+#pragma HLS STREAM variable = coreInStream depth = 32
+#pragma HLS STREAM variable = coreOutStream depth = 32
+#pragma HLS STREAM variable = coreOutStreamEos depth = 32
+#pragma HLS STREAM variable = coreSizeStream depth = 2
+    uint32_t max_lit_limit[1];
+
+    lz4FrameBlockToBytes<PARALLEL_BYTES>(rawBuf, coreInStream, block_size);
+    hlsLz4Core<ap_uint<8>, PARALLEL_BYTES * 8, 16, 1, 6, 4, 65536, 65536, 255, 4096, 128, LAZY_STEPS>(
+        coreInStream, coreOutStream, coreOutStreamEos, coreSizeStream, max_lit_limit, block_size, 0);
+    lz4FrameBytesToBlock<PARALLEL_BYTES>(coreOutStream, coreOutStreamEos, coreSizeStream, max_lit_limit, compBuf,
+                                         compSizeStream, block_size);
+}
+
+/**
+ * @brief One LZ4 frame core: receives whole blocks, compresses them and emits
+ * block size word, payload (compressed or stored) and optional block checksum.
+ * The payload size is sent to the tag generator before the block data.
+ */
+template <int PARALLEL_BYTES, int BLOCK_SIZE, bool BLOCK_CHECKSUM, int LAZY_STEPS>
+void lz4FrameCore(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                  hls::stream<bool>& inStreamEos,
+                  hls::stream<uint32_t>& blockSizeStream,
+                  hls::stream<ap_uint<PARALLEL_BYTES * 8> >& outStream,
+                  hls::stream<bool>& outStreamEos,
+                  hls::stream<uint32_t>& payloadSizeStream) {
+    const uint32_t c_blockWords = BLOCK_SIZE / PARALLEL_BYTES;
+    const uint32_t c_minBlockSize = 128;
+
+    ap_uint<PARALLEL_BYTES * 8> rawBuf[c_blockWords];
+    ap_uint<PARALLEL_BYTES * 8> compBuf[c_blockWords];
+
+block_loop:
+    for (uint32_t blockSize = blockSizeStream.read(); blockSize != 0; blockSize = blockSizeStream.read()) {
+        uint32_t nWords = (blockSize + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+    recv_loop:
+        for (uint32_t i = 0; i < nWords; ++i) {
+#pragma HLS PIPELINE II = 1
+            rawBuf[i] = inStream.read();
+            inStreamEos.read();
+        }
+
+        // blocks too short for the match pipeline are always stored
+        uint32_t compSize = blockSize;
+        if (blockSize >= c_minBlockSize) {
+            hls::stream<uint32_t> compSizeStream("compSizeStream");
+#pragma HLS STREAM variable = compSizeStream depth = 2
+            lz4FrameCompressBlock<PARALLEL_BYTES, BLOCK_SIZE, LAZY_STEPS>(rawBuf, compBuf, compSizeStream, blockSize);
+            compSize = compSizeStream.read();
+        }
+        bool stored = (compSize == blockSize);
+        uint32_t payloadSize = compSize;
+        payloadSizeStream << payloadSize;
+
+        // block size word, highest bit set for a stored block
+        ap_uint<PARALLEL_BYTES * 8> sizeWord = 0;
+        sizeWord.range(31, 0) = stored ? (blockSize | 0x80000000) : compSize;
+        outStream << sizeWord;
+        outStreamEos << false;
+
+        ap_uint<32> acc[4];
+#pragma HLS ARRAY_PARTITION variable = acc complete
+        ap_uint<128> stripe = 0;
+        ap_uint<5> fill = 0;
+        xxh32Init(acc, 0);
+
+        uint32_t nPayloadWords = (payloadSize + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+        uint32_t lastBytes = payloadSize - (nPayloadWords - 1) * PARALLEL_BYTES;
+    emit_loop:
+        for (uint32_t i = 0; i < nPayloadWords; ++i) {
+#pragma HLS PIPELINE II = 1
+            ap_uint<PARALLEL_BYTES * 8> outValue = stored ? rawBuf[i] : compBuf[i];
+            outStream << outValue;
+            outStreamEos << false;
+            if (BLOCK_CHECKSUM) {
+                ap_uint<8> nbytes = (i == nPayloadWords - 1) ? lastBytes : (uint32_t)PARALLEL_BYTES;
+                xxh32Update<PARALLEL_BYTES>(acc, stripe, fill, outValue, nbytes);
+            }
+        }
+        if (BLOCK_CHECKSUM) {
+            ap_uint<PARALLEL_BYTES * 8> checksumWord = 0;
+            checksumWord.range(31, 0) = xxh32Final(acc, stripe, fill, payloadSize, 0);
+            outStream << checksumWord;
+            outStreamEos << false;
+        }
+    }
+    inStreamEos.read();
+    outStreamEos << true;
+}
+
+/**
+ * @brief Generates the core tag of every output word in block order, and forwards the payload sizes.
+ */
+template <int PARALLEL_BYTES, int NUM_CORE_LOG2, int BLOCK_SIZE, bool BLOCK_CHECKSUM>
+void lz4FrameTagGen(hls::stream<uint32_t> payloadSizeStream[1 << NUM_CORE_LOG2],
+                    hls::stream<ap_uint<NUM_CORE_LOG2> >& tagStream,
+                    hls::stream<bool>& tagStreamEos,
+                    hls::stream<uint32_t>& chunkSizeStream,
+                    uint32_t input_size) {
+    uint32_t nBlocks = (input_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    ap_uint<NUM_CORE_LOG2> core = 0;
+block_loop:
+    for (uint32_t b = 0; b < nBlocks; ++b) {
+        uint32_t payloadSize = payloadSizeStream[core].read();
+        chunkSizeStream << payloadSize;
+        uint32_t nTags = 1 + (payloadSize + PARALLEL_BYTES - 1) / PARALLEL_BYTES + (BLOCK_CHECKSUM ? 1 : 0);
+    tag_loop:
+        for (uint32_t t = 0; t < nTags; ++t) {
+#pragma HLS PIPELINE II = 1
+            tagStream << core;
+            tagStreamEos << false;
+        }
+        ++core;
+    }
+    tagStreamEos << true;
+}
+
+/**
+ * @brief Puts the frame header in front of the ordered block words and appends end mark and content checksum,
+ * followed by the seek table if SEEK_ENTRIES is not 0.
+ * Every piece is handed to blockPacker as a separate chunk with its byte size.
+ */
+template <int PARALLEL_BYTES, int BLOCK_SIZE, bool BLOCK_CHECKSUM, int SEEK_ENTRIES>
+void lz4FrameAssemble(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& blockStream,
+                      hls::stream<bool>& blockStreamEos,
+                      hls::stream<uint32_t>& chunkSizeStream,
+                      hls::stream<ap_uint<32> >& checksumStream,
+                      hls::stream<bool>& checksumEndStream,
+                      hls::stream<ap_uint<PARALLEL_BYTES * 8> >& outStream,
+                      hls::stream<uint32_t>& outSizeStream,
+                      uint32_t input_size) {
+    const int c_headerSize = 15;
+    const int c_headerWords = (c_headerSize + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+    const int c_footerWords = (8 + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+    const int c_seekEntryWords = (SEEK_ENTRY_SIZE + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+    const int c_seekFooterWords = (SEEK_FOOTER_SIZE + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+    const int c_seekTableSize = (SEEK_ENTRIES > 0) ? SEEK_ENTRIES : 1;
+    const uint8_t c_flg = 0x40 | 0x20 | (BLOCK_CHECKSUM ? 0x10 : 0) | 0x08 | 0x04;
+    const uint8_t c_bd = (BLOCK_SIZE == MAX_BSIZE_4096KB)
+                             ? BSIZE_STD_4096KB
+                             : (BLOCK_SIZE == MAX_BSIZE_1024KB)
+                                   ? BSIZE_STD_1024KB
+                                   : (BLOCK_SIZE == MAX_BSIZE_256KB) ? BSIZE_STD_256KB : BSIZE_STD_64KB;
+
+    // magic, FLG, BD, content size, header checksum
+    ap_uint<c_headerWords * PARALLEL_BYTES * 8> header = 0;
+    header.range(7, 0) = MAGIC_BYTE_1;
+    header.range(15, 8) = MAGIC_BYTE_2;
+    header.range(23, 16) = MAGIC_BYTE_3;
+    header.range(31, 24) = MAGIC_BYTE_4;
+    header.range(39, 32) = c_flg;
+    header.range(47, 40) = c_bd;
+    header.range(111, 48) = (ap_uint<64>)input_size;
+
+    ap_uint<32> acc[4];
+    xxh32Init(acc, 0);
+    ap_uint<32> hc = xxh32Final(acc, header.range(111, 32), 10, 10, 0);
+    header.range(119, 112) = hc.range(15, 8);
+
+    outSizeStream << c_headerSize;
+    for (int i = 0; i < c_headerWords; ++i) {
+#pragma HLS PIPELINE II = 1
+        outStream << header.range((i + 1) * PARALLEL_BYTES * 8 - 1, i * PARALLEL_BYTES * 8);
+    }
+
+    // compressed size of every block, for the seek table
+    uint32_t seekTable[c_seekTableSize];
+
+    uint32_t nBlocks = (input_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    assert(SEEK_ENTRIES == 0 || nBlocks <= SEEK_ENTRIES);
+block_loop:
+    for (uint32_t b = 0; b < nBlocks; ++b) {
+        uint32_t payloadSize = chunkSizeStream.read();
+        uint32_t nWords = (payloadSize + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+        if (SEEK_ENTRIES > 0) seekTable[b] = 4 + payloadSize + (BLOCK_CHECKSUM ? 4 : 0);
+        outSizeStream << 4;
+        outSizeStream << payloadSize;
+        if (BLOCK_CHECKSUM) outSizeStream << 4;
+        uint32_t nTotal = 1 + nWords + (BLOCK_CHECKSUM ? 1 : 0);
+    copy_loop:
+        for (uint32_t i = 0; i < nTotal; ++i) {
+#pragma HLS PIPELINE II = 1
+            outStream << blockStream.read();
+            blockStreamEos.read();
+        }
+    }
+    blockStreamEos.read();
+
+    // end mark and content checksum
+    ap_uint<c_footerWords * PARALLEL_BYTES * 8> footer = 0;
+    footer.range(63, 32) = checksumStream.read();
+    checksumEndStream.read();
+    checksumEndStream.read();
+    outSizeStream << 8;
+    for (int i = 0; i < c_footerWords; ++i) {
+#pragma HLS PIPELINE II = 1
+        outStream << footer.range((i + 1) * PARALLEL_BYTES * 8 - 1, i * PARALLEL_BYTES * 8);
+    }
+
+    if (SEEK_ENTRIES > 0) {
+        // skippable frame header
+        ap_uint<c_seekEntryWords * PARALLEL_BYTES * 8> seekWords = 0;
+        seekWords.range(31, 0) = SEEK_SKIPPABLE_MAGIC;
+        seekWords.range(63, 32) = nBlocks * SEEK_ENTRY_SIZE + SEEK_FOOTER_SIZE;
+        outSizeStream << 8;
+        for (int i = 0; i < c_seekEntryWords; ++i) {
+#pragma HLS PIPELINE II = 1
+            outStream << seekWords.range((i + 1) * PARALLEL_BYTES * 8 - 1, i * PARALLEL_BYTES * 8);
+        }
+
+        // compressed and decompressed size of every block
+        uint32_t leftBytes = input_size;
+    seek_loop:
+        for (uint32_t b = 0; b < nBlocks; ++b) {
+            uint32_t blockSize = (leftBytes > (uint32_t)BLOCK_SIZE) ? (uint32_t)BLOCK_SIZE : leftBytes;
+            leftBytes -= blockSize;
+            seekWords.range(31, 0) = seekTable[b];
+            seekWords.range(63, 32) = blockSize;
+            outSizeStream << SEEK_ENTRY_SIZE;
+            for (int i = 0; i < c_seekEntryWords; ++i) {
+#pragma HLS PIPELINE II = 1
+                outStream << seekWords.range((i + 1) * PARALLEL_BYTES * 8 - 1, i * PARALLEL_BYTES * 8);
+            }
+        }
+
+        // number of blocks, descriptor, seek table magic
+        ap_uint<c_seekFooterWords * PARALLEL_BYTES * 8> seekFooter = 0;
+        seekFooter.range(31, 0) = nBlocks;
+        seekFooter.range(71, 40) = SEEK_TABLE_MAGIC;
+        outSizeStream << SEEK_FOOTER_SIZE;
+        for (int i = 0; i < c_seekFooterWords; ++i) {
+#pragma HLS PIPELINE II = 1
+            outStream << seekFooter.range((i + 1) * PARALLEL_BYTES * 8 - 1, i * PARALLEL_BYTES * 8);
+        }
+    }
+    outSizeStream << 0;
+}
+
+} // namespace details
+
+/**
+ * @brief Block-parallel LZ4 frame compressor.
+ *
+ * The input is cut into BLOCK_SIZE blocks that are compressed independently by
+ * 2^NUM_CORE_LOG2 LZ4 cores, distributed and collected with the xf_utils_hw
+ * tag-select streamOneToN/streamNToOne. The output is a complete LZ4 frame with
+ * content size and xxHash32 content checksum; a block whose compressed size is not
+ * smaller than the block is stored uncompressed.
+ *
+ * Each core buffers one input block and one compressed block on chip, so BLOCK_SIZE
+ * above 64 KB is intended for devices with URAM.
+ *
+ * @tparam PARALLEL_BYTES input/output bytes per word, one of 4, 8 or 16
+ * @tparam NUM_CORE_LOG2 log2 of the number of LZ4 cores, at least 1
+ * @tparam BLOCK_SIZE maximum block size, one of 64 KB, 256 KB, 1 MB or 4 MB
+ * @tparam BLOCK_CHECKSUM append an xxHash32 checksum after every block
+ * @tparam LAZY_STEPS lazy match steps of the LZ4 cores, 0 for greedy
+ * @tparam SEEK_ENTRIES maximum number of blocks of a seekable frame, 0 for a plain frame. The block sizes are
+ * appended after the frame in a skippable frame (see lz4_specs.hpp) that lz4DecompressRange uses to decompress a
+ * byte range without decoding the preceding blocks; other LZ4 decoders skip it.
+ *
+ * @param inStream input data, byte 0 in the lowest bits
+ * @param outStream LZ4 frame, packed words
+ * @param outStreamEos end flag of outStream, one per word plus a final true
+ * @param outSizeStream total frame size in bytes
+ * @param input_size input size in bytes
+ */
+template <int PARALLEL_BYTES = 8,
+          int NUM_CORE_LOG2 = 2,
+          int BLOCK_SIZE = 64 * 1024,
+          bool BLOCK_CHECKSUM = false,
+          int LAZY_STEPS = 0,
+          int SEEK_ENTRIES = 0>
+void lz4CompressFrame(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                      hls::stream<ap_uint<PARALLEL_BYTES * 8> >& outStream,
+                      hls::stream<bool>& outStreamEos,
+                      hls::stream<uint32_t>& outSizeStream,
+                      uint32_t input_size) {
+    // the frame header can only describe these block sizes
+    static_assert(BLOCK_SIZE == MAX_BSIZE_64KB || BLOCK_SIZE == MAX_BSIZE_256KB || BLOCK_SIZE == MAX_BSIZE_1024KB ||
+                      BLOCK_SIZE == MAX_BSIZE_4096KB,
+                  "lz4CompressFrame: BLOCK_SIZE must be 64 KB, 256 KB, 1 MB or 4 MB");
+    const int c_numCores = 1 << NUM_CORE_LOG2;
+
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > distStream("distStream");
+    hls::stream<bool> distStreamEos("distStreamEos");
+    hls::stream<ap_uint<NUM_CORE_LOG2> > distTagStream("distTagStream");
+    hls::stream<bool> distTagStreamEos("distTagStreamEos");
+    hls::stream<ap_uint<32> > checksumSeedStream("checksumSeedStream");
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > checksumInStream("checksumInStream");
+    hls::stream<ap_uint<32> > checksumLenStream("checksumLenStream");
+    hls::stream<bool> checksumEndStream("checksumEndStream");
+    hls::stream<ap_uint<32> > checksumStream("checksumStream");
+    hls::stream<bool> checksumOutEndStream("checksumOutEndStream");
+
+    hls::stream<uint32_t> blockSizeStream[c_numCores];
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > coreInStream[c_numCores];
+    hls::stream<bool> coreInStreamEos[c_numCores];
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > coreOutStream[c_numCores];
+    hls::stream<bool> coreOutStreamEos[c_numCores];
+    hls::stream<uint32_t> payloadSizeStream[c_numCores];
+
+    hls::stream<ap_uint<NUM_CORE_LOG2> > collectTagStream("collectTagStream");
+    hls::stream<bool> collectTagStreamEos("collectTagStreamEos");
+    hls::stream<uint32_t> chunkSizeStream("chunkSizeStream");
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > blockStream("blockStream");
+    hls::stream<bool> blockStreamEos("blockStreamEos");
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > packInStream("packInStream");
+    hls::stream<uint32_t> packSizeStream("packSizeStream");
+
+#pragma HLS STREAM variable = distStream depth = 32
+#pragma HLS STREAM variable = distStreamEos depth = 32
+#pragma HLS STREAM variable = distTagStream depth = 32
+#pragma HLS STREAM variable = distTagStreamEos depth = 32
+#pragma HLS STREAM variable = checksumInStream depth = 32
+#pragma HLS STREAM variable = checksumSeedStream depth = 2
+#pragma HLS STREAM variable = checksumLenStream depth = 2
+#pragma HLS STREAM variable = checksumEndStream depth = 2
+#pragma HLS STREAM variable = checksumStream depth = 2
+#pragma HLS STREAM variable = checksumOutEndStream depth = 2
+#pragma HLS STREAM variable = blockSizeStream depth = 4
+#pragma HLS STREAM variable = coreInStream depth = 32
+#pragma HLS STREAM variable = coreInStreamEos depth = 32
+#pragma HLS STREAM variable = coreOutStream depth = 32
+#pragma HLS STREAM variable = coreOutStreamEos depth = 32
+#pragma HLS STREAM variable = payloadSizeStream depth = 4
+#pragma HLS STREAM variable = collectTagStream depth = 32
+#pragma HLS STREAM variable = collectTagStreamEos depth = 32
+#pragma HLS STREAM variable = chunkSizeStream depth = 8
+#pragma HLS STREAM variable = blockStream depth = 32
+#pragma HLS STREAM variable = blockStreamEos depth = 32
+#pragma HLS STREAM variable = packInStream depth = 32
+#pragma HLS STREAM variable = packSizeStream depth = 32
+
+#pragma HLS DATAFLOW
+    details::lz4FrameSplit<PARALLEL_BYTES, NUM_CORE_LOG2, BLOCK_SIZE>(
+        inStream, distStream, distStreamEos, distTagStream, distTagStreamEos, blockSizeStream, checksumSeedStream,
+        checksumInStream, checksumLenStream, checksumEndStream, input_size);
+    xxhash32<PARALLEL_BYTES>(checksumSeedStream, checksumInStream, checksumLenStream, checksumEndStream, checksumStream,
+                             checksumOutEndStream);
+    xf::common::utils_hw::streamOneToN<PARALLEL_BYTES * 8, NUM_CORE_LOG2>(
+        distStream, distStreamEos, distTagStream, distTagStreamEos, coreInStream, coreInStreamEos,
+        xf::common::utils_hw::TagSelectT());
+
+    for (int c = 0; c < c_numCores; ++c) {
+#pragma HLS UNROLL
+        details::lz4FrameCore<PARALLEL_BYTES, BLOCK_SIZE, BLOCK_CHECKSUM, LAZY_STEPS>(
+            coreInStream[c], coreInStreamEos[c], blockSizeStream[c], coreOutStream[c], coreOutStreamEos[c],
+            payloadSizeStream[c]);
+    }
+
+    details::lz4FrameTagGen<PARALLEL_BYTES, NUM_CORE_LOG2, BLOCK_SIZE, BLOCK_CHECKSUM>(
+        payloadSizeStream, collectTagStream, collectTagStreamEos, chunkSizeStream, input_size);
+    xf::common::utils_hw::streamNToOne<PARALLEL_BYTES * 8, NUM_CORE_LOG2>(
+        coreOutStream, coreOutStreamEos, collectTagStream, collectTagStreamEos, blockStream, blockStreamEos,
+        xf::common::utils_hw::TagSelectT());
+    details::lz4FrameAssemble<PARALLEL_BYTES, BLOCK_SIZE, BLOCK_CHECKSUM, SEEK_ENTRIES>(
+        blockStream, blockStreamEos, chunkSizeStream, checksumStream, checksumOutEndStream, packInStream,
+        packSizeStream, input_size);
+    blockPacker<PARALLEL_BYTES * 8>(packInStream, packSizeStream, outStream, outStreamEos, outSizeStream);
+}
+
+} // namespace compression
+} // namespace xf
+#endif // _XFCOMPRESSION_LZ4_FRAME_COMPRESS_HPP_
@@ -0,0 +1,556 @@
+/*
+ * (c) Copyright 2019-2022 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef _XFCOMPRESSION_LZ4_FRAME_DECOMPRESS_HPP_
+#define _XFCOMPRESSION_LZ4_FRAME_DECOMPRESS_HPP_
+
+/**
+ * @file lz4_frame_decompress.hpp
+ * @brief Header for the block-parallel LZ4 frame decompressor.
+ *
+ * The frame is parsed up front and its independent blocks are decompressed by
+ * several LZ4 cores in parallel; the decompressed blocks are merged back in order.
+ * Linked blocks are all decompressed by one core, which keeps the history across them.
+ * A seekable frame can also be decompressed partially, block by block, from the
+ * seek table that follows it.
+ *
+ * This file is part of Vitis Data Compression Library.
+ */
+
+#include "hls_stream.h"
+
+#include <ap_int.h>
+#include <assert.h>
+#include <stdint.h>
+
+#include "lz4_decompress.hpp"
+#include "lz4_specs.hpp"
+
+namespace xf {
+namespace compression {
+namespace details {
+
+/**
+ * @brief Takes the next nbytes (at most 4) bytes of the frame from the byte window, refilling it from the input.
+ */
+template <int PARALLEL_BYTES>
+ap_uint<32> lz4FrameGetBytes(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                             ap_uint<2 * PARALLEL_BYTES * 8>& window,
+                             uint32_t& avail,
+                             uint32_t& readWords,
+                             uint32_t totalWords,
+                             uint32_t nbytes) {
+    if (avail < nbytes && readWords < totalWords) {
+        window.range((avail + PARALLEL_BYTES) * 8 - 1, avail * 8) = inStream.read();
+        avail += PARALLEL_BYTES;
+        ++readWords;
+    }
+    ap_uint<32> value = window.range(31, 0);
+    if (nbytes < 4) value.range(31, nbytes * 8) = 0;
+    window >>= (nbytes * 8);
+    avail -= nbytes;
+    return value;
+}
+
+/**
+ * @brief Parses the frame and sends every block, with its size and stored flag, to a core in round-robin order.
+ * The block payload is realigned so that it starts at byte 0 of a word. Each core gets its blocks in groups,
+ * a group ending with a zero block size and decompressed with one history; an empty group ends the core.
+ * A group is a single block when the blocks are independent, and every block of the frame on core 0 when
+ * they are linked. The core of every group is forwarded to the merger so that it can restore the block order.
+ */
+template <int PARALLEL_BYTES, int NUM_CORE_LOG2>
+void lz4FrameParse(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                   hls::stream<ap_uint<PARALLEL_BYTES * 8> > coreInStream[1 << NUM_CORE_LOG2],
+                   hls::stream<dt_lz4BlockInfo> blockInfoStream[1 << NUM_CORE_LOG2],
+                   hls::stream<ap_uint<NUM_CORE_LOG2> >& orderStream,
+                   hls::stream<bool>& orderStreamEos,
+                   uint32_t input_size) {
+    const int c_numCores = 1 << NUM_CORE_LOG2;
+    const uint32_t totalWords = (input_size + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+
+    ap_uint<2 * PARALLEL_BYTES * 8> window = 0;
+    uint32_t avail = 0;
+    uint32_t readWords = 0;
+
+    // Magic, FLG, BD
+    ap_uint<32> magic = lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4);
+    assert(magic == ((MAGIC_BYTE_4 << 24) | (MAGIC_BYTE_3 << 16) | (MAGIC_BYTE_2 << 8) | MAGIC_BYTE_1));
+    ap_uint<8> flg = lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 1);
+    lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 1);
+    bool blockIndependent = flg[5];
+    bool blockChecksum = flg[4];
+    bool contentSize = flg[3];
+    bool contentChecksum = flg[2];
+    bool dictId = flg[0];
+
+    // Optional content size and dictionary id, header checksum
+    if (contentSize) {
+        lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4);
+        lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4);
+    }
+    if (dictId) lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4);
+    lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 1);
+
+    dt_lz4BlockInfo endInfo;
+    endInfo.compressedSize = 0;
+    endInfo.storedBlock = 0;
+
+    ap_uint<NUM_CORE_LOG2> core = 0;
+    bool firstBlock = true;
+block_loop:
+    for (ap_uint<32> sizeWord = lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4);
+         sizeWord != 0; sizeWord = lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4)) {
+        dt_lz4BlockInfo blockInfo;
+        blockInfo.compressedSize = sizeWord.range(30, 0);
+        blockInfo.storedBlock = sizeWord[31];
+        blockInfoStream[core] << blockInfo;
+        if (blockIndependent || firstBlock) {
+            orderStream << core;
+            orderStreamEos << false;
+        }
+        firstBlock = false;
+
+        uint32_t left = blockInfo.compressedSize;
+    payload_loop:
+        while (left > 0) {
+#pragma HLS PIPELINE II = 1
+            if (avail < PARALLEL_BYTES && readWords < totalWords) {
+                window.range((avail + PARALLEL_BYTES) * 8 - 1, avail * 8) = inStream.read();
+                avail += PARALLEL_BYTES;
+                ++readWords;
+            }
+            uint32_t n = (left < PARALLEL_BYTES) ? left : (uint32_t)PARALLEL_BYTES;
+            coreInStream[core] << window.range(PARALLEL_BYTES * 8 - 1, 0);
+            window >>= (n * 8);
+            avail -= n;
+            left -= n;
+        }
+        if (blockChecksum) lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4);
+        if (blockIndependent) {
+            blockInfoStream[core] << endInfo;
+            ++core;
+        }
+    }
+    if (contentChecksum) lz4FrameGetBytes<PARALLEL_BYTES>(inStream, window, avail, readWords, totalWords, 4);
+
+    // the one group of linked blocks
+    if (!blockIndependent && !firstBlock) blockInfoStream[0] << endInfo;
+    for (int c = 0; c < c_numCores; ++c) {
+#pragma HLS UNROLL
+        blockInfoStream[c] << endInfo;
+    }
+    orderStreamEos << true;
+
+// anything after the frame
+drain_loop:
+    for (; readWords < totalWords; ++readWords) {
+#pragma HLS PIPELINE II = 1
+        inStream.read();
+    }
+}
+
+/**
+ * @brief Forwards the block sizes of one group, first block included, up to and including the zero block size.
+ */
+inline void lz4FrameGroupInfo(hls::stream<dt_lz4BlockInfo>& inInfoStream,
+                              hls::stream<dt_lz4BlockInfo>& outInfoStream,
+                              dt_lz4BlockInfo blockInfo) {
+group_loop:
+    for (; blockInfo.compressedSize != 0; blockInfo = inInfoStream.read()) {
+#pragma HLS PIPELINE II = 1
+        outInfoStream << blockInfo;
+    }
+    outInfoStream << blockInfo;
+}
+
+/**
+ * @brief Decompresses one group of blocks: the lz4DecompressEngine chain without the header processing.
+ * The blocks of the group share the history, so that a match may reach into the previous blocks.
+ * The output ends with a zero word.
+ */
+template <int PARALLEL_BYTES, int HISTORY_SIZE>
+void lz4FrameDecompressBlock(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                             hls::stream<dt_lz4BlockInfo>& groupInfoStream,
+                             hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream,
+                             dt_lz4BlockInfo blockInfo) {
+    typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
+    typedef ap_uint<16> offset_dt;
+
+    hls::stream<uint32_t> litlenStream("litlenStream");
+    hls::stream<uintV_t> litStream("litStream");
+    hls::stream<offset_dt> offsetStream("offsetStream");
+    hls::stream<uint32_t> matchlenStream("matchlenStream");
+    hls::stream<dt_lz4BlockInfo> blockInfoStream("blockInfoStream");
+    hls::stream<ap_uint<27> > lzInfoStream("lzInfoStream");
+#pragma HLS STREAM variable = litlenStream depth = 16
+#pragma HLS STREAM variable = litStream depth = 256
+#pragma HLS STREAM variable = offsetStream depth = 16
+#pragma HLS STREAM variable = matchlenStream depth = 16
+#pragma HLS STREAM variable = blockInfoStream depth = 4
+#pragma HLS STREAM variable = lzInfoStream depth = 4
+
+#pragma HLS BIND_STORAGE variable = litlenStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = litStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = offsetStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = matchlenStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = blockInfoStream type = FIFO impl = SRL
+#pragma HLS BIND_STORAGE variable = lzInfoStream type = FIFO impl = SRL
+#pragma HLS dataflow
+    lz4FrameGroupInfo(groupInfoStream, blockInfoStream, blockInfo);
+    lz4MultiByteDecompress<PARALLEL_BYTES, uint32_t>(inStream, litlenStream, litStream, offsetStream, matchlenStream,
+                                                     blockInfoStream);
+    details::lzPreProcessingUnitLL<uint32_t, PARALLEL_BYTES>(litlenStream, matchlenStream, offsetStream, lzInfoStream);
+    lzMultiByteDecompressLL<PARALLEL_BYTES, HISTORY_SIZE, 16, ap_uint<17> >(litStream, lzInfoStream, outStream);
+}
+
+/**
+ * @brief One decompression core: decompresses its groups of blocks one after the other until an empty group.
+ */
+template <int PARALLEL_BYTES, int HISTORY_SIZE>
+void lz4FrameDecompressCore(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                            hls::stream<dt_lz4BlockInfo>& blockInfoStream,
+                            hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream) {
+block_loop:
+    for (dt_lz4BlockInfo blockInfo = blockInfoStream.read(); blockInfo.compressedSize != 0;
+         blockInfo = blockInfoStream.read()) {
+        lz4FrameDecompressBlock<PARALLEL_BYTES, HISTORY_SIZE>(inStream, blockInfoStream, outStream, blockInfo);
+    }
+}
+
+/**
+ * @brief Merges the decompressed blocks in frame order and repacks them into full words,
+ * so that only the last word of the output is partial, as with lz4DecompressEngine.
+ */
+template <int PARALLEL_BYTES, int NUM_CORE_LOG2>
+void lz4FrameMerge(hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> > coreOutStream[1 << NUM_CORE_LOG2],
+                   hls::stream<ap_uint<NUM_CORE_LOG2> >& orderStream,
+                   hls::stream<bool>& orderStreamEos,
+                   hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream) {
+    const int c_parallelBit = PARALLEL_BYTES * 8;
+    ap_uint<2 * c_parallelBit> window = 0;
+    uint32_t fill = 0;
+    ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> outVal;
+
+block_loop:
+    for (bool eos = orderStreamEos.read(); eos == false; eos = orderStreamEos.read()) {
+        ap_uint<NUM_CORE_LOG2> core = orderStream.read();
+    merge_loop:
+        for (bool done = false; done == false;) {
+#pragma HLS PIPELINE II = 1
+            ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> inVal = coreOutStream[core].read();
+            ap_uint<PARALLEL_BYTES> strobe = inVal.range(PARALLEL_BYTES - 1, 0);
+            if (strobe == 0) {
+                done = true;
+            } else {
+                uint32_t n = 0;
+                for (int b = 0; b < PARALLEL_BYTES; ++b) {
+#pragma HLS UNROLL
+                    n += strobe[b];
+                }
+                window.range((fill + PARALLEL_BYTES) * 8 - 1, fill * 8) =
+                    inVal.range((PARALLEL_BYTES * 8) + PARALLEL_BYTES - 1, PARALLEL_BYTES);
+                fill += n;
+                if (fill >= PARALLEL_BYTES) {
+                    outVal.range((PARALLEL_BYTES * 8) + PARALLEL_BYTES - 1, PARALLEL_BYTES) =
+                        window.range(c_parallelBit - 1, 0);
+                    outVal.range(PARALLEL_BYTES - 1, 0) = -1;
+                    outStream << outVal;
+                    window >>= c_parallelBit;
+                    fill -= PARALLEL_BYTES;
+                }
+            }
+        }
+    }
+    if (fill) {
+        outVal.range((PARALLEL_BYTES * 8) + PARALLEL_BYTES - 1, PARALLEL_BYTES) = window.range(c_parallelBit - 1, 0);
+        outVal.range(PARALLEL_BYTES - 1, 0) = (ap_uint<PARALLEL_BYTES + 1>(1) << fill) - 1;
+        outStream << outVal;
+    }
+    outStream << 0;
+}
+
+/**
+ * @brief Reads nbytes (at most 4) bytes at any byte position of the frame in memory.
+ */
+template <int PARALLEL_BYTES>
+ap_uint<32> lz4SeekGetBytes(const ap_uint<PARALLEL_BYTES * 8>* in, uint32_t pos, uint32_t nbytes) {
+    ap_uint<2 * PARALLEL_BYTES * 8> window;
+    uint32_t idx = pos / PARALLEL_BYTES;
+    window.range(PARALLEL_BYTES * 8 - 1, 0) = in[idx];
+    if ((pos % PARALLEL_BYTES) + nbytes > PARALLEL_BYTES) {
+        window.range(2 * PARALLEL_BYTES * 8 - 1, PARALLEL_BYTES * 8) = in[idx + 1];
+    }
+    ap_uint<32> value = window >> ((pos % PARALLEL_BYTES) * 8);
+    if (nbytes < 4) value.range(31, nbytes * 8) = 0;
+    return value;
+}
+
+/**
+ * @brief Finds the blocks holding the requested range in the seek table and sends them to the core,
+ * each block in a group of its own.
+ * The table is scanned once to locate the range, which is sent to the trimmer ahead of the blocks,
+ * and the block payloads are then read straight from their frame position.
+ */
+template <int PARALLEL_BYTES>
+void lz4SeekRead(const ap_uint<PARALLEL_BYTES * 8>* in,
+                 hls::stream<ap_uint<PARALLEL_BYTES * 8> >& coreInStream,
+                 hls::stream<dt_lz4BlockInfo>& blockInfoStream,
+                 hls::stream<uint32_t>& rangeStream,
+                 uint32_t frame_size,
+                 uint32_t offset,
+                 uint32_t length) {
+    // seek table footer and skippable frame header
+    uint32_t nEntries = lz4SeekGetBytes<PARALLEL_BYTES>(in, frame_size - SEEK_FOOTER_SIZE, 4);
+    assert(lz4SeekGetBytes<PARALLEL_BYTES>(in, frame_size - 4, 4) == SEEK_TABLE_MAGIC);
+    uint32_t tablePos = frame_size - SEEK_FOOTER_SIZE - nEntries * SEEK_ENTRY_SIZE;
+    assert(lz4SeekGetBytes<PARALLEL_BYTES>(in, tablePos - 8, 4) == SEEK_SKIPPABLE_MAGIC);
+
+    // frame header size
+    ap_uint<8> flg = lz4SeekGetBytes<PARALLEL_BYTES>(in, 4, 1);
+    bool blockChecksum = flg[4];
+    uint32_t blockPos = 7 + (flg[3] ? 8 : 0) + (flg[0] ? 4 : 0);
+
+    // first block and number of blocks of the range
+    uint32_t skip = 0;
+    uint32_t nBlocks = 0;
+    uint32_t firstPos = 0;
+    uint32_t blockStart = 0;
+    uint32_t end = offset + length;
+seek_loop:
+    for (uint32_t e = 0; e < nEntries; ++e) {
+#pragma HLS PIPELINE II = 2
+        uint32_t compSize = lz4SeekGetBytes<PARALLEL_BYTES>(in, tablePos + e * SEEK_ENTRY_SIZE, 4);
+        uint32_t blockSize = lz4SeekGetBytes<PARALLEL_BYTES>(in, tablePos + e * SEEK_ENTRY_SIZE + 4, 4);
+        uint32_t blockEnd = blockStart + blockSize;
+        if (blockEnd > offset && blockStart < end) {
+            if (nBlocks == 0) {
+                skip = offset - blockStart;
+                firstPos = blockPos;
+            }
+            ++nBlocks;
+        }
+        blockStart = blockEnd;
+        blockPos += compSize;
+    }
+    rangeStream << nBlocks;
+    rangeStream << skip;
+    rangeStream << length;
+
+    dt_lz4BlockInfo endInfo;
+    endInfo.compressedSize = 0;
+    endInfo.storedBlock = 0;
+block_loop:
+    for (uint32_t b = 0; b < nBlocks; ++b) {
+        ap_uint<32> sizeWord = lz4SeekGetBytes<PARALLEL_BYTES>(in, firstPos, 4);
+        dt_lz4BlockInfo blockInfo;
+        blockInfo.compressedSize = sizeWord.range(30, 0);
+        blockInfo.storedBlock = sizeWord[31];
+        blockInfoStream << blockInfo;
+        blockInfoStream << endInfo;
+
+        // payload realigned to byte 0 of a word
+        uint32_t payloadPos = firstPos + 4;
+        uint32_t idx = payloadPos / PARALLEL_BYTES;
+        uint32_t shift = payloadPos % PARALLEL_BYTES;
+        uint32_t nWords = (blockInfo.compressedSize + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+        ap_uint<2 * PARALLEL_BYTES * 8> window = 0;
+        window.range(2 * PARALLEL_BYTES * 8 - 1, PARALLEL_BYTES * 8) = in[idx];
+    payload_loop:
+        for (uint32_t i = 0; i < nWords; ++i) {
+#pragma HLS PIPELINE II = 1
+            window >>= PARALLEL_BYTES * 8;
+            if ((idx + i + 1) * PARALLEL_BYTES < frame_size) {
+                window.range(2 * PARALLEL_BYTES * 8 - 1, PARALLEL_BYTES * 8) = in[idx + i + 1];
+            }
+            coreInStream << (ap_uint<PARALLEL_BYTES * 8>)(window >> (shift * 8));
+        }
+        firstPos = payloadPos + blockInfo.compressedSize + (blockChecksum ? 4 : 0);
+    }
+    blockInfoStream << endInfo;
+}
+
+/**
+ * @brief Drops the bytes of the first block ahead of the range and everything after it,
+ * and packs the range into full words.
+ */
+template <int PARALLEL_BYTES>
+void lz4SeekTrim(hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& coreOutStream,
+                 hls::stream<uint32_t>& rangeStream,
+                 hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream) {
+    const int c_parallelBit = PARALLEL_BYTES * 8;
+    uint32_t nBlocks = rangeStream.read();
+    uint32_t skip = rangeStream.read();
+    uint32_t left = rangeStream.read();
+
+    ap_uint<2 * c_parallelBit> window = 0;
+    uint32_t fill = 0;
+    ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> outVal;
+
+block_loop:
+    for (uint32_t b = 0; b < nBlocks; ++b) {
+    trim_loop:
+        for (bool done = false; done == false;) {
+#pragma HLS PIPELINE II = 1
+            ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> inVal = coreOutStream.read();
+            ap_uint<PARALLEL_BYTES> strobe = inVal.range(PARALLEL_BYTES - 1, 0);
+            if (strobe == 0) {
+                done = true;
+            } else {
+                uint32_t n = 0;
+                for (int i = 0; i < PARALLEL_BYTES; ++i) {
+#pragma HLS UNROLL
+                    n += strobe[i];
+                }
+                uint32_t drop = (skip < n) ? skip : n;
+                skip -= drop;
+                n -= drop;
+                if (n > left) n = left;
+                left -= n;
+                ap_uint<c_parallelBit> data = inVal.range((PARALLEL_BYTES * 8) + PARALLEL_BYTES - 1, PARALLEL_BYTES);
+                window.range((fill + PARALLEL_BYTES) * 8 - 1, fill * 8) = data >> (drop * 8);
+                fill += n;
+                if (fill >= PARALLEL_BYTES) {
+                    outVal.range((PARALLEL_BYTES * 8) + PARALLEL_BYTES - 1, PARALLEL_BYTES) =
+                        window.range(c_parallelBit - 1, 0);
+                    outVal.range(PARALLEL_BYTES - 1, 0) = -1;
+                    outStream << outVal;
+                    window >>= c_parallelBit;
+                    fill -= PARALLEL_BYTES;
+                }
+            }
+        }
+    }
+    if (fill) {
+        outVal.range((PARALLEL_BYTES * 8) + PARALLEL_BYTES - 1, PARALLEL_BYTES) = window.range(c_parallelBit - 1, 0);
+        outVal.range(PARALLEL_BYTES - 1, 0) = (ap_uint<PARALLEL_BYTES + 1>(1) << fill) - 1;
+        outStream << outVal;
+    }
+    outStream << 0;
+}
+
+} // namespace details
+
+/**
+ * @brief Block-parallel LZ4 frame decompressor.
+ *
+ * The frame header and block size words are parsed up front and the blocks are
+ * dispatched round-robin to 2^NUM_CORE_LOG2 decompression cores, each a
+ * lz4MultiByteDecompress -> lzPreProcessingUnitLL -> lzMultiByteDecompressLL chain
+ * run once per block. The decompressed blocks are merged back in frame order.
+ *
+ * Independent blocks, as written by lz4CompressFrame and by the lz4 utility by default,
+ * are spread over the cores. Linked blocks (lz4 -BD), whose matches may reach into the
+ * previous blocks, are all decompressed by core 0 with one history, at the speed of a
+ * single core. Content size, dictionary id, block checksums and content checksum are
+ * skipped, not verified.
+ *
+ * The per-core input and output FIFOs hold a whole block, so that the parser and the
+ * merger never wait for a core that is still busy with an earlier block.
+ *
+ * @tparam PARALLEL_BYTES input/output bytes per word
+ * @tparam NUM_CORE_LOG2 log2 of the number of decompression cores
+ * @tparam BLOCK_SIZE maximum block size of the frame, sizes the per-core FIFOs
+ * @tparam HISTORY_SIZE history of the cores, 64 KB covers every LZ4 offset
+ *
+ * @param inStream LZ4 frame, packed words, byte 0 in the lowest bits
+ * @param outStream decompressed data, data in the upper PARALLEL_BYTES * 8 bits and the valid byte mask in the
+ * lower PARALLEL_BYTES bits, terminated by a zero word
+ * @param input_size frame size in bytes
+ */
+template <int PARALLEL_BYTES = 8, int NUM_CORE_LOG2 = 2, int BLOCK_SIZE = 64 * 1024, int HISTORY_SIZE = 64 * 1024>
+void lz4DecompressFrame(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+                        hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream,
+                        uint32_t input_size) {
+    const int c_numCores = 1 << NUM_CORE_LOG2;
+    const int c_blockDepth = BLOCK_SIZE / PARALLEL_BYTES;
+
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > coreInStream[c_numCores];
+    hls::stream<dt_lz4BlockInfo> blockInfoStream[c_numCores];
+    hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> > coreOutStream[c_numCores];
+    hls::stream<ap_uint<NUM_CORE_LOG2> > orderStream("orderStream");
+    hls::stream<bool> orderStreamEos("orderStreamEos");
+
+#pragma HLS STREAM variable = coreInStream depth = c_blockDepth
+#pragma HLS STREAM variable = coreOutStream depth = c_blockDepth
+#pragma HLS STREAM variable = blockInfoStream depth = 4
+#pragma HLS STREAM variable = orderStream depth = 32
+#pragma HLS STREAM variable = orderStreamEos depth = 32
+
+    if (BLOCK_SIZE >= 256 * 1024) {
+#pragma HLS BIND_STORAGE variable = coreInStream type = FIFO impl = URAM
+#pragma HLS BIND_STORAGE variable = coreOutStream type = FIFO impl = URAM
+    } else {
+#pragma HLS BIND_STORAGE variable = coreInStream type = FIFO impl = BRAM
+#pragma HLS BIND_STORAGE variable = coreOutStream type = FIFO impl = BRAM
+    }
+
+#pragma HLS DATAFLOW
+    details::lz4FrameParse<PARALLEL_BYTES, NUM_CORE_LOG2>(inStream, coreInStream, blockInfoStream, orderStream,
+                                                          orderStreamEos, input_size);
+
+    for (int c = 0; c < c_numCores; ++c) {
+#pragma HLS UNROLL
+        details::lz4FrameDecompressCore<PARALLEL_BYTES, HISTORY_SIZE>(coreInStream[c], blockInfoStream[c],
+                                                                      coreOutStream[c]);
+    }
+
+    details::lz4FrameMerge<PARALLEL_BYTES, NUM_CORE_LOG2>(coreOutStream, orderStream, orderStreamEos, outStream);
+}
+
+/**
+ * @brief Decompresses a byte range of a seekable LZ4 frame.
+ *
+ * The frame must end with the seek table written by lz4CompressFrame with SEEK_ENTRIES
+ * set. Only the blocks overlapping [offset, offset + length) are read from memory and
+ * decompressed, and only the requested bytes are written out, so the cost of a lookup
+ * is bounded by the block size rather than by the frame size.
+ *
+ * @tparam PARALLEL_BYTES input/output bytes per word
+ * @tparam HISTORY_SIZE history of the core, 64 KB covers every LZ4 offset
+ *
+ * @param in frame and seek table in memory, byte 0 in the lowest bits
+ * @param outStream decompressed range, data in the upper PARALLEL_BYTES * 8 bits and the valid byte mask in the
+ * lower PARALLEL_BYTES bits, terminated by a zero word
+ * @param frame_size size in bytes of the frame including the seek table
+ * @param offset first decompressed byte of the range
+ * @param length size of the range in bytes, shortened at the end of the data
+ */
+template <int PARALLEL_BYTES = 8, int HISTORY_SIZE = 64 * 1024>
+void lz4DecompressRange(const ap_uint<PARALLEL_BYTES * 8>* in,
+                        hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream,
+                        uint32_t frame_size,
+                        uint32_t offset,
+                        uint32_t length) {
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > coreInStream("coreInStream");
+    hls::stream<dt_lz4BlockInfo> blockInfoStream("blockInfoStream");
+    hls::stream<uint32_t> rangeStream("rangeStream");
+    hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> > coreOutStream("coreOutStream");
+
+#pragma HLS STREAM variable = coreInStream depth = 64
+#pragma HLS STREAM variable = blockInfoStream depth = 4
+#pragma HLS STREAM variable = rangeStream depth = 4
+#pragma HLS STREAM variable = coreOutStream depth = 64
+
+#pragma HLS DATAFLOW
+    details::lz4SeekRead<PARALLEL_BYTES>(in, coreInStream, blockInfoStream, rangeStream, frame_size, offset, length);
+    details::lz4FrameDecompressCore<PARALLEL_BYTES, HISTORY_SIZE>(coreInStream, blockInfoStream, coreOutStream);
+    details::lz4SeekTrim<PARALLEL_BYTES>(coreOutStream, rangeStream, outStream);
+}
+
+} // namespace compression
+} // namespace xf
+#endif // _XFCOMPRESSION_LZ4_FRAME_DECOMPRESS_HPP_
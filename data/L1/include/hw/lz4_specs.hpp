@@ -71,6 +71,18 @@ const auto BSIZE_NCOMP_256 = 4;
 const auto BSIZE_NCOMP_1024 = 16;
 const auto BSIZE_NCOMP_4096 = 64;
 
+/**
+ * Seek table, appended after the LZ4 frame in a skippable frame:
+ * skippable magic, frame size, then per block the compressed size
+ * (block size word, payload and block checksum) and the decompressed size,
+ * then the number of blocks, a descriptor byte (0) and the seek table magic.
+ * All fields are 4 byte little endian.
+ */
+const auto SEEK_SKIPPABLE_MAGIC = 0x184D2A5E;
+const auto SEEK_TABLE_MAGIC = 0x8F92EAB1;
+const auto SEEK_ENTRY_SIZE = 8;
+const auto SEEK_FOOTER_SIZE = 9;
+
 } // end namespace compression
 } // end namespace xf
 
@@ -6,20 +6,95 @@
 #include <ap_int.h>
 #include <stdint.h>
 
+// ƥֵ鱣״̬УC 桢host ˣʱÿ̸߳һݣ
+// ͬ߳̿ͬʱѹͬĿ飻ۺʱΪͨ static
+#ifndef __SYNTHESIS__
+#define LZ_STATIC_STATE static thread_local
+#else
+#define LZ_STATIC_STATE static
+#endif
+
 namespace xf {
     namespace compression {
 
-        // ap_uint<8>  ap_uint<32>LZ4·
+        // ϣԣhash<MIN_MATCH, LZ_DICT_SIZE>(seq) ɴǰ5ֽڣseq ֽΪֽڣ
+        // õ [0, LZ_DICT_SIZE) ڵֵ±꣬LZ_DICT_SIZE Ϊ2
+
+        // λϣĬϣԭʵһ£򵥣ֻ12λҷɢԽϲ
+        struct lzShiftXorHash {
+            template <int MIN_MATCH, int LZ_DICT_SIZE>
+            static uint32_t hash(ap_uint<40> seq) {
+#pragma HLS INLINE
+                uint32_t b0 = seq.range(7, 0);
+                uint32_t b1 = seq.range(15, 8);
+                uint32_t b2 = seq.range(23, 16);
+                uint32_t b3 = seq.range(31, 24);
+                uint32_t h = 0;
+                if (MIN_MATCH == 3)
+                    h = (b0 << 4) ^ (b1 << 3) ^ (b2 << 2) ^ (b0 << 1) ^ (b1);
+                else
+                    h = (b0 << 4) ^ (b1 << 3) ^ (b2 << 2) ^ (b3);
+                return h & (LZ_DICT_SIZE - 1);
+            }
+        };
+
+        // ˷Fibonacciϣǰ MIN_MATCH ֽڳ 2^32/ ȡλռ132λ˷
+        struct lzFibonacciHash {
+            template <int MIN_MATCH, int LZ_DICT_SIZE>
+            static uint32_t hash(ap_uint<40> seq) {
+#pragma HLS INLINE
+                const int c_bits = maxBitsUsed(LZ_DICT_SIZE) - 1;
+                ap_uint<32> x = (MIN_MATCH == 3) ? (ap_uint<32>)seq.range(23, 0) : (ap_uint<32>)seq.range(31, 0);
+                ap_uint<32> m = x * (ap_uint<32>)0x9E3779B9u;
+                return (uint32_t)(m >> (32 - c_bits));
+            }
+        };
+
+        // LZ4 οʵ֣64λƽ̨ LZ4_hash5Ĺϣǰ5ֽڳȡλ MATCH_LEN >= 5
+        struct lzLz4Hash {
+            template <int MIN_MATCH, int LZ_DICT_SIZE>
+            static uint32_t hash(ap_uint<40> seq) {
+#pragma HLS INLINE
+                const int c_bits = maxBitsUsed(LZ_DICT_SIZE) - 1;
+                ap_uint<64> x = ((ap_uint<64>)seq) << 24;
+                ap_uint<64> m = x * (ap_uint<64>)889523592379ULL;
+                return (uint32_t)(m >> (64 - c_bits));
+            }
+        };
+
+        // CRC ϣǰ MIN_MATCH ֽڵ CRC-32C ȡλֻ޳˷
+        struct lzCrcHash {
+            template <int MIN_MATCH, int LZ_DICT_SIZE>
+            static uint32_t hash(ap_uint<40> seq) {
+#pragma HLS INLINE
+                ap_uint<32> crc = 0;
+                for (int i = 0; i < MIN_MATCH * 8; ++i) {
+#pragma HLS UNROLL
+                    bool fb = crc[0] ^ seq[i];
+                    crc >>= 1;
+                    if (fb) crc ^= (ap_uint<32>)0x82F63B78u;
+                }
+                return (uint32_t)(crc & (LZ_DICT_SIZE - 1));
+            }
+        };
+
+        // ap_uint<8>  ap_uint<32>LZ4·Ԥֵ
+        // ֵ乲 LZ_DICT_SIZE 顢ÿ MATCH_LEVEL ·± HASH_POLICY 
+        // ǰȰ dict_size ֽڵûֵ䣨LZ4_loadDict 壬 64KBǰ׺ֵ䵫
+        // ƥֵݣdict_size Ϊ 0 ʱ벻ֵİ汾ͬ
         template <int MATCH_LEN,
             int MIN_MATCH,
             int LZ_MAX_OFFSET_LIMIT,
             int MATCH_LEVEL = 6,
             int MIN_OFFSET = 1,
             int LZ_DICT_SIZE = 1 << 12,
-            int LEFT_BYTES = 64>
+            int LEFT_BYTES = 64,
+            class HASH_POLICY = lzShiftXorHash>
         void lzCompress(hls::stream<ap_uint<8> >& inStream,
+            hls::stream<ap_uint<8> >& dictStream,
             hls::stream<ap_uint<32> >& outStream,
-            uint32_t input_size) {
+            uint32_t input_size,
+            uint32_t dict_size) {
 #pragma HLS INLINE off
             const uint16_t c_idxW = 24;
             const int c_eleW = (MATCH_LEN * 8 + c_idxW);
@@ -29,19 +104,23 @@ namespace xf {
             if (input_size == 0) return;
 
 #ifndef AVOID_STATIC_MODE
-            static bool epoch = 0, needFlip = true;
-            static uint32_t relBlocks = 0;
+            LZ_STATIC_STATE bool epoch = 0, needFlip = true;
+            LZ_STATIC_STATE uint32_t relBase = 0, lastSize = 0;
 #else
-            bool epoch = 0, needFlip = true; uint32_t relBlocks = 0;
+            bool epoch = 0, needFlip = true; uint32_t relBase = 0, lastSize = 0;
 #endif
 
-            static dictV_t dict[LZ_DICT_SIZE];
-            static ap_uint<MATCH_LEVEL> epv[LZ_DICT_SIZE];
+            LZ_STATIC_STATE dictV_t dict[LZ_DICT_SIZE];
+            LZ_STATIC_STATE ap_uint<MATCH_LEVEL> epv[LZ_DICT_SIZE];
 #pragma HLS BIND_STORAGE variable = dict type = ram_2p impl = bram
 #pragma HLS BIND_STORAGE variable = epv  type = ram_2p impl = bram
 
-            if (needFlip) { epoch = !epoch; needFlip = false; relBlocks = 0; }
-            else { relBlocks++; }
+            // ַһʵʳۼӣ鳤ɴ 64KB
+            if (needFlip) { epoch = !epoch; needFlip = false; relBase = 0; }
+            else { relBase += lastSize; }
+            // ֵռַǰ dict_size λã relBase + dict_size ʼ
+            uint32_t total_size = dict_size + input_size;
+            lastSize = total_size;
 
             uint8_t win[MATCH_LEN];
 #pragma HLS ARRAY_PARTITION variable = win complete
@@ -49,27 +128,30 @@ namespace xf {
             // preload
             for (uint8_t i = 1; i < MATCH_LEN; ++i) {
 #pragma HLS PIPELINE II = 1
-                win[i] = inStream.read();
+                if ((uint32_t)(i - 1) < dict_size) win[i] = dictStream.read();
+                else win[i] = inStream.read();
             }
 
         main_loop:
-            for (uint32_t i = MATCH_LEN - 1; i < input_size - LEFT_BYTES; ++i) {
+            for (uint32_t i = MATCH_LEN - 1; i < total_size - LEFT_BYTES; ++i) {
 #pragma HLS PIPELINE II = 1
 #pragma HLS DEPENDENCE variable = dict inter false
 #pragma HLS DEPENDENCE variable = epv  inter false
-                uint32_t currIdx = (i - MATCH_LEN + 1) + relBlocks * (64 * 1024);
+                uint32_t currIdx = (i - MATCH_LEN + 1) + relBase;
 
                 for (int m = 0; m < MATCH_LEN - 1; ++m) {
 #pragma HLS UNROLL
                     win[m] = win[m + 1];
                 }
-                win[MATCH_LEN - 1] = inStream.read();
+                if (i < dict_size) win[MATCH_LEN - 1] = dictStream.read();
+                else win[MATCH_LEN - 1] = inStream.read();
 
-                uint32_t h = 0;
-                if (MIN_MATCH == 3)
-                    h = (win[0] << 4) ^ (win[1] << 3) ^ (win[2] << 2) ^ (win[0] << 1) ^ (win[1]);
-                else
-                    h = (win[0] << 4) ^ (win[1] << 3) ^ (win[2] << 2) ^ (win[3]);
+                ap_uint<40> seq = 0;
+                for (int m = 0; m < 5 && m < MATCH_LEN; ++m) {
+#pragma HLS UNROLL
+                    seq.range(8 * m + 7, 8 * m) = win[m];
+                }
+                uint32_t h = HASH_POLICY::template hash<MIN_MATCH, LZ_DICT_SIZE>(seq);
 
                 dictV_t rd = dict[h];
                 ap_uint<MATCH_LEVEL> ep = epv[h];
@@ -116,7 +198,7 @@ namespace xf {
                         ((ap_uint<32>)currIdx > (ap_uint<32>)cmpIdx) &&
                         (((ap_uint<32>)currIdx - (ap_uint<32>)cmpIdx) < (ap_uint<32>)LZ_MAX_OFFSET_LIMIT) &&
                         ((((ap_uint<32>)currIdx - (ap_uint<32>)cmpIdx - 1) >= (ap_uint<32>)MIN_OFFSET)) &&
-                        ((ap_uint<32>)cmpIdx >= (ap_uint<32>)(relBlocks * (64 * 1024)));
+                        ((ap_uint<32>)cmpIdx >= (ap_uint<32>)relBase);
 
                     if (ok) {
                         if ((len == 3) && (((ap_uint<32>)currIdx - (ap_uint<32>)cmpIdx - 1) > 4096)) len = 0;
@@ -134,7 +216,7 @@ namespace xf {
                 outv.range(7, 0) = win[0];
                 outv.range(15, 8) = best_len;
                 outv.range(31, 16) = (ap_uint<16>)best_off;
-                outStream << outv;
+                if (i - MATCH_LEN + 1 >= dict_size) outStream << outv;
             }
 
             // leftover
@@ -147,7 +229,251 @@ namespace xf {
                 ap_uint<32> v = 0; v.range(7, 0) = inStream.read(); outStream << v;
             }
 
-            if ((relBlocks * (64 * 1024)) >= (1u << (c_idxW - 1))) needFlip = true;
+            if (relBase >= (1u << (c_idxW - 1))) needFlip = true;
+        }
+
+        // ap_uint<8>  ap_uint<32>LZ4·ֵ
+        template <int MATCH_LEN,
+            int MIN_MATCH,
+            int LZ_MAX_OFFSET_LIMIT,
+            int MATCH_LEVEL = 6,
+            int MIN_OFFSET = 1,
+            int LZ_DICT_SIZE = 1 << 12,
+            int LEFT_BYTES = 64,
+            class HASH_POLICY = lzShiftXorHash>
+        void lzCompress(hls::stream<ap_uint<8> >& inStream,
+            hls::stream<ap_uint<32> >& outStream,
+            uint32_t input_size) {
+#pragma HLS INLINE
+            // dict_size Ϊ 0ֵᱻȡֻΪôֵʵ֣Ϊ
+            hls::stream<ap_uint<8> > dictStream("dictStream");
+            lzCompress<MATCH_LEN, MIN_MATCH, LZ_MAX_OFFSET_LIMIT, MATCH_LEVEL, MIN_OFFSET, LZ_DICT_SIZE, LEFT_BYTES,
+                HASH_POLICY>(inStream, dictStream, outStream, input_size, 0);
+        }
+
+        // ֽƥңÿĶ PARALLEL_BYTES ֽڲͬĹϣ
+        // ֵ䰴ϣλֳ DICT_BANKS  bankÿ bank ÿһһдͬͬһ bank λǰ
+        // дֵ䣻λַͬζĺѡĲֵҲ룬
+        // ÿλö뱾йϣͬǰһλñȽһΡͻᶪҺͲ룬ѹʵ lzCompress
+        // bank ԽͻԽ٣64KB ı LZ4 ȵֽڶԼ 5%DICT_BANKS = PARALLEL_BYTES ʱԼ 15%~22%
+        //  bank ǳBRAM ½
+        // ÿֽһ lzCompress ͬʽ32λ¼˳ƴһ
+        //  lzMultiByteBestMatchFilter / lzMultiByteBooster  hlsLz4MultiByteCore
+        template <int PARALLEL_BYTES,
+            int MATCH_LEN,
+            int MIN_MATCH,
+            int LZ_MAX_OFFSET_LIMIT,
+            int MATCH_LEVEL = 6,
+            int MIN_OFFSET = 1,
+            int LZ_DICT_SIZE = 1 << 12,
+            int LEFT_BYTES = 64,
+            class HASH_POLICY = lzShiftXorHash,
+            int DICT_BANKS = 4 * PARALLEL_BYTES>
+        void lzMultiByteCompress(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& inStream,
+            hls::stream<ap_uint<PARALLEL_BYTES * 32> >& outStream,
+            uint32_t input_size) {
+#pragma HLS INLINE off
+            const uint16_t c_idxW = 24;
+            const int c_eleW = (MATCH_LEN * 8 + c_idxW);
+            const int c_lookAhead = (MATCH_LEN + PARALLEL_BYTES - 2) / PARALLEL_BYTES;
+            const int c_winSize = PARALLEL_BYTES * (c_lookAhead + 1);
+            const int c_bankSize = LZ_DICT_SIZE / DICT_BANKS;
+            typedef ap_uint<MATCH_LEVEL* c_eleW> dictV_t;
+            typedef ap_uint<c_eleW>               dict_t;
+
+            if (input_size == 0) return;
+
+#ifndef AVOID_STATIC_MODE
+            LZ_STATIC_STATE bool epoch = 0, needFlip = true;
+            LZ_STATIC_STATE uint32_t relBase = 0, lastSize = 0;
+#else
+            bool epoch = 0, needFlip = true; uint32_t relBase = 0, lastSize = 0;
+#endif
+
+            LZ_STATIC_STATE dictV_t dict[DICT_BANKS][c_bankSize];
+            LZ_STATIC_STATE ap_uint<MATCH_LEVEL> epv[DICT_BANKS][c_bankSize];
+#pragma HLS ARRAY_PARTITION variable = dict dim = 1 complete
+#pragma HLS ARRAY_PARTITION variable = epv  dim = 1 complete
+#pragma HLS BIND_STORAGE variable = dict type = ram_2p impl = bram
+#pragma HLS BIND_STORAGE variable = epv  type = ram_2p impl = bram
+
+            // ַһʵʳۼӣ鳤ɴ 64KB
+            if (needFlip) { epoch = !epoch; needFlip = false; relBase = 0; }
+            else { relBase += lastSize; }
+            lastSize = input_size;
+
+            //  lzCompress һ£ĩβ LEFT_BYTES+MATCH_LEN-1 ֻֽ
+            uint32_t numWords = (input_size - 1) / PARALLEL_BYTES + 1;
+            uint32_t matchEnd = (input_size > (uint32_t)(LEFT_BYTES + MATCH_LEN - 1))
+                ? (input_size - LEFT_BYTES - MATCH_LEN + 1) : 0;
+
+            uint8_t win[c_winSize];
+#pragma HLS ARRAY_PARTITION variable = win complete
+
+            // preload
+            for (int k = 0; k < c_lookAhead; ++k) {
+#pragma HLS PIPELINE II = 1
+                ap_uint<PARALLEL_BYTES * 8> w = 0;
+                if ((uint32_t)k < numWords) w = inStream.read();
+                for (int b = 0; b < PARALLEL_BYTES; ++b) {
+#pragma HLS UNROLL
+                    win[PARALLEL_BYTES * (k + 1) + b] = w.range(8 * b + 7, 8 * b);
+                }
+            }
+
+        main_loop:
+            for (uint32_t k = 0; k < numWords; ++k) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS DEPENDENCE variable = dict inter false
+#pragma HLS DEPENDENCE variable = epv  inter false
+                uint32_t basePos = k * PARALLEL_BYTES;
+                uint32_t baseIdx = basePos + relBase;
+
+                for (int m = 0; m < c_winSize - PARALLEL_BYTES; ++m) {
+#pragma HLS UNROLL
+                    win[m] = win[m + PARALLEL_BYTES];
+                }
+                ap_uint<PARALLEL_BYTES * 8> w = 0;
+                if (k + c_lookAhead < numWords) w = inStream.read();
+                for (int b = 0; b < PARALLEL_BYTES; ++b) {
+#pragma HLS UNROLL
+                    win[c_winSize - PARALLEL_BYTES + b] = w.range(8 * b + 7, 8 * b);
+                }
+
+                // ÿλõĹϣbank  bank ڵַͬ bank ͻʱǰλȣ
+                // share: λÿ bank ĶĺѡԼддߵַͬ
+                // near:  йϣͬǰһλãΪѡ
+                ap_uint<16> bank[PARALLEL_BYTES];
+                uint32_t addr[PARALLEL_BYTES];
+                bool grant[PARALLEL_BYTES];
+                bool share[PARALLEL_BYTES];
+                bool nearOk[PARALLEL_BYTES];
+                uint8_t near[PARALLEL_BYTES];
+#pragma HLS ARRAY_PARTITION variable = bank complete
+#pragma HLS ARRAY_PARTITION variable = addr complete
+#pragma HLS ARRAY_PARTITION variable = grant complete
+#pragma HLS ARRAY_PARTITION variable = share complete
+#pragma HLS ARRAY_PARTITION variable = nearOk complete
+#pragma HLS ARRAY_PARTITION variable = near complete
+                for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                    ap_uint<40> seq = 0;
+                    for (int m = 0; m < 5 && m < MATCH_LEN; ++m) {
+#pragma HLS UNROLL
+                        seq.range(8 * m + 7, 8 * m) = win[p + m];
+                    }
+                    uint32_t h = HASH_POLICY::template hash<MIN_MATCH, LZ_DICT_SIZE>(seq);
+                    bank[p] = h % DICT_BANKS;
+                    addr[p] = h / DICT_BANKS;
+                    bool act = (basePos + p) < matchEnd;
+                    bool g = act, sh = act, first = true, nOk = false;
+                    uint8_t n = 0;
+                    for (int q = 0; q < p; ++q) {
+#pragma HLS UNROLL
+                        if (((basePos + q) < matchEnd) && (bank[q] == bank[p])) {
+                            g = false;
+                            if (first) sh = sh && (addr[q] == addr[p]);
+                            first = false;
+                            if (addr[q] == addr[p]) { nOk = act; n = q; }
+                        }
+                    }
+                    grant[p] = g;
+                    share[p] = sh;
+                    nearOk[p] = nOk;
+                    near[p] = n;
+                }
+
+                // ÿ bank һһд
+                dictV_t rd[DICT_BANKS];
+                ap_uint<MATCH_LEVEL> ep[DICT_BANKS];
+#pragma HLS ARRAY_PARTITION variable = rd complete
+#pragma HLS ARRAY_PARTITION variable = ep complete
+                for (int b = 0; b < DICT_BANKS; ++b) {
+#pragma HLS UNROLL
+                    bool act = false;
+                    uint32_t a = 0;
+                    int sel = 0;
+                    for (int p = PARALLEL_BYTES - 1; p >= 0; --p) {
+#pragma HLS UNROLL
+                        if (grant[p] && (bank[p] == b)) { act = true; a = addr[p]; sel = p; }
+                    }
+                    rd[b] = dict[b][a];
+                    ep[b] = epv[b][a];
+                    if (act) {
+                        dictV_t wr = (rd[b] << c_eleW);
+                        for (int m = 0; m < MATCH_LEN; ++m) {
+#pragma HLS UNROLL
+                            wr.range((m + 1) * 8 - 1, m * 8) = win[sel + m];
+                        }
+                        wr.range(c_eleW - 1, MATCH_LEN * 8) = (ap_uint<c_idxW>)(baseIdx + sel);
+                        dict[b][a] = wr;
+                        epv[b][a] = (ap_uint<MATCH_LEVEL>)((ep[b] << 1) | (epoch ? 1 : 0));
+                    }
+                }
+
+                ap_uint<PARALLEL_BYTES * 32> outv = 0;
+                for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                    uint32_t currIdx = baseIdx + p;
+                    dictV_t prd = rd[bank[p]];
+                    ap_uint<MATCH_LEVEL> pep = ep[bank[p]];
+
+                    uint8_t  best_len = 0;
+                    uint32_t best_off = 0;
+
+                    // ǰ MATCH_LEVEL ѡֵ䣬һǱе near λ
+                    for (int l = 0; l <= MATCH_LEVEL; ++l) {
+#pragma HLS UNROLL
+                        bool valid = (l < MATCH_LEVEL) ? (share[p] && (((pep >> l) & 0x1) == epoch)) : nearOk[p];
+
+                        dict_t cmp = 0;
+                        if (l < MATCH_LEVEL) {
+                            cmp = prd.range((l + 1) * c_eleW - 1, l * c_eleW);
+                        }
+                        else {
+                            for (int m = 0; m < MATCH_LEN; ++m) {
+#pragma HLS UNROLL
+                                cmp.range(8 * m + 7, 8 * m) = win[near[p] + m];
+                            }
+                            cmp.range(c_eleW - 1, MATCH_LEN * 8) = (ap_uint<c_idxW>)(baseIdx + near[p]);
+                        }
+                        ap_uint<c_idxW> cmpIdx = cmp.range(c_eleW - 1, MATCH_LEN * 8);
+
+                        uint8_t len = 0;
+                        bool run = true;
+                        for (int m = 0; m < MATCH_LEN; ++m) {
+#pragma HLS UNROLL
+                            run = run && (win[p + m] == (uint8_t)cmp.range(8 * m + 7, 8 * m));
+                            if (run) len = m + 1;
+                        }
+
+                        bool ok = valid &&
+                            (len >= MIN_MATCH) &&
+                            ((ap_uint<32>)currIdx > (ap_uint<32>)cmpIdx) &&
+                            (((ap_uint<32>)currIdx - (ap_uint<32>)cmpIdx) < (ap_uint<32>)LZ_MAX_OFFSET_LIMIT) &&
+                            ((((ap_uint<32>)currIdx - (ap_uint<32>)cmpIdx - 1) >= (ap_uint<32>)MIN_OFFSET)) &&
+                            ((ap_uint<32>)cmpIdx >= (ap_uint<32>)relBase);
+
+                        if (ok) {
+                            if ((len == 3) && (((ap_uint<32>)currIdx - (ap_uint<32>)cmpIdx - 1) > 4096)) len = 0;
+                        }
+                        else {
+                            len = 0;
+                        }
+                        if (len > best_len) {
+                            best_len = len;
+                            best_off = (ap_uint<32>)currIdx - (ap_uint<32>)cmpIdx - 1;
+                        }
+                    }
+
+                    outv.range(32 * p + 7, 32 * p) = win[p];
+                    outv.range(32 * p + 15, 32 * p + 8) = best_len;
+                    outv.range(32 * p + 31, 32 * p + 16) = (ap_uint<16>)best_off;
+                }
+                outStream << outv;
+            }
+
+            if (relBase >= (1u << (c_idxW - 1))) needFlip = true;
         }
 
         // ռλLZ4·ʹã
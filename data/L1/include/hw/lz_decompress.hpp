@@ -329,14 +329,16 @@ template <int PARALLEL_BYTES,
           class SIZE_OFFSET = ap_uint<16> >
 void lzMultiByteDecompressLL(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& litStream,
                              hls::stream<ap_uint<11 + OWIDTH> >& infoStream,
-                             hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream) {
+                             hls::stream<ap_uint<PARALLEL_BYTES * 8> >& dictStream,
+                             hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream,
+                             uint32_t dict_size) {
     const uint8_t c_parallelBit = PARALLEL_BYTES * 8;
     const uint8_t c_lowOffset = 6 * PARALLEL_BYTES;
 
     const uint16_t c_ramHistSize = HISTORY_SIZE / (PARALLEL_BYTES * 2);
     const uint8_t c_regHistSize = ((c_lowOffset) / (2 * PARALLEL_BYTES)) + 1;
 
-    enum lzDecompressStates { WRITE_LITERAL, READ_MATCH, NO_OP };
+    enum lzDecompressStates { WRITE_LITERAL, READ_MATCH, REPLICATE_MATCH, NO_OP };
     enum lzDecompressStates next_state = WRITE_LITERAL; // start from Read Literal Length
 
     ap_uint<c_parallelBit> ramHistory[2][c_ramHistSize];
@@ -371,19 +373,48 @@ void lzMultiByteDecompressLL(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& litStrea
     ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> tmpVal;
 
     ap_uint<c_parallelBit> outValue = 0;
+    // last PARALLEL_BYTES bytes written, source of the matches with offset < PARALLEL_BYTES
+    ap_uint<c_parallelBit> lastBytes = 0;
     bool matchDone = false;
     ap_uint<11 + OWIDTH> infoVal = 0; // 0-15 Match Loc, 16-19 Match Len, 20-23 Lit length, 24-26 State Info
     infoVal = infoStream.read();
+    state = infoVal.range(OWIDTH + 10, OWIDTH + 9);
+    regOrRam = infoVal.range(OWIDTH + 8, OWIDTH + 8);
     lit_len = infoVal.range(OWIDTH + 7, OWIDTH + 4);
     match_len = infoVal.range(OWIDTH + 3, OWIDTH);
     match_loc = infoVal.range(OWIDTH - 1, 0);
-    if (lit_len == 0) {
+    // the first command is a match when the data starts with a reference into the dictionary
+    if (state == 1) {
+        next_state = READ_MATCH;
+    } else if (state == 2) {
+        next_state = REPLICATE_MATCH;
+    }
+    if (state == 3) {
         matchDone = true;
     }
 
-    ap_uint<OWIDTH> read_idx = match_loc / (2 * PARALLEL_BYTES);
+    ap_uint<OWIDTH> read_idx = match_loc / PARALLEL_BYTES;
     ap_uint<8> byte_loc = (match_loc % PARALLEL_BYTES);
 
+    // Preset dictionary: written to the history just before the first output byte, so that
+    // match locations, which wrap around at 2^OWIDTH, point into it for offsets reaching
+    // back past the start of the data. The dictionary words are realigned to end on a word boundary.
+    ap_uint<OWIDTH> dictWords = (dict_size + PARALLEL_BYTES - 1) / PARALLEL_BYTES;
+    ap_uint<8> dictPad = (PARALLEL_BYTES - (dict_size % PARALLEL_BYTES)) % PARALLEL_BYTES;
+    ap_uint<2 * c_parallelBit> dictWindow = 0;
+dict_loop:
+    for (ap_uint<OWIDTH> i = 0; i < dictWords; ++i) {
+#pragma HLS PIPELINE II = 1
+        dictWindow.range(2 * c_parallelBit - 1, dictPad * 8) = dictStream.read();
+        ap_uint<c_parallelBit> dictValue = dictWindow.range(c_parallelBit - 1, 0);
+        dictWindow >>= c_parallelBit;
+        ap_uint<OWIDTH> d_idx = i - dictWords;
+        ap_uint<OWIDTH> dw_idx = d_idx / 2;
+        regHistory[d_idx.range(0, 0)][dw_idx % c_regHistSize] = dictValue;
+        ramHistory[d_idx.range(0, 0)][dw_idx % c_ramHistSize] = dictValue;
+        lastBytes = dictValue;
+    }
+
     ap_uint<4> incr_output_index = 0;
 lz4_decoder:
     while (matchDone == false) {
@@ -422,6 +453,15 @@ lz4_decoder:
         localValue.range(2 * c_parallelBit - 1, c_parallelBit) = highValue;
         ap_uint<c_parallelBit> matchValue = localValue >> (byte_loc * 8);
 
+        // Overlapping match: the last match_loc (offset) bytes repeated over the whole word
+        ap_uint<8> repOffset = (next_state == REPLICATE_MATCH) ? (ap_uint<8>)match_loc : (ap_uint<8>)PARALLEL_BYTES;
+        ap_uint<c_parallelBit> replicateValue;
+        for (int i = 0; i < PARALLEL_BYTES; i++) {
+#pragma HLS UNROLL
+            ap_uint<8> src = PARALLEL_BYTES - repOffset + (i % repOffset);
+            replicateValue.range(i * 8 + 7, i * 8) = lastBytes.range(src * 8 + 7, src * 8);
+        }
+
         // Take decision on results
         if (next_state == WRITE_LITERAL) { // literal
             outValue = litStream.read();
@@ -429,6 +469,9 @@ lz4_decoder:
         } else if (next_state == READ_MATCH) { // match
             outValue = matchValue;
             incr_output_index = match_len;
+        } else if (next_state == REPLICATE_MATCH) { // match with offset < PARALLEL_BYTES
+            outValue = replicateValue;
+            incr_output_index = match_len;
         } else if (next_state == NO_OP) { // never occurs
         } else {
             assert(0);
@@ -438,6 +481,11 @@ lz4_decoder:
         output_window.range((output_index + PARALLEL_BYTES) * 8 - 1, output_index * 8) = outValue;
         output_index += incr_output_index;
 
+        ap_uint<2 * c_parallelBit> lastWindow;
+        lastWindow.range(c_parallelBit - 1, 0) = lastBytes;
+        lastWindow.range(2 * c_parallelBit - 1, c_parallelBit) = outValue;
+        lastBytes = lastWindow >> (incr_output_index * 8);
+
         outStreamValue = output_window.range(c_parallelBit - 1, 0);
         w_idx = write_idx / 2;
         if (write_idx.range(0, 0)) { // odd case
@@ -462,6 +510,8 @@ lz4_decoder:
             next_state = WRITE_LITERAL;
         } else if (state == 1) {
             next_state = READ_MATCH;
+        } else if (state == 2) {
+            next_state = REPLICATE_MATCH;
         } else {
             next_state = NO_OP;
         }
@@ -495,6 +545,21 @@ lz4_decoder:
     }
     outStream << 0;
 }
+
+template <int PARALLEL_BYTES,
+          int HISTORY_SIZE,
+          int OWIDTH = 16,
+          class SIZE_DT = uint8_t,
+          class SIZE_OFFSET = ap_uint<16> >
+void lzMultiByteDecompressLL(hls::stream<ap_uint<PARALLEL_BYTES * 8> >& litStream,
+                             hls::stream<ap_uint<11 + OWIDTH> >& infoStream,
+                             hls::stream<ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> >& outStream) {
+#pragma HLS INLINE
+    // Intentionally left empty: with dict_size 0 the dictionary stream is never read
+    hls::stream<ap_uint<PARALLEL_BYTES * 8> > dictStream("dictStream");
+    lzMultiByteDecompressLL<PARALLEL_BYTES, HISTORY_SIZE, OWIDTH, SIZE_DT, SIZE_OFFSET>(litStream, infoStream,
+                                                                                     dictStream, outStream, 0);
+}
 //______________________________________________________________________________
 template <int PARALLEL_BYTES,
           int PARALLEL_OUT_BYTES,
@@ -1,6 +1,7 @@
 #ifndef _XFCOMPRESSION_LZ_OPTIONAL_HPP_
 #define _XFCOMPRESSION_LZ_OPTIONAL_HPP_
 
+#include "compress_utils.hpp" // for IntVectorStream_dt
 #include "hls_stream.h"
 #include <ap_int.h>
 #include <stdint.h>
@@ -55,16 +56,25 @@ namespace xf {
         }
 
         // BoosterBRAM-2P + II=1
+        // Ԥֵ䣺ǰ dict_size ֽڵֵд֮ǰʷλãƥ쵽ֵ
         template <int MAX_MATCH_LEN, int BOOSTER_OFFSET_WINDOW = 16 * 1024, int LEFT_BYTES = 64>
         void lzBooster(hls::stream<compressd_dt>& inStream,
+            hls::stream<ap_uint<8> >& dictStream,
             hls::stream<compressd_dt>& outStream,
-            uint32_t input_size) {
+            uint32_t input_size,
+            uint32_t dict_size) {
 #pragma HLS INLINE off
             if (input_size == 0) return;
 
             ap_uint<8> his[BOOSTER_OFFSET_WINDOW];
 #pragma HLS BIND_STORAGE variable = his type = ram_2p impl = bram
 
+        dict_loop:
+            for (uint32_t j = 0; j < dict_size; ++j) {
+#pragma HLS PIPELINE II = 1
+                his[(j - dict_size) % BOOSTER_OFFSET_WINDOW] = dictStream.read();
+            }
+
             uint32_t match_loc = 0, match_len = 0;
             compressd_dt outv = 0, outq = 0;
             bool matchFlag = false, outFlag = false, boostFlag = false;
@@ -116,6 +126,575 @@ namespace xf {
             }
         }
 
+        // Boosterֵ
+        template <int MAX_MATCH_LEN, int BOOSTER_OFFSET_WINDOW = 16 * 1024, int LEFT_BYTES = 64>
+        void lzBooster(hls::stream<compressd_dt>& inStream,
+            hls::stream<compressd_dt>& outStream,
+            uint32_t input_size) {
+#pragma HLS INLINE
+            // dict_size Ϊ 0ֵᱻȡֻΪôֵʵ֣Ϊ
+            hls::stream<ap_uint<8> > dictStream("dictStream");
+            lzBooster<MAX_MATCH_LEN, BOOSTER_OFFSET_WINDOW, LEFT_BYTES>(inStream, dictStream, outStream, input_size, 0);
+        }
+
+        // ƥ Boosterӿ lzBooster ͬɰ kernel 滻
+        // ǰƥʱ1LAZY_STEPS=2 ʱ2λõƥ sel 죬̽ڣ
+        // ֻյ㳬ǰƥյ sel+1 ֽϣֹ sel+1 ŰѵǰΪ
+        // ƥ䣨LZ4HC ʽ lazyǰƥ䣬Ϊ II=1
+        template <int MAX_MATCH_LEN, int LAZY_STEPS = 1, int BOOSTER_OFFSET_WINDOW = 16 * 1024, int LEFT_BYTES = 64>
+        void lzLazyBooster(hls::stream<compressd_dt>& inStream,
+            hls::stream<ap_uint<8> >& dictStream,
+            hls::stream<compressd_dt>& outStream,
+            uint32_t input_size,
+            uint32_t dict_size) {
+#pragma HLS INLINE off
+            if (input_size == 0) return;
+
+            // ǰƥÿѡһʷÿһдһ
+            ap_uint<8> his[LAZY_STEPS + 1][BOOSTER_OFFSET_WINDOW];
+#pragma HLS ARRAY_PARTITION variable = his dim = 1 complete
+#pragma HLS BIND_STORAGE variable = his type = ram_2p impl = bram
+
+        dict_loop:
+            for (uint32_t j = 0; j < dict_size; ++j) {
+#pragma HLS PIPELINE II = 1
+                ap_uint<8> ch = dictStream.read();
+                for (int c = 0; c <= LAZY_STEPS; ++c) {
+#pragma HLS UNROLL
+                    his[c][(j - dict_size) % BOOSTER_OFFSET_WINDOW] = ch;
+                }
+            }
+
+            uint32_t match_loc = 0, match_len = 0;
+            compressd_dt outv = 0;
+            bool matchFlag = false;
+            ap_uint<16> skip = 0;
+            ap_uint<8> nextCh = his[0][match_loc % BOOSTER_OFFSET_WINDOW];
+
+            // ѡ k k+1 λõƥ
+            compressd_dt candRec[LAZY_STEPS];
+            uint32_t candLoc[LAZY_STEPS], candLen[LAZY_STEPS];
+            bool candFlag[LAZY_STEPS];
+            ap_uint<8> candNext[LAZY_STEPS];
+#pragma HLS ARRAY_PARTITION variable = candRec complete
+#pragma HLS ARRAY_PARTITION variable = candLoc complete
+#pragma HLS ARRAY_PARTITION variable = candLen complete
+#pragma HLS ARRAY_PARTITION variable = candFlag complete
+#pragma HLS ARRAY_PARTITION variable = candNext complete
+            for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                candRec[k] = 0; candLoc[k] = 0; candLen[k] = 0; candFlag[k] = false; candNext[k] = 0;
+            }
+
+            // ̽ڣǰƥѡ tSel Ѷ tExt ֽڣtRec ݴЩλõ¼
+            bool trial = false;
+            uint8_t tSel = 0, tExt = 0;
+            compressd_dt tRec[LAZY_STEPS];
+#pragma HLS ARRAY_PARTITION variable = tRec complete
+
+            // ̽ʱһ LAZY_STEPS+1 ݴ
+            compressd_dt pend[LAZY_STEPS + 1];
+#pragma HLS ARRAY_PARTITION variable = pend complete
+            uint8_t pendCnt = 0;
+
+        main_loop:
+            for (uint32_t i = 0; i < (input_size - LEFT_BYTES); ++i) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS DEPENDENCE variable = his inter false
+                compressd_dt inv = inStream.read();
+                ap_uint<8>  ch = inv.range(7, 0);
+                ap_uint<8>  len = inv.range(15, 8);
+                ap_uint<16> off = inv.range(31, 16);
+
+                bool boostFlag = (off < (ap_uint<16>)BOOSTER_OFFSET_WINDOW);
+                ap_uint<8> mch = nextCh;
+                for (int c = 0; c <= LAZY_STEPS; ++c) {
+#pragma HLS UNROLL
+                    his[c][i % BOOSTER_OFFSET_WINDOW] = ch;
+                }
+
+                bool candHit[LAZY_STEPS];
+#pragma HLS ARRAY_PARTITION variable = candHit complete
+                for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                    candHit[k] = candFlag[k] && (candLen[k] < (uint32_t)MAX_MATCH_LEN) && (ch == candNext[k]);
+                }
+
+                compressd_dt newOut[LAZY_STEPS + 1];
+#pragma HLS ARRAY_PARTITION variable = newOut complete
+                uint8_t newCnt = 0;
+
+                bool restart = false;
+                if (skip) {
+                    --skip;
+                }
+                else if (trial) {
+                    // ̽ڣǰƥѶᣬֻѡ tSel յܷ񳬳ǰƥյ tSel+1 ֽ
+                    if (candHit[tSel]) {
+                        for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                            if (k == tExt) tRec[k] = inv;
+                            if (candHit[k]) {
+                                ++candLen[k]; ++candLoc[k];
+                            }
+                            else {
+                                candFlag[k] = false;
+                            }
+                        }
+                        ++tExt;
+
+                        if (tExt > tSel + 1) {
+                            // 㹻ǰ㼰 tSel λøΪѡ
+                            for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                                if (k <= tSel) {
+                                    compressd_dt lit = 0;
+                                    lit.range(7, 0) = (k == 0) ? outv.range(7, 0) : candRec[k - 1].range(7, 0);
+                                    newOut[k] = lit;
+                                }
+                            }
+                            newCnt = (uint8_t)(tSel + 1);
+
+                            match_len = candLen[tSel];
+                            match_loc = candLoc[tSel];
+                            outv = candRec[tSel];
+                            outv.range(15, 8) = (ap_uint<8>)match_len;
+
+                            // ԶĺѡǰƣѹλòٵǼ
+                            for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                                int src = k + tSel + 1;
+                                if (src < LAZY_STEPS) {
+                                    candRec[k] = candRec[src];
+                                    candFlag[k] = candFlag[src];
+                                    candLen[k] = candLen[src];
+                                    candLoc[k] = candLoc[src];
+                                }
+                                else {
+                                    candFlag[k] = false;
+                                }
+                            }
+                            trial = false;
+                        }
+                    }
+                    else {
+                        // 治㣺ǰƥ
+                        newOut[0] = outv;
+                        ap_uint<8> tLen = tRec[0].range(15, 8);
+                        ap_uint<16> tOff = tRec[0].range(31, 16);
+                        if (tLen > tExt) {
+                            // ǰƥյ㴦ļ¼ƥѸǵģ̰һӸλý
+                            newCnt = 1;
+                            outv = tRec[0];
+                            if (tOff < (ap_uint<16>)BOOSTER_OFFSET_WINDOW) {
+                                matchFlag = true; skip = 0;
+                                match_len = tExt + 1;
+                                match_loc = i - (uint32_t)tOff;
+                                outv.range(15, 8) = (ap_uint<8>)match_len;
+                            }
+                            else {
+                                matchFlag = false;
+                                skip = (ap_uint<16>)(tLen - 1 - tExt);
+                            }
+                            // ѹλòѡ¼֮лʱ
+                            for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                                if (k + 1 < tExt) candRec[k] = tRec[k + 1];
+                                else if (k + 1 == tExt) candRec[k] = inv;
+                                candFlag[k] = false;
+                            }
+                        }
+                        else {
+                            // ֽ̽ƥ
+                            for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                                if (k < tExt) {
+                                    compressd_dt lit = 0;
+                                    lit.range(7, 0) = tRec[k].range(7, 0);
+                                    newOut[k + 1] = lit;
+                                }
+                            }
+                            newCnt = (uint8_t)(tExt + 1);
+                            restart = true;
+                        }
+                        trial = false;
+                    }
+                }
+                else if (matchFlag && (match_len < (uint32_t)MAX_MATCH_LEN) && (ch == mch)) {
+                    // ǰƥ죻ѡ̭ͬ k+1 λõǼΪѡ k
+                    uint32_t dist = match_len;
+                    ++match_len; ++match_loc; outv.range(15, 8) = (ap_uint<8>)match_len;
+                    for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                        if (dist == (uint32_t)(k + 1)) {
+                            candRec[k] = inv;
+                            candFlag[k] = (len != 0) && boostFlag;
+                            candLen[k] = 1;
+                            candLoc[k] = i - (uint32_t)off;
+                        }
+                        else if (candHit[k]) {
+                            ++candLen[k]; ++candLoc[k];
+                        }
+                        else {
+                            candFlag[k] = false;
+                        }
+                    }
+                }
+                else {
+                    // ǰƥĺѡ̽
+                    int sel = LAZY_STEPS;
+                    for (int k = LAZY_STEPS - 1; k >= 0; --k) {
+#pragma HLS UNROLL
+                        if (matchFlag && candHit[k]) sel = k;
+                    }
+
+                    if (sel < LAZY_STEPS) {
+                        trial = true;
+                        tSel = (uint8_t)sel;
+                        tExt = 1;
+                        tRec[0] = inv;
+                        for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                            if (candHit[k]) {
+                                ++candLen[k]; ++candLoc[k];
+                            }
+                            else {
+                                candFlag[k] = false;
+                            }
+                        }
+                    }
+                    else {
+                        if (i) { newOut[0] = outv; newCnt = 1; }
+                        restart = true;
+                    }
+                }
+
+                if (restart) {
+                    match_len = 1; match_loc = i - (uint32_t)off;
+                    outv = inv;
+                    if (len) {
+                        if (boostFlag) { matchFlag = true;  skip = 0; }
+                        else { matchFlag = false; skip = (ap_uint<16>)(len - 1); }
+                    }
+                    else {
+                        matchFlag = false;
+                    }
+                    for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                        candFlag[k] = false;
+                    }
+                }
+                nextCh = his[0][match_loc % BOOSTER_OFFSET_WINDOW];
+                for (int k = 0; k < LAZY_STEPS; ++k) {
+#pragma HLS UNROLL
+                    candNext[k] = his[k + 1][candLoc[k] % BOOSTER_OFFSET_WINDOW];
+                }
+
+                // ݴ + ÿдһ
+                compressd_dt outq[2 * LAZY_STEPS + 1];
+#pragma HLS ARRAY_PARTITION variable = outq complete
+                uint8_t outCnt = pendCnt + newCnt;
+                for (int k = 0; k < 2 * LAZY_STEPS + 1; ++k) {
+#pragma HLS UNROLL
+                    if (k < pendCnt) outq[k] = pend[k];
+                    else if (k - pendCnt <= LAZY_STEPS) outq[k] = newOut[k - pendCnt];
+                    else outq[k] = 0;
+                }
+                if (outCnt) {
+                    outStream << outq[0];
+                    for (int k = 0; k < LAZY_STEPS + 1; ++k) {
+#pragma HLS UNROLL
+                        pend[k] = outq[k + 1];
+                    }
+                    pendCnt = outCnt - 1;
+                }
+            }
+
+            for (uint8_t k = 0; k < pendCnt; ++k) outStream << pend[k];
+            outStream << outv;
+            if (trial) {
+                for (uint8_t k = 0; k < tExt; ++k) {
+                    compressd_dt lit = 0;
+                    lit.range(7, 0) = tRec[k].range(7, 0);
+                    outStream << lit;
+                }
+            }
+
+        tail:
+            for (uint32_t i = 0; i < (uint32_t)LEFT_BYTES; ++i) {
+#pragma HLS PIPELINE II = 1
+                outStream << inStream.read();
+            }
+        }
+
+        // ƥ Boosterֵ
+        template <int MAX_MATCH_LEN, int LAZY_STEPS = 1, int BOOSTER_OFFSET_WINDOW = 16 * 1024, int LEFT_BYTES = 64>
+        void lzLazyBooster(hls::stream<compressd_dt>& inStream,
+            hls::stream<compressd_dt>& outStream,
+            uint32_t input_size) {
+#pragma HLS INLINE
+            // dict_size Ϊ 0ֵᱻȡֻΪôֵʵ֣Ϊ
+            hls::stream<ap_uint<8> > dictStream("dictStream");
+            lzLazyBooster<MAX_MATCH_LEN, LAZY_STEPS, BOOSTER_OFFSET_WINDOW, LEFT_BYTES>(
+                inStream, dictStream, outStream, input_size, 0);
+        }
+
+        // ֽѡŹˣÿĴ PARALLEL_BYTES ¼ж lzBestMatchFilter ͬ
+        //  MATCH_LEN ¼ c_lookAhead 
+        template <int PARALLEL_BYTES, int MATCH_LEN>
+        void lzMultiByteBestMatchFilter(hls::stream<ap_uint<PARALLEL_BYTES * 32> >& inStream,
+            hls::stream<ap_uint<PARALLEL_BYTES * 32> >& outStream,
+            uint32_t input_size) {
+#pragma HLS INLINE off
+            const int c_lookAhead = (PARALLEL_BYTES + MATCH_LEN - 1) / PARALLEL_BYTES;
+            const int c_winSize = PARALLEL_BYTES * (c_lookAhead + 1);
+            if (input_size == 0) return;
+
+            compressd_dt win[c_winSize];
+#pragma HLS ARRAY_PARTITION variable = win complete
+
+            uint32_t numWords = (input_size - 1) / PARALLEL_BYTES + 1;
+
+        main_loop:
+            for (uint32_t k = 0; k < numWords + c_lookAhead; ++k) {
+#pragma HLS PIPELINE II = 1
+                for (int m = 0; m < c_winSize - PARALLEL_BYTES; ++m) {
+#pragma HLS UNROLL
+                    win[m] = win[m + PARALLEL_BYTES];
+                }
+                ap_uint<PARALLEL_BYTES * 32> inv = 0;
+                if (k < numWords) inv = inStream.read();
+                for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                    win[c_winSize - PARALLEL_BYTES + p] = inv.range(32 * p + 31, 32 * p);
+                }
+                if (k < (uint32_t)c_lookAhead) continue;
+
+                //  lzBestMatchFilter һ£ MATCH_LEN ¼ԭ
+                uint32_t basePos = (k - c_lookAhead) * PARALLEL_BYTES;
+                ap_uint<PARALLEL_BYTES * 32> outv;
+                for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                    compressd_dt rec = win[p];
+                    ap_uint<8> cur = rec.range(15, 8);
+                    bool better = false;
+                    for (int j = 0; j < MATCH_LEN; ++j) {
+#pragma HLS UNROLL
+                        ap_uint<8> cmp = win[p + 1 + j].range(15, 8);
+                        better |= (cmp > (ap_uint<8>)(cur + (ap_uint<8>)j));
+                    }
+                    if (better && (basePos + p + MATCH_LEN < input_size)) {
+                        rec.range(15, 8) = 0;
+                        rec.range(31, 16) = 0;
+                    }
+                    outv.range(32 * p + 31, 32 * p) = rec;
+                }
+                outStream << outv;
+            }
+        }
+
+        // ֽ BoosterÿĴ PARALLEL_BYTES ¼ lzBooster ̰Ĺƥ䣬
+        // ÿнļ¼ PARALLEL_BYTES strobe Ϊûд
+        // ʷֳֽͨ PARALLEL_BYTES  bank PARALLEL_BYTES Դֽڸڲͬͨ
+        // ԴֽڱֻһʱֱȡĴ 0 ʷĿʼʱƥ
+        // ƥ䳤Ϊ 4ֻдӱǰ PARALLEL_BYTES-4 λÿʼƥڼ죬
+        // ЩλøһݸƵʷԼ¼еľʷ max(1, PARALLEL_BYTES-3) 
+        template <int PARALLEL_BYTES, int MAX_MATCH_LEN, int BOOSTER_OFFSET_WINDOW = 16 * 1024, int LEFT_BYTES = 64>
+        void lzMultiByteBooster(hls::stream<ap_uint<PARALLEL_BYTES * 32> >& inStream,
+            hls::stream<IntVectorStream_dt<32, PARALLEL_BYTES> >& outStream,
+            uint32_t input_size) {
+#pragma HLS INLINE off
+            const int c_depth = BOOSTER_OFFSET_WINDOW / PARALLEL_BYTES;
+            const int c_freshSets = (PARALLEL_BYTES > 4) ? (PARALLEL_BYTES - 4) : 0;
+            const int c_sets = 1 + c_freshSets;
+            // Դֽ֮ǰŶʷд
+            const uint32_t c_boostLimit = BOOSTER_OFFSET_WINDOW - 2 * PARALLEL_BYTES;
+            if (input_size == 0) return;
+
+            ap_uint<8> his[c_sets][PARALLEL_BYTES][c_depth];
+#pragma HLS ARRAY_PARTITION variable = his dim = 1 complete
+#pragma HLS ARRAY_PARTITION variable = his dim = 2 complete
+#pragma HLS BIND_STORAGE variable = his type = ram_2p impl = bram
+
+            uint32_t numWords = (input_size - 1) / PARALLEL_BYTES + 1;
+            uint32_t litStart = (input_size > (uint32_t)LEFT_BYTES) ? (input_size - LEFT_BYTES) : 0;
+
+            compressd_dt outv = 0;
+            bool outFlag = false, matchFlag = false;
+            uint32_t match_len = 0, dist = 1;
+            ap_uint<16> skip = 0;
+            ap_uint<8> prev[PARALLEL_BYTES];
+#pragma HLS ARRAY_PARTITION variable = prev complete
+
+        main_loop:
+            for (uint32_t k = 0; k < numWords; ++k) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS DEPENDENCE variable = his inter false
+                uint32_t basePos = k * PARALLEL_BYTES;
+                ap_uint<PARALLEL_BYTES * 32> inv = inStream.read();
+                ap_uint<8> cur[PARALLEL_BYTES];
+#pragma HLS ARRAY_PARTITION variable = cur complete
+                for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                    cur[p] = inv.range(32 * p + 7, 32 * p);
+                }
+
+                // ÿʷӦľ룺 0 Ϊǰƥ䣬ΪֶӦλü¼еľ
+                ap_uint<8> src[c_sets][PARALLEL_BYTES];
+#pragma HLS ARRAY_PARTITION variable = src dim = 0 complete
+                for (int c = 0; c < c_sets; ++c) {
+#pragma HLS UNROLL
+                    uint32_t d = (c == 0) ? dist : ((uint32_t)inv.range(32 * (c - 1) + 31, 32 * (c - 1) + 16) + 1);
+                    uint32_t dLane = d % PARALLEL_BYTES;
+                    ap_uint<8> laneRd[PARALLEL_BYTES];
+#pragma HLS ARRAY_PARTITION variable = laneRd complete
+                    for (int l = 0; l < PARALLEL_BYTES; ++l) {
+#pragma HLS UNROLL
+                        uint32_t s = basePos + (l + dLane) % PARALLEL_BYTES - d;
+                        laneRd[l] = his[c][l][(s / PARALLEL_BYTES) % c_depth];
+                    }
+                    for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                        int rel = p - (int)d;
+                        if (rel >= 0) {
+                            src[c][p] = cur[rel];
+                        }
+                        else if (rel >= -PARALLEL_BYTES) {
+                            src[c][p] = prev[rel + PARALLEL_BYTES];
+                        }
+                        else {
+                            src[c][p] = laneRd[(p + PARALLEL_BYTES - dLane) % PARALLEL_BYTES];
+                        }
+                    }
+                }
+
+                IntVectorStream_dt<32, PARALLEL_BYTES> outVec;
+                uint8_t cnt = 0;
+                // sel: ķԴֽڣ-1 ʾƥ޷ڱ
+                int sel = 0;
+                for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                    uint32_t pos = basePos + p;
+                    compressd_dt rec = inv.range(32 * p + 31, 32 * p);
+                    ap_uint<8> len = rec.range(15, 8);
+                    ap_uint<16> off = rec.range(31, 16);
+                    ap_uint<8> mch = (sel < 0) ? src[0][p] : src[sel][p];
+                    if (pos < input_size) {
+                        if (skip) {
+                            --skip;
+                        }
+                        else if (matchFlag && (sel >= 0) && (pos < litStart) &&
+                                 (match_len < (uint32_t)MAX_MATCH_LEN) && (cur[p] == mch)) {
+                            ++match_len;
+                            outv.range(15, 8) = (ap_uint<8>)match_len;
+                        }
+                        else {
+                            if (outFlag) outVec.data[cnt++] = outv;
+                            outFlag = true;
+                            outv = rec;
+                            matchFlag = false;
+                            // ĩβ LEFT_BYTES ֽ lzBooster һԭ
+                            if (len && (pos < litStart)) {
+                                // У len ֱֽֽ֮
+                                match_len = len;
+                                skip = (ap_uint<16>)(len - 1);
+                                if ((uint32_t)off < c_boostLimit) {
+                                    matchFlag = true;
+                                    dist = (uint32_t)off + 1;
+                                    sel = (p < c_freshSets) ? (p + 1) : -1;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for (int c = 0; c < c_sets; ++c) {
+#pragma HLS UNROLL
+                    for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                        his[c][p][k % c_depth] = cur[p];
+                    }
+                }
+                for (int p = 0; p < PARALLEL_BYTES; ++p) {
+#pragma HLS UNROLL
+                    prev[p] = cur[p];
+                }
+                outVec.strobe = cnt;
+                if (cnt) outStream << outVec;
+            }
+
+            IntVectorStream_dt<32, PARALLEL_BYTES> lastVec;
+            lastVec.data[0] = outv;
+            lastVec.strobe = 1;
+            outStream << lastVec;
+        }
+
+        //  lzMultiByteBooster ļ¼ÿһ lz4Compress ʹã
+        // ¼ǵֽۼƵ input_size Ϊֹ
+        template <int PARALLEL_BYTES>
+        void lzTokenSerializer(hls::stream<IntVectorStream_dt<32, PARALLEL_BYTES> >& inStream,
+            hls::stream<compressd_dt>& outStream,
+            uint32_t input_size) {
+#pragma HLS INLINE off
+            IntVectorStream_dt<32, PARALLEL_BYTES> inVec;
+            uint8_t idx = 0, cnt = 0;
+
+        serialize:
+            for (uint32_t covered = 0; covered < input_size;) {
+#pragma HLS PIPELINE II = 1
+                if (idx == cnt) {
+                    inVec = inStream.read();
+                    cnt = inVec.strobe;
+                    idx = 0;
+                }
+                compressd_dt rec = inVec.data[idx++];
+                ap_uint<8> len = rec.range(15, 8);
+                covered += (len ? (uint32_t)len : 1);
+                outStream << rec;
+            }
+        }
+
+        namespace details {
+
+            //  LAZY_STEPS ѡ Booster0 Ϊ̰ lzBoosterΪ lzLazyBooster
+            template <int MAX_MATCH_LEN, int LAZY_STEPS>
+            struct lzBoosterStage {
+                static void run(hls::stream<compressd_dt>& inStream,
+                    hls::stream<compressd_dt>& outStream,
+                    uint32_t input_size) {
+#pragma HLS INLINE
+                    lzLazyBooster<MAX_MATCH_LEN, LAZY_STEPS>(inStream, outStream, input_size);
+                }
+                static void run(hls::stream<compressd_dt>& inStream,
+                    hls::stream<ap_uint<8> >& dictStream,
+                    hls::stream<compressd_dt>& outStream,
+                    uint32_t input_size,
+                    uint32_t dict_size) {
+#pragma HLS INLINE
+                    lzLazyBooster<MAX_MATCH_LEN, LAZY_STEPS>(inStream, dictStream, outStream, input_size, dict_size);
+                }
+            };
+
+            template <int MAX_MATCH_LEN>
+            struct lzBoosterStage<MAX_MATCH_LEN, 0> {
+                static void run(hls::stream<compressd_dt>& inStream,
+                    hls::stream<compressd_dt>& outStream,
+                    uint32_t input_size) {
+#pragma HLS INLINE
+                    lzBooster<MAX_MATCH_LEN>(inStream, outStream, input_size);
+                }
+                static void run(hls::stream<compressd_dt>& inStream,
+                    hls::stream<ap_uint<8> >& dictStream,
+                    hls::stream<compressd_dt>& outStream,
+                    uint32_t input_size,
+                    uint32_t dict_size) {
+#pragma HLS INLINE
+                    lzBooster<MAX_MATCH_LEN>(inStream, dictStream, outStream, input_size, dict_size);
+                }
+            };
+
+        } // namespace details
+
     } // namespace compression
 } // namespace xf
 #endif // _XFCOMPRESSION_LZ_OPTIONAL_HPP_
\ No newline at end of file
@@ -0,0 +1,387 @@
+/*
+ * (c) Copyright 2019-2022 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef _XFCOMPRESSION_XXHASH_HPP_
+#define _XFCOMPRESSION_XXHASH_HPP_
+
+/**
+ * @file xxhash.hpp
+ * @brief Header for the streaming xxHash32 and xxHash64 modules.
+ *
+ * The stream protocol is the same as xf::security::crc32, so the checksums can run
+ * in-line with the compression and decompression dataflow instead of as a host pass.
+ *
+ * This file is part of Vitis Data Compression Library.
+ */
+
+#include "hls_stream.h"
+
+#include <ap_int.h>
+#include <stdint.h>
+
+namespace xf {
+namespace compression {
+namespace details {
+
+const uint32_t c_xxh32Prime1 = 2654435761U;
+const uint32_t c_xxh32Prime2 = 2246822519U;
+const uint32_t c_xxh32Prime3 = 3266489917U;
+const uint32_t c_xxh32Prime4 = 668265263U;
+const uint32_t c_xxh32Prime5 = 374761393U;
+
+const uint64_t c_xxh64Prime1 = 11400714785074694791ULL;
+const uint64_t c_xxh64Prime2 = 14029467366897019727ULL;
+const uint64_t c_xxh64Prime3 = 1609587929392839161ULL;
+const uint64_t c_xxh64Prime4 = 9650029242287828579ULL;
+const uint64_t c_xxh64Prime5 = 2870177450012600261ULL;
+
+inline ap_uint<32> xxh32Rotl(ap_uint<32> x, int r) {
+#pragma HLS INLINE
+    return (x << r) | (x >> (32 - r));
+}
+
+inline ap_uint<64> xxh64Rotl(ap_uint<64> x, int r) {
+#pragma HLS INLINE
+    return (x << r) | (x >> (64 - r));
+}
+
+inline ap_uint<32> xxh32Round(ap_uint<32> acc, ap_uint<32> in) {
+#pragma HLS INLINE
+    ap_uint<32> t = in * c_xxh32Prime2;
+    acc += t;
+    acc = xxh32Rotl(acc, 13);
+    acc = acc * c_xxh32Prime1;
+    return acc;
+}
+
+inline ap_uint<64> xxh64Round(ap_uint<64> acc, ap_uint<64> in) {
+#pragma HLS INLINE
+    ap_uint<64> t = in * c_xxh64Prime2;
+    acc += t;
+    acc = xxh64Rotl(acc, 31);
+    acc = acc * c_xxh64Prime1;
+    return acc;
+}
+
+inline ap_uint<64> xxh64Merge(ap_uint<64> h, ap_uint<64> acc) {
+#pragma HLS INLINE
+    h ^= xxh64Round(0, acc);
+    ap_uint<64> t = h * c_xxh64Prime1;
+    return t + c_xxh64Prime4;
+}
+
+inline void xxh32Init(ap_uint<32> acc[4], ap_uint<32> seed) {
+#pragma HLS INLINE
+    acc[0] = seed + c_xxh32Prime1 + c_xxh32Prime2;
+    acc[1] = seed + c_xxh32Prime2;
+    acc[2] = seed;
+    acc[3] = seed - c_xxh32Prime1;
+}
+
+inline void xxh64Init(ap_uint<64> acc[4], ap_uint<64> seed) {
+#pragma HLS INLINE
+    acc[0] = seed + c_xxh64Prime1 + c_xxh64Prime2;
+    acc[1] = seed + c_xxh64Prime2;
+    acc[2] = seed;
+    acc[3] = seed - c_xxh64Prime1;
+}
+
+/**
+ * @brief Consumes one input word for xxHash32.
+ *
+ * Narrow words (W up to 16) are gathered into the 16-byte stripe, which runs the four
+ * lanes once it is full. Wide words (W a multiple of 16) run one stripe per 16 bytes.
+ * Bytes that do not complete a stripe are left in stripe/fill for xxh32Final.
+ * Only the last word of a message may carry less than W valid bytes.
+ *
+ * @tparam W number of bytes per input word, 4, 8, 16, 32 or 64
+ *
+ * @param acc lane accumulators
+ * @param stripe pending stripe bytes, byte 0 in the lowest bits
+ * @param fill number of pending bytes in stripe
+ * @param in input word, byte 0 in the lowest bits
+ * @param nbytes valid bytes in the input word
+ */
+template <int W>
+void xxh32Update(ap_uint<32> acc[4], ap_uint<128>& stripe, ap_uint<5>& fill, ap_uint<8 * W> in, ap_uint<8> nbytes) {
+#pragma HLS INLINE
+    if (W <= 16) {
+        for (int k = 0; k < 16 / W; ++k) {
+#pragma HLS UNROLL
+            if (fill == k * W) stripe.range((k + 1) * W * 8 - 1, k * W * 8) = in;
+        }
+        fill += nbytes;
+        if (fill == 16) {
+            for (int l = 0; l < 4; ++l) {
+#pragma HLS UNROLL
+                acc[l] = xxh32Round(acc[l], stripe.range(32 * l + 31, 32 * l));
+            }
+            fill = 0;
+        }
+    } else {
+        for (int k = 0; k < W / 16; ++k) {
+#pragma HLS UNROLL
+            if (nbytes >= k * 16 + 16) {
+                for (int l = 0; l < 4; ++l) {
+#pragma HLS UNROLL
+                    acc[l] = xxh32Round(acc[l], in.range(128 * k + 32 * l + 31, 128 * k + 32 * l));
+                }
+            } else if (nbytes > k * 16) {
+                stripe = in.range(128 * k + 127, 128 * k);
+                fill = nbytes - k * 16;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Consumes one input word for xxHash64, same scheme as xxh32Update with 32-byte stripes.
+ *
+ * @tparam W number of bytes per input word, 4, 8, 16, 32 or 64
+ */
+template <int W>
+void xxh64Update(ap_uint<64> acc[4], ap_uint<256>& stripe, ap_uint<6>& fill, ap_uint<8 * W> in, ap_uint<8> nbytes) {
+#pragma HLS INLINE
+    if (W <= 32) {
+        for (int k = 0; k < 32 / W; ++k) {
+#pragma HLS UNROLL
+            if (fill == k * W) stripe.range((k + 1) * W * 8 - 1, k * W * 8) = in;
+        }
+        fill += nbytes;
+        if (fill == 32) {
+            for (int l = 0; l < 4; ++l) {
+#pragma HLS UNROLL
+                acc[l] = xxh64Round(acc[l], stripe.range(64 * l + 63, 64 * l));
+            }
+            fill = 0;
+        }
+    } else {
+        for (int k = 0; k < W / 32; ++k) {
+#pragma HLS UNROLL
+            if (nbytes >= k * 32 + 32) {
+                for (int l = 0; l < 4; ++l) {
+#pragma HLS UNROLL
+                    acc[l] = xxh64Round(acc[l], in.range(256 * k + 64 * l + 63, 256 * k + 64 * l));
+                }
+            } else if (nbytes > k * 32) {
+                stripe = in.range(256 * k + 255, 256 * k);
+                fill = nbytes - k * 32;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Folds the lanes and the pending stripe bytes into the final xxHash32 value.
+ *
+ * @param acc lane accumulators
+ * @param stripe pending stripe bytes
+ * @param fill number of pending bytes, less than 16
+ * @param total total message length in bytes
+ * @param seed hash seed
+ */
+inline ap_uint<32> xxh32Final(
+    ap_uint<32> acc[4], ap_uint<128> stripe, ap_uint<5> fill, ap_uint<64> total, ap_uint<32> seed) {
+#pragma HLS INLINE
+    ap_uint<32> h;
+    if (total >= 16) {
+        h = xxh32Rotl(acc[0], 1) + xxh32Rotl(acc[1], 7) + xxh32Rotl(acc[2], 12) + xxh32Rotl(acc[3], 18);
+    } else {
+        h = seed + c_xxh32Prime5;
+    }
+    h += (ap_uint<32>)total;
+
+    for (int k = 0; k < 3; ++k) {
+#pragma HLS UNROLL
+        if (k * 4 + 4 <= fill) {
+            ap_uint<32> t = stripe.range(32 * k + 31, 32 * k) * c_xxh32Prime3;
+            h += t;
+            h = xxh32Rotl(h, 17) * c_xxh32Prime4;
+        }
+    }
+    ap_uint<5> base = fill & 0x1C;
+    ap_uint<32> rest = stripe >> (base * 8);
+    for (int k = 0; k < 3; ++k) {
+#pragma HLS UNROLL
+        if (base + k < fill) {
+            ap_uint<32> t = rest.range(8 * k + 7, 8 * k) * c_xxh32Prime5;
+            h += t;
+            h = xxh32Rotl(h, 11) * c_xxh32Prime1;
+        }
+    }
+
+    h ^= h >> 15;
+    h = h * c_xxh32Prime2;
+    h ^= h >> 13;
+    h = h * c_xxh32Prime3;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * @brief Folds the lanes and the pending stripe bytes into the final xxHash64 value.
+ *
+ * @param acc lane accumulators
+ * @param stripe pending stripe bytes
+ * @param fill number of pending bytes, less than 32
+ * @param total total message length in bytes
+ * @param seed hash seed
+ */
+inline ap_uint<64> xxh64Final(
+    ap_uint<64> acc[4], ap_uint<256> stripe, ap_uint<6> fill, ap_uint<64> total, ap_uint<64> seed) {
+#pragma HLS INLINE
+    ap_uint<64> h;
+    if (total >= 32) {
+        h = xxh64Rotl(acc[0], 1) + xxh64Rotl(acc[1], 7) + xxh64Rotl(acc[2], 12) + xxh64Rotl(acc[3], 18);
+        for (int l = 0; l < 4; ++l) {
+#pragma HLS UNROLL
+            h = xxh64Merge(h, acc[l]);
+        }
+    } else {
+        h = seed + c_xxh64Prime5;
+    }
+    h += total;
+
+    for (int k = 0; k < 3; ++k) {
+#pragma HLS UNROLL
+        if (k * 8 + 8 <= fill) {
+            h ^= xxh64Round(0, stripe.range(64 * k + 63, 64 * k));
+            ap_uint<64> t = xxh64Rotl(h, 27) * c_xxh64Prime1;
+            h = t + c_xxh64Prime4;
+        }
+    }
+    ap_uint<6> base = fill & 0x38;
+    ap_uint<64> rest = stripe >> (base * 8);
+    if (base + 4 <= fill) {
+        ap_uint<64> t = rest.range(31, 0) * c_xxh64Prime1;
+        h ^= t;
+        t = xxh64Rotl(h, 23) * c_xxh64Prime2;
+        h = t + c_xxh64Prime3;
+        rest >>= 32;
+        base += 4;
+    }
+    for (int k = 0; k < 3; ++k) {
+#pragma HLS UNROLL
+        if (base + k < fill) {
+            ap_uint<64> t = rest.range(8 * k + 7, 8 * k) * c_xxh64Prime5;
+            h ^= t;
+            h = xxh64Rotl(h, 11) * c_xxh64Prime1;
+        }
+    }
+
+    h ^= h >> 33;
+    h = h * c_xxh64Prime2;
+    h ^= h >> 29;
+    h = h * c_xxh64Prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+} // namespace details
+
+/**
+ * @brief xxhash32 computes the xxHash32 value of input messages.
+ *
+ * One input word is consumed per cycle; with W of 16 or more every cycle runs at least one full stripe.
+ *
+ * @tparam W byte number of input data, the value of W includes 4, 8, 16, 32, 64.
+ * @param seedStrm seed of each message
+ * @param inStrm input messages, byte 0 in the lowest bits
+ * @param inLenStrm lengths of input message in bytes
+ * @param endInStrm end flag of inLenStrm
+ * @param outStrm xxHash32 result to output
+ * @param endOutStrm end flag of outStrm
+ */
+template <int W>
+void xxhash32(hls::stream<ap_uint<32> >& seedStrm,
+              hls::stream<ap_uint<8 * W> >& inStrm,
+              hls::stream<ap_uint<32> >& inLenStrm,
+              hls::stream<bool>& endInStrm,
+              hls::stream<ap_uint<32> >& outStrm,
+              hls::stream<bool>& endOutStrm) {
+    bool e = endInStrm.read();
+    while (!e) {
+        ap_uint<32> len = inLenStrm.read();
+        e = endInStrm.read();
+
+        ap_uint<32> seed = seedStrm.read();
+        ap_uint<32> acc[4];
+#pragma HLS ARRAY_PARTITION variable = acc complete
+        ap_uint<128> stripe = 0;
+        ap_uint<5> fill = 0;
+        details::xxh32Init(acc, seed);
+
+        ap_uint<32> nWords = (len + W - 1) / W;
+        for (ap_uint<32> i = 0; i < nWords; i++) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = 100 min = 100
+            ap_uint<8> nbytes = (i == nWords - 1) ? (ap_uint<32>)(len - i * W) : (ap_uint<32>)W;
+            details::xxh32Update<W>(acc, stripe, fill, inStrm.read(), nbytes);
+        }
+        outStrm.write(details::xxh32Final(acc, stripe, fill, len, seed));
+        endOutStrm.write(false);
+    }
+    endOutStrm.write(true);
+}
+
+/**
+ * @brief xxhash64 computes the xxHash64 value of input messages.
+ *
+ * One input word is consumed per cycle; with W of 32 or more every cycle runs at least one full stripe.
+ *
+ * @tparam W byte number of input data, the value of W includes 4, 8, 16, 32, 64.
+ * @param seedStrm seed of each message
+ * @param inStrm input messages, byte 0 in the lowest bits
+ * @param inLenStrm lengths of input message in bytes
+ * @param endInStrm end flag of inLenStrm
+ * @param outStrm xxHash64 result to output
+ * @param endOutStrm end flag of outStrm
+ */
+template <int W>
+void xxhash64(hls::stream<ap_uint<64> >& seedStrm,
+              hls::stream<ap_uint<8 * W> >& inStrm,
+              hls::stream<ap_uint<32> >& inLenStrm,
+              hls::stream<bool>& endInStrm,
+              hls::stream<ap_uint<64> >& outStrm,
+              hls::stream<bool>& endOutStrm) {
+    bool e = endInStrm.read();
+    while (!e) {
+        ap_uint<32> len = inLenStrm.read();
+        e = endInStrm.read();
+
+        ap_uint<64> seed = seedStrm.read();
+        ap_uint<64> acc[4];
+#pragma HLS ARRAY_PARTITION variable = acc complete
+        ap_uint<256> stripe = 0;
+        ap_uint<6> fill = 0;
+        details::xxh64Init(acc, seed);
+
+        ap_uint<32> nWords = (len + W - 1) / W;
+        for (ap_uint<32> i = 0; i < nWords; i++) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = 100 min = 100
+            ap_uint<8> nbytes = (i == nWords - 1) ? (ap_uint<32>)(len - i * W) : (ap_uint<32>)W;
+            details::xxh64Update<W>(acc, stripe, fill, inStrm.read(), nbytes);
+        }
+        outStrm.write(details::xxh64Final(acc, stripe, fill, len, seed));
+        endOutStrm.write(false);
+    }
+    endOutStrm.write(true);
+}
+
+} // namespace compression
+} // namespace xf
+#endif // _XFCOMPRESSION_XXHASH_HPP_
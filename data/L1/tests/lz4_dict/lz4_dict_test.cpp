@@ -0,0 +1,237 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_compress.hpp"
+#include "lz4_decompress.hpp"
+
+#define PARALLEL_BYTES 8
+#define HISTORY_SIZE (64 * 1024)
+#define NUM_BLOCK 8
+
+typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
+typedef ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> uintS_t;
+typedef ap_uint<8> uintB_t;
+
+void lz4DictDecompressRun(hls::stream<uintV_t>& inStream,
+                          hls::stream<uintV_t>& dictStream,
+                          hls::stream<uintS_t>& outStream,
+                          hls::stream<uint32_t>& blockSizeStream,
+                          uint32_t dict_size) {
+    xf::compression::lz4CoreDecompressEngine<PARALLEL_BYTES, HISTORY_SIZE>(inStream, dictStream, outStream,
+                                                                           blockSizeStream, dict_size);
+}
+
+static bool readFile(const std::string& name, std::vector<uint8_t>& data) {
+    std::ifstream file(name.c_str(), std::ifstream::binary | std::ifstream::in);
+    if (!file.is_open()) return false;
+    data.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static uint32_t read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Reference LZ4 block decoder with the dictionary as a prefix of the output, returns false on a malformed sequence
+static bool lz4DecodeBlock(const std::vector<uint8_t>& in, const std::vector<uint8_t>& dict, std::vector<uint8_t>& out) {
+    std::vector<uint8_t> hist(dict);
+    size_t i = 0;
+    while (i < in.size()) {
+        uint8_t token = in[i++];
+        size_t litLen = token >> 4;
+        if (litLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= in.size()) return false;
+                b = in[i++];
+                litLen += b;
+            } while (b == 255);
+        }
+        if (i + litLen > in.size()) return false;
+        hist.insert(hist.end(), in.begin() + i, in.begin() + i + litLen);
+        i += litLen;
+        // The last sequence carries literals only
+        if (i == in.size()) break;
+        if (i + 2 > in.size()) return false;
+        size_t offset = in[i] | (in[i + 1] << 8);
+        i += 2;
+        size_t matchLen = token & 0xF;
+        if (matchLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= in.size()) return false;
+                b = in[i++];
+                matchLen += b;
+            } while (b == 255);
+        }
+        matchLen += 4;
+        if (offset == 0 || offset > hist.size()) return false;
+        size_t src = hist.size() - offset;
+        for (size_t k = 0; k < matchLen; k++) hist.push_back(hist[src + k]);
+    }
+    out.assign(hist.begin() + dict.size(), hist.end());
+    return true;
+}
+
+// Compresses one block with the dictionary through the LZ4 core
+static std::vector<uint8_t> compressBlock(const std::vector<uint8_t>& in, const std::vector<uint8_t>& dict) {
+    hls::stream<uintB_t> inStream("inStream");
+    hls::stream<uintB_t> dictStream("dictStream");
+    hls::stream<uintB_t> outStream("outStream");
+    hls::stream<bool> outStreamEos("outStreamEos");
+    hls::stream<uint32_t> compressedSize("compressedSize");
+    uint32_t max_lit_limit[NUM_BLOCK] = {0};
+
+    for (unsigned int i = 0; i < in.size(); i++) inStream << in[i];
+    for (unsigned int i = 0; i < dict.size(); i++) dictStream << dict[i];
+    xf::compression::hlsLz4Core<uintB_t, 512, 16, NUM_BLOCK>(inStream, dictStream, outStream, outStreamEos,
+                                                             compressedSize, max_lit_limit, in.size(), dict.size(), 0);
+
+    std::vector<uint8_t> block;
+    for (bool eos = outStreamEos.read(); !eos; eos = outStreamEos.read()) block.push_back(outStream.read());
+    outStream.read();
+    block.resize(compressedSize.read());
+    if (!inStream.empty() || !dictStream.empty()) std::cout << "Compress: unexpected data left in the streams" << std::endl;
+    return block;
+}
+
+// Decompresses one block with the dictionary through the top, returns the error count
+static int checkDecompress(const std::string& name,
+                           const std::vector<uint8_t>& block,
+                           const std::vector<uint8_t>& dict,
+                           const std::vector<uint8_t>& orig) {
+    hls::stream<uintV_t> inStream("inStream");
+    hls::stream<uintV_t> dictStream("dictStream");
+    hls::stream<uintS_t> outStream("outStream");
+    hls::stream<uint32_t> blockSizeStream("blockSizeStream");
+
+    for (size_t i = 0; i < block.size(); i += PARALLEL_BYTES) {
+        uintV_t w = 0;
+        for (int b = 0; b < PARALLEL_BYTES && i + b < block.size(); b++) w.range(8 * b + 7, 8 * b) = block[i + b];
+        inStream << w;
+    }
+    for (size_t i = 0; i < dict.size(); i += PARALLEL_BYTES) {
+        uintV_t w = 0;
+        for (int b = 0; b < PARALLEL_BYTES && i + b < dict.size(); b++) w.range(8 * b + 7, 8 * b) = dict[i + b];
+        dictStream << w;
+    }
+    blockSizeStream << (uint32_t)block.size();
+    blockSizeStream << 0;
+
+    // DECOMPRESSION CALL
+    lz4DictDecompressRun(inStream, dictStream, outStream, blockSizeStream, dict.size());
+
+    std::vector<uint8_t> dec;
+    for (uintS_t w = outStream.read(); w.range(PARALLEL_BYTES - 1, 0) != 0; w = outStream.read())
+        for (int b = 0; b < PARALLEL_BYTES; b++)
+            if (w.range(b, b)) dec.push_back(w.range(PARALLEL_BYTES + 8 * b + 7, PARALLEL_BYTES + 8 * b));
+
+    int errCnt = 0;
+    if (dec != orig) {
+        std::cout << name << ": decompressed " << dec.size() << " bytes, expected " << orig.size() << std::endl;
+        errCnt = 1;
+    }
+    if (!inStream.empty() || !dictStream.empty() || !outStream.empty() || !blockSizeStream.empty()) {
+        std::cout << name << ": unexpected data left in the streams" << std::endl;
+        errCnt = 1;
+    }
+    std::cout << name << ": " << block.size() << " -> " << dec.size() << (errCnt ? " FAILED" : " OK") << std::endl;
+    return errCnt;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <sample.txt> <frame directory>" << std::endl;
+        return 1;
+    }
+    std::string frameDir = std::string(argv[2]) + "/";
+
+    std::vector<uint8_t> sample;
+    if (!readFile(argv[1], sample) || sample.empty()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        return 1;
+    }
+
+    // The input is sample.txt with every 97th byte replaced; the dictionaries are sample.txt itself,
+    // and 64 KB of pseudo-random bytes with sample.txt at byte 16, so that its matches are 64 KB - 16 back
+    std::vector<uint8_t> in(sample);
+    for (size_t i = 0; i < in.size(); i += 97) in[i] = '#';
+    std::vector<uint8_t> dict64k;
+    uint32_t x = 12345;
+    while (dict64k.size() < HISTORY_SIZE - sample.size()) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        dict64k.push_back((x >> 16) & 0xff);
+    }
+    dict64k.insert(dict64k.begin() + 16, sample.begin(), sample.end());
+
+    struct {
+        const char* name;
+        const std::vector<uint8_t>* dict;
+    } dicts[] = {{"sample.txt", &sample}, {"64 KB", &dict64k}};
+
+    int errCnt = 0;
+
+    // Blocks written by the lz4 utility (v1.9.4) with
+    //   lz4 -D <dictionary> <input>
+    const char* frames[] = {"sample_dict.lz4", "sample_dict64k.lz4"};
+    for (int d = 0; d < 2; d++) {
+        std::vector<uint8_t> frame;
+        if (!readFile(frameDir + frames[d], frame) || frame.size() < 11) {
+            std::cout << "Cannot open " << frameDir + frames[d] << std::endl;
+            errCnt++;
+            continue;
+        }
+        // single compressed block after the header
+        uint8_t flg = frame[4];
+        size_t pos = 7 + ((flg & 0x08) ? 8 : 0) + ((flg & 0x01) ? 4 : 0);
+        uint32_t bsize = read32(&frame[pos]);
+        std::vector<uint8_t> block(frame.begin() + pos + 4, frame.begin() + pos + 4 + (bsize & 0x7FFFFFFF));
+        errCnt += checkDecompress(std::string("lz4 utility, ") + dicts[d].name + " dictionary", block, *dicts[d].dict,
+                                  in);
+    }
+
+    // Round trip through the LZ4 core with each dictionary, and without one
+    std::vector<uint8_t> plain = compressBlock(in, std::vector<uint8_t>());
+    for (int d = 0; d < 2; d++) {
+        std::string name = std::string("LZ4 core, ") + dicts[d].name + " dictionary";
+        std::vector<uint8_t> block = compressBlock(in, *dicts[d].dict);
+        std::vector<uint8_t> ref;
+        if (!lz4DecodeBlock(block, *dicts[d].dict, ref) || ref != in) {
+            std::cout << name << ": block does not decode with the reference decoder" << std::endl;
+            errCnt++;
+        }
+        if (block.size() >= plain.size()) {
+            std::cout << name << ": " << block.size() << " bytes, not smaller than " << plain.size()
+                      << " without dictionary" << std::endl;
+            errCnt++;
+        }
+        errCnt += checkDecompress(name, block, *dicts[d].dict, in);
+    }
+    errCnt += checkDecompress("LZ4 core, no dictionary", plain, std::vector<uint8_t>(), in);
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
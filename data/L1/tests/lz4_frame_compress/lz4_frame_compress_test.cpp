@@ -0,0 +1,264 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_frame_compress.hpp"
+
+#define PARALLEL_BYTES 8
+#define NUM_CORE_LOG2 2
+#define BLOCK_SIZE (64 * 1024)
+#define BLOCK_CHECKSUM true
+
+typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
+
+void lz4FrameCompressRun(hls::stream<uintV_t>& inStream,
+                         hls::stream<uintV_t>& outStream,
+                         hls::stream<bool>& outStreamEos,
+                         hls::stream<uint32_t>& outSizeStream,
+                         uint32_t input_size) {
+    xf::compression::lz4CompressFrame<PARALLEL_BYTES, NUM_CORE_LOG2, BLOCK_SIZE, BLOCK_CHECKSUM>(
+        inStream, outStream, outStreamEos, outSizeStream, input_size);
+}
+
+// Compresses through the top at BLOCK_SIZE and through the library at the other block sizes
+template <int BS>
+struct Compressor {
+    static void run(hls::stream<uintV_t>& inStream,
+                    hls::stream<uintV_t>& outStream,
+                    hls::stream<bool>& outStreamEos,
+                    hls::stream<uint32_t>& outSizeStream,
+                    uint32_t input_size) {
+        xf::compression::lz4CompressFrame<PARALLEL_BYTES, NUM_CORE_LOG2, BS, BLOCK_CHECKSUM>(
+            inStream, outStream, outStreamEos, outSizeStream, input_size);
+    }
+};
+
+template <>
+struct Compressor<BLOCK_SIZE> {
+    static void run(hls::stream<uintV_t>& inStream,
+                    hls::stream<uintV_t>& outStream,
+                    hls::stream<bool>& outStreamEos,
+                    hls::stream<uint32_t>& outSizeStream,
+                    uint32_t input_size) {
+        lz4FrameCompressRun(inStream, outStream, outStreamEos, outSizeStream, input_size);
+    }
+};
+
+// Reference XXH32
+static uint32_t rotl32(uint32_t x, int r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+static uint32_t read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t xxh32(const uint8_t* p, size_t len, uint32_t seed) {
+    const uint32_t P1 = 2654435761U, P2 = 2246822519U, P3 = 3266489917U, P4 = 668265263U, P5 = 374761393U;
+    size_t i = 0;
+    uint32_t h;
+    if (len >= 16) {
+        uint32_t v[4] = {seed + P1 + P2, seed + P2, seed, seed - P1};
+        for (; i + 16 <= len; i += 16)
+            for (int l = 0; l < 4; l++) v[l] = rotl32(v[l] + read32(p + i + 4 * l) * P2, 13) * P1;
+        h = rotl32(v[0], 1) + rotl32(v[1], 7) + rotl32(v[2], 12) + rotl32(v[3], 18);
+    } else {
+        h = seed + P5;
+    }
+    h += (uint32_t)len;
+    for (; i + 4 <= len; i += 4) h = rotl32(h + read32(p + i) * P3, 17) * P4;
+    for (; i < len; i++) h = rotl32(h + p[i] * P5, 11) * P1;
+    h ^= h >> 15;
+    h *= P2;
+    h ^= h >> 13;
+    h *= P3;
+    h ^= h >> 16;
+    return h;
+}
+
+// Reference LZ4 block decoder, returns false on a malformed sequence
+static bool lz4DecodeBlock(const uint8_t* in, size_t size, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    size_t start = out.size();
+    while (i < size) {
+        uint8_t token = in[i++];
+        size_t litLen = token >> 4;
+        if (litLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= size) return false;
+                b = in[i++];
+                litLen += b;
+            } while (b == 255);
+        }
+        if (i + litLen > size) return false;
+        out.insert(out.end(), in + i, in + i + litLen);
+        i += litLen;
+        // The last sequence carries literals only
+        if (i == size) break;
+        if (i + 2 > size) return false;
+        size_t offset = in[i] | (in[i + 1] << 8);
+        i += 2;
+        size_t matchLen = token & 0xF;
+        if (matchLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= size) return false;
+                b = in[i++];
+                matchLen += b;
+            } while (b == 255);
+        }
+        matchLen += 4;
+        // Blocks are independent, a match may not reach into the previous block
+        if (offset == 0 || offset > out.size() - start) return false;
+        size_t src = out.size() - offset;
+        for (size_t k = 0; k < matchLen; k++) out.push_back(out[src + k]);
+    }
+    return true;
+}
+
+// Checks every field of the frame and decodes it, returns an error message or an empty string
+template <int BS>
+static std::string checkFrame(const std::vector<uint8_t>& f, const std::vector<uint8_t>& orig) {
+    if (f.size() < 15 || read32(&f[0]) != 0x184D2204) return "bad magic";
+    uint8_t flg = f[4];
+    // version 01, independent blocks, content size and content checksum, block checksums as configured
+    uint8_t flgExpected = 0x40 | 0x20 | 0x08 | 0x04 | (BLOCK_CHECKSUM ? 0x10 : 0);
+    if (flg != flgExpected) return "unexpected FLG";
+    // block maximum size id 4 to 7 for 64 KB, 256 KB, 1 MB and 4 MB
+    int bsizeId = 4;
+    for (int s = 64 * 1024; s < BS; s *= 4) bsizeId++;
+    if (f[5] != (bsizeId << 4)) return "unexpected BD";
+    uint64_t contentSize = read32(&f[6]) | ((uint64_t)read32(&f[10]) << 32);
+    if (contentSize != orig.size()) return "wrong content size";
+    if (f[14] != ((xxh32(&f[4], 10, 0) >> 8) & 0xFF)) return "wrong header checksum";
+
+    std::vector<uint8_t> dec;
+    size_t i = 15;
+    int compressedBlocks = 0;
+    int storedBlocks = 0;
+    while (true) {
+        if (i + 4 > f.size()) return "truncated frame";
+        uint32_t bsize = read32(&f[i]);
+        i += 4;
+        if (bsize == 0) break;
+        bool stored = bsize & 0x80000000;
+        bsize &= 0x7FFFFFFF;
+        if (bsize > BS || i + bsize + (BLOCK_CHECKSUM ? 4 : 0) > f.size()) return "bad block size";
+        size_t before = dec.size();
+        if (stored) {
+            dec.insert(dec.end(), f.begin() + i, f.begin() + i + bsize);
+            storedBlocks++;
+        } else {
+            if (!lz4DecodeBlock(&f[i], bsize, dec)) return "malformed block";
+            compressedBlocks++;
+        }
+        if (dec.size() - before > BS) return "block larger than the block size";
+        if (BLOCK_CHECKSUM && read32(&f[i + bsize]) != xxh32(&f[i], bsize, 0)) return "wrong block checksum";
+        i += bsize + (BLOCK_CHECKSUM ? 4 : 0);
+    }
+    if (i + 4 != f.size()) return "unexpected frame end";
+    if (read32(&f[i]) != xxh32(dec.data(), dec.size(), 0)) return "wrong content checksum";
+    if (dec != orig) return "decompressed data differs";
+    std::cout << compressedBlocks << " compressed and " << storedBlocks << " stored blocks, ";
+    return "";
+}
+
+template <int BS>
+static int compressAndCheck(const std::string& name, const std::vector<uint8_t>& in) {
+    hls::stream<uintV_t> inStream("inStream");
+    hls::stream<uintV_t> outStream("outStream");
+    hls::stream<bool> outStreamEos("outStreamEos");
+    hls::stream<uint32_t> outSizeStream("outSizeStream");
+
+    uint32_t input_size = in.size();
+    for (uint32_t i = 0; i < input_size; i += PARALLEL_BYTES) {
+        uintV_t w = 0;
+        for (int b = 0; b < PARALLEL_BYTES && i + b < input_size; b++) w.range(8 * b + 7, 8 * b) = in[i + b];
+        inStream << w;
+    }
+
+    // COMPRESSION CALL
+    Compressor<BS>::run(inStream, outStream, outStreamEos, outSizeStream, input_size);
+
+    std::vector<uint8_t> frame;
+    for (bool eos = outStreamEos.read(); !eos; eos = outStreamEos.read()) {
+        uintV_t w = outStream.read();
+        for (int b = 0; b < PARALLEL_BYTES; b++) frame.push_back(w.range(8 * b + 7, 8 * b));
+    }
+    outStream.read();
+    uint32_t outsize = outSizeStream.read();
+
+    int errCnt = 0;
+    std::string err;
+    if (outsize > frame.size() || frame.size() - outsize >= PARALLEL_BYTES) {
+        err = "frame size does not match the output words";
+    } else {
+        frame.resize(outsize);
+        err = checkFrame<BS>(frame, in);
+    }
+    if (err.empty() && (!inStream.empty() || !outStream.empty() || !outStreamEos.empty() || !outSizeStream.empty()))
+        err = "unexpected data left in the streams";
+    if (!err.empty()) {
+        std::cout << name << ": " << err << std::endl;
+        errCnt = 1;
+    }
+    std::cout << name << ": " << input_size << " -> " << outsize << (errCnt ? " FAILED" : " OK") << std::endl;
+    return errCnt;
+}
+
+int main(int argc, char* argv[]) {
+    std::ifstream inputFile;
+
+    // Input file open for input_size
+    inputFile.open(argv[1], std::ofstream::binary | std::ofstream::in);
+    if (!inputFile.is_open()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        exit(0);
+    }
+    std::vector<uint8_t> sample((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+    inputFile.close();
+
+    // sample.txt repeated over four blocks and a partial one, which compress,
+    // followed by a block of pseudo-random bytes, which has to be stored
+    std::vector<uint8_t> blocks;
+    while (blocks.size() < 4 * BLOCK_SIZE + 1000) blocks.insert(blocks.end(), sample.begin(), sample.end());
+    blocks.resize(4 * BLOCK_SIZE + 1000);
+    uint32_t x = 12345;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        blocks.push_back((x >> 16) & 0xff);
+    }
+
+    int errCnt = 0;
+    errCnt += compressAndCheck<BLOCK_SIZE>("sample", sample);
+    errCnt += compressAndCheck<BLOCK_SIZE>("blocks", blocks);
+    errCnt += compressAndCheck<BLOCK_SIZE>("empty", std::vector<uint8_t>());
+    // The same data in 256 KB blocks: one that compresses, and one partial block ending in the random bytes
+    errCnt += compressAndCheck<256 * 1024>("blocks, 256 KB", blocks);
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_frame_decompress.hpp"
+
+#define PARALLEL_BYTES 8
+#define NUM_CORE_LOG2 2
+#define BLOCK_SIZE (64 * 1024)
+
+typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
+typedef ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> uintS_t;
+
+void lz4FrameDecompressRun(hls::stream<uintV_t>& inStream, hls::stream<uintS_t>& outStream, uint32_t input_size) {
+    xf::compression::lz4DecompressFrame<PARALLEL_BYTES, NUM_CORE_LOG2, BLOCK_SIZE>(inStream, outStream, input_size);
+}
+
+static bool readFile(const std::string& name, std::vector<uint8_t>& data) {
+    std::ifstream file(name.c_str(), std::ifstream::binary | std::ifstream::in);
+    if (!file.is_open()) return false;
+    data.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Decompresses one frame and compares it with the original data, returns the number of errors
+static int checkFrame(const std::string& name, const std::vector<uint8_t>& frame, const std::vector<uint8_t>& orig) {
+    hls::stream<uintV_t> inStream("inStream");
+    hls::stream<uintS_t> outStream("outStream");
+
+    uint32_t input_size = frame.size();
+    for (uint32_t i = 0; i < input_size; i += PARALLEL_BYTES) {
+        uintV_t w = 0;
+        for (int b = 0; b < PARALLEL_BYTES && i + b < input_size; b++) w.range(8 * b + 7, 8 * b) = frame[i + b];
+        inStream << w;
+    }
+
+    // DECOMPRESSION CALL
+    lz4FrameDecompressRun(inStream, outStream, input_size);
+
+    // Only the last word before the zero end word may be partial
+    int errCnt = 0;
+    bool partial = false;
+    std::vector<uint8_t> dec;
+    for (uintS_t w = outStream.read(); w.range(PARALLEL_BYTES - 1, 0) != 0; w = outStream.read()) {
+        if (partial) errCnt = 1;
+        for (int b = 0; b < PARALLEL_BYTES; b++) {
+            if (w.range(b, b)) {
+                dec.push_back(w.range(PARALLEL_BYTES + 8 * b + 7, PARALLEL_BYTES + 8 * b));
+            } else {
+                partial = true;
+            }
+        }
+    }
+    if (dec != orig) {
+        std::cout << name << ": decompressed " << dec.size() << " bytes, expected " << orig.size() << std::endl;
+        errCnt = 1;
+    }
+    if (!inStream.empty() || !outStream.empty()) {
+        std::cout << name << ": unexpected data left in the streams" << std::endl;
+        errCnt = 1;
+    }
+    std::cout << name << ": " << input_size << " -> " << dec.size() << (errCnt ? " FAILED" : " OK") << std::endl;
+    return errCnt;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <sample.txt> <frame directory>" << std::endl;
+        return 1;
+    }
+    std::string frameDir = std::string(argv[2]) + "/";
+
+    std::vector<uint8_t> sample;
+    if (!readFile(argv[1], sample) || sample.empty()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        return 1;
+    }
+
+    // The sample_blocks frames hold sample.txt repeated over four 64 KB blocks, which compress,
+    // followed by 1000 pseudo-random bytes, which the lz4 utility stores uncompressed
+    std::vector<uint8_t> blocks;
+    while (blocks.size() < 4 * BLOCK_SIZE) blocks.insert(blocks.end(), sample.begin(), sample.end());
+    blocks.resize(4 * BLOCK_SIZE);
+    uint32_t x = 12345;
+    for (int i = 0; i < 1000; i++) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        blocks.push_back((x >> 16) & 0xff);
+    }
+
+    // Frames written by the lz4 utility (v1.9.4):
+    //   lz4 -B4 <blocks>                                default, content checksum
+    //   lz4 -B4 -BX --content-size <blocks>             block checksums and content size
+    //   lz4 -B4 --no-frame-crc <blocks>                 no checksum
+    //   lz4 -B4 -BD <blocks>                            linked blocks, matches reach into the previous block
+    //   lz4 sample.txt                                  one block
+    //   lz4 <empty file>                                end mark only
+    struct {
+        const char* name;
+        const std::vector<uint8_t>* orig;
+    } frames[] = {{"sample_blocks.lz4", &blocks},
+                  {"sample_blocks_bx.lz4", &blocks},
+                  {"sample_blocks_nocrc.lz4", &blocks},
+                  {"sample_blocks_bd.lz4", &blocks},
+                  {"sample.txt.lz4", &sample},
+                  {"empty.lz4", 0}};
+
+    int errCnt = 0;
+    const std::vector<uint8_t> empty;
+    for (unsigned int f = 0; f < sizeof(frames) / sizeof(frames[0]); f++) {
+        std::vector<uint8_t> frame;
+        if (!readFile(frameDir + frames[f].name, frame)) {
+            std::cout << "Cannot open " << frameDir + frames[f].name << std::endl;
+            errCnt++;
+            continue;
+        }
+        errCnt += checkFrame(frames[f].name, frame, frames[f].orig ? *frames[f].orig : empty);
+    }
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_compress.hpp"
+
+#define NUM_BLOCK 8
+#define M_LEN 6
+#define MIN_MATCH 4
+#define LZ_MAX_OFFSET_LIMIT 65536
+#define OFFSET_WINDOW 65536
+#define MAX_MATCH_LEN 255
+#define MAX_LIT_COUNT 4096
+#define MIN_BLOCK_SIZE 128
+#define LAZY_STEPS 2
+
+typedef ap_uint<8> uintV_t;
+
+void lz4LazyCompressRun(hls::stream<uintV_t>& inStream,
+                        hls::stream<uintV_t>& outStream,
+                        hls::stream<bool>& outStreamEos,
+                        hls::stream<uint32_t>& compressedSize,
+                        uint32_t max_lit_limit[NUM_BLOCK],
+                        uint32_t input_size,
+                        uint32_t core_idx) {
+    xf::compression::hlsLz4Core<uintV_t, 512, 16, NUM_BLOCK, M_LEN, MIN_MATCH, LZ_MAX_OFFSET_LIMIT, OFFSET_WINDOW,
+                                MAX_MATCH_LEN, MAX_LIT_COUNT, MIN_BLOCK_SIZE, LAZY_STEPS>(
+        inStream, outStream, outStreamEos, compressedSize, max_lit_limit, input_size, core_idx);
+}
+
+template <int STEPS>
+struct Compressor {
+    static void run(hls::stream<uintV_t>& inStream,
+                    hls::stream<uintV_t>& outStream,
+                    hls::stream<bool>& outStreamEos,
+                    hls::stream<uint32_t>& compressedSize,
+                    uint32_t max_lit_limit[NUM_BLOCK],
+                    uint32_t input_size) {
+        xf::compression::hlsLz4Core<uintV_t, 512, 16, NUM_BLOCK, M_LEN, MIN_MATCH, LZ_MAX_OFFSET_LIMIT, OFFSET_WINDOW,
+                                    MAX_MATCH_LEN, MAX_LIT_COUNT, MIN_BLOCK_SIZE, STEPS>(
+            inStream, outStream, outStreamEos, compressedSize, max_lit_limit, input_size, 0);
+    }
+};
+
+template <>
+struct Compressor<LAZY_STEPS> {
+    static void run(hls::stream<uintV_t>& inStream,
+                    hls::stream<uintV_t>& outStream,
+                    hls::stream<bool>& outStreamEos,
+                    hls::stream<uint32_t>& compressedSize,
+                    uint32_t max_lit_limit[NUM_BLOCK],
+                    uint32_t input_size) {
+        lz4LazyCompressRun(inStream, outStream, outStreamEos, compressedSize, max_lit_limit, input_size, 0);
+    }
+};
+
+// Reference LZ4 block decoder, returns false on a malformed sequence
+static bool lz4DecodeBlock(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < in.size()) {
+        uint8_t token = in[i++];
+        size_t litLen = token >> 4;
+        if (litLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= in.size()) return false;
+                b = in[i++];
+                litLen += b;
+            } while (b == 255);
+        }
+        if (i + litLen > in.size()) return false;
+        out.insert(out.end(), in.begin() + i, in.begin() + i + litLen);
+        i += litLen;
+        // The last sequence carries literals only
+        if (i == in.size()) break;
+        if (i + 2 > in.size()) return false;
+        size_t offset = in[i] | (in[i + 1] << 8);
+        i += 2;
+        size_t matchLen = token & 0xF;
+        if (matchLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= in.size()) return false;
+                b = in[i++];
+                matchLen += b;
+            } while (b == 255);
+        }
+        matchLen += 4;
+        if (offset == 0 || offset > out.size()) return false;
+        size_t src = out.size() - offset;
+        for (size_t k = 0; k < matchLen; k++) out.push_back(out[src + k]);
+    }
+    return true;
+}
+
+// Compresses one block with STEPS lazy steps and decodes it with the reference decoder,
+// returns the compressed size, or 0 on an error
+template <int STEPS>
+uint32_t compressAndCheck(const std::string& name, const std::vector<uint8_t>& in) {
+    hls::stream<uintV_t> inStream("inStream");
+    hls::stream<uintV_t> outStream("outStream");
+    hls::stream<bool> outStreamEos("outStreamEos");
+    hls::stream<uint32_t> compressedSize("compressedSize");
+    uint32_t max_lit_limit[NUM_BLOCK] = {0};
+
+    for (unsigned int i = 0; i < in.size(); i++) inStream << in[i];
+
+    // COMPRESSION CALL
+    Compressor<STEPS>::run(inStream, outStream, outStreamEos, compressedSize, max_lit_limit, in.size());
+
+    std::vector<uint8_t> enc;
+    for (bool eos = outStreamEos.read(); !eos; eos = outStreamEos.read()) enc.push_back(outStream.read());
+    outStream.read();
+    uint32_t outsize = compressedSize.read();
+
+    std::vector<uint8_t> dec;
+    bool ok = true;
+    if (outsize != enc.size() || max_lit_limit[0]) {
+        std::cout << name << ", LAZY_STEPS " << STEPS << ": block is not compressible" << std::endl;
+        ok = false;
+    } else if (!lz4DecodeBlock(enc, dec) || dec != in) {
+        std::cout << name << ", LAZY_STEPS " << STEPS << ": decompressed data does not match the input" << std::endl;
+        ok = false;
+    }
+    if (!inStream.empty() || !outStream.empty() || !outStreamEos.empty() || !compressedSize.empty()) {
+        std::cout << name << ", LAZY_STEPS " << STEPS << ": unexpected data left in the streams" << std::endl;
+        ok = false;
+    }
+    std::cout << name << ", LAZY_STEPS " << STEPS << ": " << in.size() << " -> " << enc.size()
+              << (ok ? " OK" : " FAILED") << std::endl;
+    return ok ? outsize : 0;
+}
+
+// Compresses at LAZY_STEPS 0, 1 and 2, returns the error count. The lazy blocks must not be larger than the
+// greedy one when lazyNoLarger is set
+int checkSteps(const std::string& name, const std::vector<uint8_t>& in, bool lazyNoLarger) {
+    uint32_t size0 = compressAndCheck<0>(name, in);
+    uint32_t size1 = compressAndCheck<1>(name, in);
+    uint32_t size2 = compressAndCheck<2>(name, in);
+    if (size0 == 0 || size1 == 0 || size2 == 0) return 1;
+    if (lazyNoLarger && (size1 > size0 || size2 > size0)) {
+        std::cout << name << ": lazy matching output larger than greedy" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::ifstream inputFile;
+
+    // Input file open for input_size
+    inputFile.open(argv[1], std::ofstream::binary | std::ofstream::in);
+    if (!inputFile.is_open()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        exit(0);
+    }
+    std::vector<uint8_t> sample((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+    inputFile.close();
+
+    // sample.txt repeated to 60000 bytes with one pseudo-random letter in every 50 bytes, so that the
+    // longest match often starts one or two bytes after the greedy one
+    std::vector<uint8_t> repeated;
+    uint32_t x = 12345;
+    while (repeated.size() < 60000) {
+        for (unsigned int i = 0; i < sample.size() && repeated.size() < 60000; i++) {
+            x = (x * 1103515245 + 12345) & 0x7fffffff;
+            repeated.push_back(((x >> 16) % 50 == 0) ? 'a' + (x >> 8) % 26 : sample[i]);
+        }
+    }
+
+    // Pseudo-random bytes with short repeats, mostly literals
+    std::vector<uint8_t> mixed;
+    while (mixed.size() < 20000) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        if ((x >> 16) % 4 == 0 && mixed.size() > 64) {
+            size_t src = mixed.size() - 1 - (x >> 8) % 64;
+            for (int k = 0; k < 4 + (int)(x % 8); k++) mixed.push_back(mixed[src + k]);
+        } else {
+            mixed.push_back(x >> 16);
+        }
+    }
+
+    int errCnt = 0;
+    errCnt += checkSteps("repeated", repeated, true);
+    errCnt += checkSteps("sample", sample, false);
+    errCnt += checkSteps("mixed", mixed, false);
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_compress.hpp"
+
+#define PARALLEL_BYTES 8
+#define MAX_LIT_COUNT 4096
+#define PARALLEL_BLOCK 1
+#define LZ_MAX_OFFSET_LIMIT 65536
+#define MAX_MATCH_LEN 255
+#define MATCH_LEN 6
+
+typedef ap_uint<8> uintV_t;
+typedef ap_uint<PARALLEL_BYTES * 8> uintW_t;
+
+int const c_minMatch = 4;
+
+void lz4MultiByteCompressEngineRun(hls::stream<uintW_t>& inStream,
+                                   hls::stream<uintV_t>& lz4Out,
+                                   hls::stream<bool>& lz4Out_eos,
+                                   hls::stream<uint32_t>& lz4OutSize,
+                                   uint32_t max_lit_limit[PARALLEL_BLOCK],
+                                   uint32_t input_size,
+                                   uint32_t core_idx) {
+    xf::compression::hlsLz4MultiByteCore<PARALLEL_BYTES, PARALLEL_BLOCK, MATCH_LEN, c_minMatch, LZ_MAX_OFFSET_LIMIT,
+                                         MAX_MATCH_LEN, MAX_LIT_COUNT>(inStream, lz4Out, lz4Out_eos, lz4OutSize,
+                                                                       max_lit_limit, input_size, core_idx);
+}
+
+// Reference LZ4 block decoder, returns false on a malformed sequence
+static bool lz4DecodeBlock(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < in.size()) {
+        uint8_t token = in[i++];
+        size_t litLen = token >> 4;
+        if (litLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= in.size()) return false;
+                b = in[i++];
+                litLen += b;
+            } while (b == 255);
+        }
+        if (i + litLen > in.size()) return false;
+        out.insert(out.end(), in.begin() + i, in.begin() + i + litLen);
+        i += litLen;
+        // The last sequence carries literals only
+        if (i == in.size()) break;
+        if (i + 2 > in.size()) return false;
+        size_t offset = in[i] | (in[i + 1] << 8);
+        i += 2;
+        size_t matchLen = token & 0xF;
+        if (matchLen == 15) {
+            uint8_t b;
+            do {
+                if (i >= in.size()) return false;
+                b = in[i++];
+                matchLen += b;
+            } while (b == 255);
+        }
+        matchLen += 4;
+        if (offset == 0 || offset > out.size()) return false;
+        size_t src = out.size() - offset;
+        for (size_t k = 0; k < matchLen; k++) out.push_back(out[src + k]);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    hls::stream<uintW_t> wordstr_in("compressIn");
+    hls::stream<uintV_t> bytestr_out("compressOut");
+
+    hls::stream<bool> lz4Out_eos;
+    hls::stream<uint32_t> lz4OutSize;
+    uint32_t max_lit_limit[PARALLEL_BLOCK] = {0};
+
+    std::ifstream inputFile;
+
+    // Input file open for input_size
+    inputFile.open(argv[1], std::ofstream::binary | std::ofstream::in);
+    if (!inputFile.is_open()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        exit(0);
+    }
+    std::vector<uint8_t> in((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+    inputFile.close();
+    uint32_t input_size = in.size();
+
+    // Pushing input file into input stream, PARALLEL_BYTES bytes per word
+    for (uint32_t i = 0; i < input_size; i += PARALLEL_BYTES) {
+        uintW_t w = 0;
+        for (int b = 0; b < PARALLEL_BYTES && i + b < input_size; b++) w.range(8 * b + 7, 8 * b) = in[i + b];
+        wordstr_in << w;
+    }
+
+    // COMPRESSION CALL
+    lz4MultiByteCompressEngineRun(wordstr_in, bytestr_out, lz4Out_eos, lz4OutSize, max_lit_limit, input_size, 0);
+
+    std::vector<uint8_t> enc;
+    uint32_t outsize = lz4OutSize.read();
+    bool eos_flag = lz4Out_eos.read();
+    while (outsize > 0) {
+        while (!eos_flag) {
+            enc.push_back(bytestr_out.read());
+            eos_flag = lz4Out_eos.read();
+            outsize--;
+        }
+        if (!eos_flag) outsize = lz4OutSize.read();
+    }
+    bytestr_out.read();
+    std::cout << "------- Compression Ratio: " << (float)input_size / enc.size() << " -------" << std::endl;
+
+    // The block is only valid when it is smaller than the input and no literal run hit MAX_LIT_COUNT
+    int errCnt = 0;
+    std::vector<uint8_t> dec;
+    if (max_lit_limit[0] || enc.size() >= input_size) {
+        std::cout << "Block is not compressible" << std::endl;
+        errCnt = 1;
+    } else if (!lz4DecodeBlock(enc, dec) || dec != in) {
+        std::cout << "Decompressed data does not match the input" << std::endl;
+        errCnt = 1;
+    }
+    if (!wordstr_in.empty() || !bytestr_out.empty()) {
+        std::cout << "Unexpected data left in the streams" << std::endl;
+        errCnt = 1;
+    }
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
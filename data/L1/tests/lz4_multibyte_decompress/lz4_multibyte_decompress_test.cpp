@@ -0,0 +1,178 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_decompress.hpp"
+
+#define PARALLEL_BYTES 8
+#define HISTORY_SIZE (64 * 1024)
+
+typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
+typedef ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> uintS_t;
+
+void lz4MultiByteDecompressRun(hls::stream<uintV_t>& inStream,
+                               hls::stream<uintS_t>& outStream,
+                               hls::stream<uint32_t>& blockSizeStream) {
+    xf::compression::lz4CoreDecompressEngine<PARALLEL_BYTES, HISTORY_SIZE>(inStream, outStream, blockSizeStream);
+}
+
+// Builds an LZ4 block sequence by sequence, along with its decompressed data
+class BlockWriter {
+   public:
+    std::vector<uint8_t> block;
+    std::vector<uint8_t> data;
+
+    void sequence(const std::vector<uint8_t>& lit, uint32_t offset, uint32_t matchLen) {
+        uint32_t litLen = lit.size();
+        uint32_t ml = matchLen - 4;
+        block.push_back(((litLen < 15 ? litLen : 15) << 4) | (ml < 15 ? ml : 15));
+        if (litLen >= 15) length(litLen - 15);
+        block.insert(block.end(), lit.begin(), lit.end());
+        data.insert(data.end(), lit.begin(), lit.end());
+        block.push_back(offset & 0xFF);
+        block.push_back(offset >> 8);
+        if (ml >= 15) length(ml - 15);
+        // byte by byte, so that overlapping matches repeat the last offset bytes
+        size_t src = data.size() - offset;
+        for (uint32_t k = 0; k < matchLen; k++) data.push_back(data[src + k]);
+    }
+
+    // The block ends with literals only
+    void last(const std::vector<uint8_t>& lit) {
+        uint32_t litLen = lit.size();
+        block.push_back((litLen < 15 ? litLen : 15) << 4);
+        if (litLen >= 15) length(litLen - 15);
+        block.insert(block.end(), lit.begin(), lit.end());
+        data.insert(data.end(), lit.begin(), lit.end());
+    }
+
+   private:
+    void length(uint32_t n) {
+        for (; n >= 255; n -= 255) block.push_back(255);
+        block.push_back(n);
+    }
+};
+
+template <int PB>
+struct Decompressor {
+    static void run(hls::stream<ap_uint<PB * 8> >& inStream,
+                    hls::stream<ap_uint<(PB * 8) + PB> >& outStream,
+                    hls::stream<uint32_t>& blockSizeStream) {
+        xf::compression::lz4CoreDecompressEngine<PB, HISTORY_SIZE>(inStream, outStream, blockSizeStream);
+    }
+};
+
+template <>
+struct Decompressor<PARALLEL_BYTES> {
+    static void run(hls::stream<uintV_t>& inStream, hls::stream<uintS_t>& outStream, hls::stream<uint32_t>& blockSizeStream) {
+        lz4MultiByteDecompressRun(inStream, outStream, blockSizeStream);
+    }
+};
+
+// Decompresses one block with PB bytes per word and compares it with the expected data, returns the error count
+template <int PB>
+int checkBlock(const std::string& name, const BlockWriter& blk) {
+    hls::stream<ap_uint<PB * 8> > inStream("inStream");
+    hls::stream<ap_uint<(PB * 8) + PB> > outStream("outStream");
+    hls::stream<uint32_t> blockSizeStream("blockSizeStream");
+
+    const std::vector<uint8_t>& c = blk.block;
+    for (size_t i = 0; i < c.size(); i += PB) {
+        ap_uint<PB * 8> w = 0;
+        for (int b = 0; b < PB && i + b < c.size(); b++) w.range(8 * b + 7, 8 * b) = c[i + b];
+        inStream << w;
+    }
+    blockSizeStream << (uint32_t)c.size();
+    blockSizeStream << 0;
+
+    // DECOMPRESSION CALL
+    Decompressor<PB>::run(inStream, outStream, blockSizeStream);
+
+    std::vector<uint8_t> dec;
+    for (ap_uint<(PB * 8) + PB> w = outStream.read(); w.range(PB - 1, 0) != 0; w = outStream.read())
+        for (int b = 0; b < PB; b++)
+            if (w.range(b, b)) dec.push_back(w.range(PB + 8 * b + 7, PB + 8 * b));
+
+    int errCnt = 0;
+    if (dec != blk.data) {
+        size_t k = 0;
+        while (k < dec.size() && k < blk.data.size() && dec[k] == blk.data[k]) k++;
+        std::cout << name << ": decompressed " << dec.size() << " bytes, expected " << blk.data.size()
+                  << ", first difference at byte " << k << std::endl;
+        errCnt = 1;
+    }
+    if (!inStream.empty() || !outStream.empty() || !blockSizeStream.empty()) {
+        std::cout << name << ": unexpected data left in the streams" << std::endl;
+        errCnt = 1;
+    }
+    std::cout << name << " (" << PB << " bytes per word): " << c.size() << " -> " << dec.size()
+              << (errCnt ? " FAILED" : " OK") << std::endl;
+    return errCnt;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t x = 12345;
+    std::vector<uint8_t> lit;
+
+    // Every offset up to twice the word size with match lengths around the word boundaries,
+    // each match preceded by enough random literals to reach back
+    const uint32_t matchLens[] = {4, 5, 7, 8, 9, 15, 16, 17, 19, 23, 33, 64, 300};
+    BlockWriter mixed;
+    for (uint32_t offset = 1; offset <= 2 * PARALLEL_BYTES + 1; offset++) {
+        for (unsigned int m = 0; m < sizeof(matchLens) / sizeof(matchLens[0]); m++) {
+            lit.clear();
+            for (uint32_t i = 0; i < offset + m % 3; i++) {
+                x = (x * 1103515245 + 12345) & 0x7fffffff;
+                lit.push_back((x >> 16) & 0xff);
+            }
+            mixed.sequence(lit, offset, matchLens[m]);
+            // a match right after a match, without literals
+            if (m % 4 == 1) mixed.sequence(std::vector<uint8_t>(), offset, matchLens[m] + 3);
+        }
+    }
+    lit.assign(12, 'x');
+    mixed.last(lit);
+
+    // One zero byte repeated over a long run, and a short field repeated with offset 3
+    BlockWriter runs;
+    lit.assign(1, 0);
+    runs.sequence(lit, 1, 40000);
+    lit.assign(3, 0);
+    lit[0] = 'a';
+    lit[1] = 'b';
+    lit[2] = 'c';
+    runs.sequence(lit, 3, 20000);
+    lit.assign(12, 'y');
+    runs.last(lit);
+
+    int errCnt = 0;
+    errCnt += checkBlock<PARALLEL_BYTES>("mixed offsets", mixed);
+    errCnt += checkBlock<PARALLEL_BYTES>("runs", runs);
+    errCnt += checkBlock<4>("mixed offsets", mixed);
+    errCnt += checkBlock<4>("runs", runs);
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
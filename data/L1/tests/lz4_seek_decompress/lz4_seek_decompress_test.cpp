@@ -0,0 +1,184 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_frame_compress.hpp"
+#include "lz4_frame_decompress.hpp"
+
+#define PARALLEL_BYTES 8
+#define NUM_CORE_LOG2 1
+#define BLOCK_SIZE (64 * 1024)
+#define SEEK_ENTRIES 16
+
+typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
+typedef ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> uintS_t;
+
+void lz4DecompressRangeRun(const uintV_t* in,
+                           hls::stream<uintS_t>& outStream,
+                           uint32_t frame_size,
+                           uint32_t offset,
+                           uint32_t length) {
+    xf::compression::lz4DecompressRange<PARALLEL_BYTES>(in, outStream, frame_size, offset, length);
+}
+
+static uint32_t read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static std::vector<uint8_t> readOut(hls::stream<uintS_t>& outStream) {
+    std::vector<uint8_t> dec;
+    for (uintS_t w = outStream.read(); w.range(PARALLEL_BYTES - 1, 0) != 0; w = outStream.read())
+        for (int b = 0; b < PARALLEL_BYTES; b++)
+            if (w.range(b, b)) dec.push_back(w.range(PARALLEL_BYTES + 8 * b + 7, PARALLEL_BYTES + 8 * b));
+    return dec;
+}
+
+// Checks the skippable frame holding the seek table against the block layout of the frame
+static std::string checkSeekTable(const std::vector<uint8_t>& f, uint32_t dataSize) {
+    const uint32_t footer = xf::compression::SEEK_FOOTER_SIZE;
+    const uint32_t entrySize = xf::compression::SEEK_ENTRY_SIZE;
+    if (f.size() < 8 + footer || read32(&f[f.size() - 4]) != xf::compression::SEEK_TABLE_MAGIC)
+        return "no seek table magic";
+    uint32_t nEntries = read32(&f[f.size() - footer]);
+    if (nEntries > SEEK_ENTRIES || f[f.size() - 5] != 0) return "bad seek table footer";
+    uint32_t tableSize = nEntries * entrySize + footer;
+    if (f.size() < tableSize + 8) return "seek table larger than the frame";
+    size_t skippable = f.size() - tableSize - 8;
+    if (read32(&f[skippable]) != xf::compression::SEEK_SKIPPABLE_MAGIC || read32(&f[skippable + 4]) != tableSize)
+        return "bad skippable frame header";
+
+    // The entries must walk the frame from the first block to the end mark
+    uint8_t flg = f[4];
+    size_t pos = 7 + ((flg & 0x08) ? 8 : 0) + ((flg & 0x01) ? 4 : 0);
+    uint32_t total = 0;
+    for (uint32_t e = 0; e < nEntries; e++) {
+        uint32_t compSize = read32(&f[skippable + 8 + e * entrySize]);
+        uint32_t blockSize = read32(&f[skippable + 8 + e * entrySize + 4]);
+        uint32_t payload = read32(&f[pos]) & 0x7FFFFFFF;
+        if (compSize != 4 + payload + ((flg & 0x10) ? 4 : 0)) return "compressed size entry does not match the block";
+        if (blockSize == 0 || blockSize > BLOCK_SIZE) return "bad decompressed size entry";
+        pos += compSize;
+        total += blockSize;
+    }
+    if (total != dataSize) return "decompressed size entries do not add up";
+    if (read32(&f[pos]) != 0) return "seek table does not end at the end mark";
+    return "";
+}
+
+int main(int argc, char* argv[]) {
+    std::ifstream inputFile;
+
+    // Input file open for input_size
+    inputFile.open(argv[1], std::ofstream::binary | std::ofstream::in);
+    if (!inputFile.is_open()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        exit(0);
+    }
+    std::vector<uint8_t> sample((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+    inputFile.close();
+
+    // sample.txt repeated over three blocks and a partial one, followed by pseudo-random bytes,
+    // so that the frame has compressed and stored blocks of several sizes
+    std::vector<uint8_t> data;
+    while (data.size() < 3 * BLOCK_SIZE + 1000) data.insert(data.end(), sample.begin(), sample.end());
+    data.resize(3 * BLOCK_SIZE + 1000);
+    uint32_t x = 12345;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        data.push_back((x >> 16) & 0xff);
+    }
+    uint32_t input_size = data.size();
+
+    // Seekable frame with block checksums, so that the range reader has to step over them
+    hls::stream<uintV_t> inStream("inStream");
+    hls::stream<uintV_t> frameStream("frameStream");
+    hls::stream<bool> frameStreamEos("frameStreamEos");
+    hls::stream<uint32_t> frameSizeStream("frameSizeStream");
+    for (uint32_t i = 0; i < input_size; i += PARALLEL_BYTES) {
+        uintV_t w = 0;
+        for (int b = 0; b < PARALLEL_BYTES && i + b < input_size; b++) w.range(8 * b + 7, 8 * b) = data[i + b];
+        inStream << w;
+    }
+    xf::compression::lz4CompressFrame<PARALLEL_BYTES, NUM_CORE_LOG2, BLOCK_SIZE, true, 0, SEEK_ENTRIES>(
+        inStream, frameStream, frameStreamEos, frameSizeStream, input_size);
+    std::vector<uintV_t> frameWords;
+    for (bool eos = frameStreamEos.read(); !eos; eos = frameStreamEos.read()) frameWords.push_back(frameStream.read());
+    frameStream.read();
+    uint32_t frame_size = frameSizeStream.read();
+
+    int errCnt = 0;
+    std::vector<uint8_t> frame;
+    for (unsigned int i = 0; i < frameWords.size(); i++)
+        for (int b = 0; b < PARALLEL_BYTES; b++) frame.push_back(frameWords[i].range(8 * b + 7, 8 * b));
+    frame.resize(frame_size);
+    std::string err = checkSeekTable(frame, input_size);
+    if (!err.empty()) {
+        std::cout << "Seek table: " << err << std::endl;
+        errCnt++;
+    }
+
+    // The whole frame through the frame decompressor, which drains the seek table
+    hls::stream<uintS_t> outStream("outStream");
+    for (unsigned int i = 0; i < frameWords.size(); i++) inStream << frameWords[i];
+    xf::compression::lz4DecompressFrame<PARALLEL_BYTES, NUM_CORE_LOG2, BLOCK_SIZE>(inStream, outStream, frame_size);
+    if (readOut(outStream) != data || !inStream.empty()) {
+        std::cout << "Whole frame: decompressed data differs" << std::endl;
+        errCnt++;
+    }
+
+    // Ranges inside one block, across block boundaries, over the stored block, cut at the end and empty
+    const uint32_t ranges[][2] = {{0, 1},
+                                  {0, input_size},
+                                  {100, 200},
+                                  {BLOCK_SIZE - 1, 2},
+                                  {BLOCK_SIZE, BLOCK_SIZE},
+                                  {BLOCK_SIZE - 3, BLOCK_SIZE + 10},
+                                  {2 * BLOCK_SIZE + 5, 70000},
+                                  {3 * BLOCK_SIZE + 999, 3},
+                                  {input_size - 3, 10},
+                                  {input_size - 1, 1},
+                                  {1000, 0},
+                                  {BLOCK_SIZE, 0},
+                                  {input_size, 5}};
+    for (unsigned int r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        uint32_t offset = ranges[r][0];
+        uint32_t length = ranges[r][1];
+        uint32_t end = (offset + length < input_size) ? offset + length : input_size;
+        std::vector<uint8_t> expected;
+        if (offset < end) expected.assign(data.begin() + offset, data.begin() + end);
+
+        // DECOMPRESSION CALL
+        lz4DecompressRangeRun(frameWords.data(), outStream, frame_size, offset, length);
+
+        std::vector<uint8_t> dec = readOut(outStream);
+        bool ok = (dec == expected) && outStream.empty();
+        std::cout << "Range [" << offset << ", +" << length << "): " << dec.size() << " bytes"
+                  << (ok ? " OK" : " FAILED") << std::endl;
+        if (!ok) errCnt++;
+    }
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lz4_decompress.hpp"
+
+#ifndef __SYNTHESIS__
+#include "lz4SWHost.hpp"
+#endif
+
+#define PARALLEL_BYTES 8
+#define HISTORY_SIZE (64 * 1024)
+#define BLOCK_SIZE_IN_KB 64
+
+typedef ap_uint<PARALLEL_BYTES * 8> uintV_t;
+typedef ap_uint<(PARALLEL_BYTES * 8) + PARALLEL_BYTES> uintS_t;
+
+void lz4SWHostDecompressRun(hls::stream<uintV_t>& inStream,
+                            hls::stream<uintS_t>& outStream,
+                            hls::stream<uint32_t>& blockSizeStream) {
+    xf::compression::lz4CoreDecompressEngine<PARALLEL_BYTES, HISTORY_SIZE>(inStream, outStream, blockSizeStream);
+}
+
+#ifndef __SYNTHESIS__
+
+static bool readFile(const std::string& name, std::vector<uint8_t>& data) {
+    std::ifstream file(name.c_str(), std::ifstream::binary | std::ifstream::in);
+    if (!file.is_open()) return false;
+    data.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static uint32_t read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Decompresses one block through the top, appends it to out
+static void decompressBlock(const uint8_t* block, uint32_t size, std::vector<uint8_t>& out) {
+    hls::stream<uintV_t> inStream("inStream");
+    hls::stream<uintS_t> outStream("outStream");
+    hls::stream<uint32_t> blockSizeStream("blockSizeStream");
+
+    for (uint32_t i = 0; i < size; i += PARALLEL_BYTES) {
+        uintV_t w = 0;
+        for (int b = 0; b < PARALLEL_BYTES && i + b < size; b++) w.range(8 * b + 7, 8 * b) = block[i + b];
+        inStream << w;
+    }
+    blockSizeStream << size;
+    blockSizeStream << 0;
+
+    // DECOMPRESSION CALL
+    lz4SWHostDecompressRun(inStream, outStream, blockSizeStream);
+
+    for (uintS_t w = outStream.read(); w.range(PARALLEL_BYTES - 1, 0) != 0; w = outStream.read())
+        for (int b = 0; b < PARALLEL_BYTES; b++)
+            if (w.range(b, b)) out.push_back(w.range(PARALLEL_BYTES + 8 * b + 7, PARALLEL_BYTES + 8 * b));
+}
+
+// Decodes a frame written by lz4SWHost block by block with the LZ4 core, returns an error message or an empty string
+static std::string decodeFrame(const std::vector<uint8_t>& f, std::vector<uint8_t>& dec) {
+    if (f.size() < 7 || read32(&f[0]) != 0x184D2204) return "bad magic";
+    uint8_t flg = f[4];
+    if (flg & 0x10) return "unexpected block checksums";
+    size_t i = 7 + ((flg & 0x08) ? 8 : 0);
+    while (true) {
+        if (i + 4 > f.size()) return "truncated frame";
+        uint32_t bsize = read32(&f[i]);
+        i += 4;
+        if (bsize == 0) break;
+        bool stored = bsize & 0x80000000;
+        bsize &= 0x7FFFFFFF;
+        if (bsize > BLOCK_SIZE_IN_KB * 1024 || i + bsize > f.size()) return "bad block size";
+        size_t before = dec.size();
+        if (stored)
+            dec.insert(dec.end(), f.begin() + i, f.begin() + i + bsize);
+        else
+            decompressBlock(&f[i], bsize, dec);
+        if (dec.size() - before > BLOCK_SIZE_IN_KB * 1024) return "block larger than the block size";
+        i += bsize;
+    }
+    if (i + ((flg & 0x04) ? 4 : 0) != f.size()) return "unexpected frame end";
+    return "";
+}
+
+// Compresses with lz4SWHost, decodes the frame with the LZ4 core and with lz4SWHost, returns the error count
+static int checkRoundTrip(const std::string& name, std::vector<uint8_t> in) {
+    lz4SWHost host(BLOCK_SIZE_IN_KB, 4);
+    host.setMCR(MAX_CR_DEFAULT);
+    host.setProfile(false);
+
+    int errCnt = 0;
+    std::vector<uint8_t> frame(in.size() + in.size() / 2 + 1024);
+    std::cout << name << ": compress MB/s ";
+    frame.resize(host.xilCompress(in.data(), frame.data(), in.size()));
+    std::cout << std::endl;
+
+    std::vector<uint8_t> dec;
+    std::string err = decodeFrame(frame, dec);
+    if (err.empty() && dec != in) err = "LZ4 core output differs";
+    if (!err.empty()) {
+        std::cout << name << ": " << err << std::endl;
+        errCnt++;
+    }
+
+    std::vector<uint8_t> out(in.size() + BLOCK_SIZE_IN_KB * 1024);
+    std::cout << name << ": decompress MB/s ";
+    out.resize(host.xilDecompress(frame.data(), out.data(), frame.size()));
+    std::cout << std::endl;
+    if (out != in) {
+        std::cout << name << ": lz4SWHost decompressed " << out.size() << " bytes, expected " << in.size()
+                  << std::endl;
+        errCnt++;
+    }
+    std::cout << name << ": " << in.size() << " -> " << frame.size() << (errCnt ? " FAILED" : " OK") << std::endl;
+    return errCnt;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <sample.txt> <sample.txt.lz4>" << std::endl;
+        return 1;
+    }
+    std::vector<uint8_t> sample;
+    if (!readFile(argv[1], sample) || sample.empty()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        return 1;
+    }
+
+    int errCnt = 0;
+
+    // Frame written by the lz4 utility (v1.9.4) with
+    //   lz4 -B4 sample.txt
+    // decoded by lz4SWHost
+    std::vector<uint8_t> frame;
+    if (!readFile(argv[2], frame)) {
+        std::cout << "Cannot open " << argv[2] << std::endl;
+        errCnt++;
+    } else {
+        lz4SWHost host(BLOCK_SIZE_IN_KB, 4);
+        host.setMCR(MAX_CR_DEFAULT);
+        host.setProfile(false);
+        std::vector<uint8_t> out(sample.size() + BLOCK_SIZE_IN_KB * 1024);
+        std::cout << "lz4 utility frame: decompress MB/s ";
+        out.resize(host.xilDecompress(frame.data(), out.data(), frame.size()));
+        std::cout << std::endl;
+        bool ok = (out == sample);
+        if (!ok) errCnt++;
+        std::cout << "lz4 utility frame: " << frame.size() << " -> " << out.size() << (ok ? " OK" : " FAILED")
+                  << std::endl;
+    }
+
+    // sample.txt with every 97th byte replaced, repeated over four blocks and a partial one,
+    // followed by a block of pseudo-random bytes that lz4SWHost has to store
+    std::vector<uint8_t> blocks;
+    while (blocks.size() < 4 * BLOCK_SIZE_IN_KB * 1024 + 1000) {
+        size_t start = blocks.size();
+        blocks.insert(blocks.end(), sample.begin(), sample.end());
+        for (size_t i = start + (start / sample.size()) % 97; i < blocks.size(); i += 97) blocks[i] = '#';
+    }
+    blocks.resize(4 * BLOCK_SIZE_IN_KB * 1024 + 1000);
+    uint32_t x = 12345;
+    for (int i = 0; i < BLOCK_SIZE_IN_KB * 1024; i++) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        blocks.push_back((x >> 16) & 0xff);
+    }
+
+    errCnt += checkRoundTrip("sample", sample);
+    errCnt += checkRoundTrip("blocks", blocks);
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
+
+#endif
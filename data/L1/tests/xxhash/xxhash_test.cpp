@@ -0,0 +1,264 @@
+/*
+ * Copyright 2019-2022 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "xxhash.hpp"
+
+#define W 16
+
+void xxhashRun(hls::stream<ap_uint<32> >& seed32Strm,
+               hls::stream<ap_uint<8 * W> >& in32Strm,
+               hls::stream<ap_uint<32> >& inLen32Strm,
+               hls::stream<bool>& endIn32Strm,
+               hls::stream<ap_uint<32> >& out32Strm,
+               hls::stream<bool>& endOut32Strm,
+               hls::stream<ap_uint<64> >& seed64Strm,
+               hls::stream<ap_uint<8 * W> >& in64Strm,
+               hls::stream<ap_uint<32> >& inLen64Strm,
+               hls::stream<bool>& endIn64Strm,
+               hls::stream<ap_uint<64> >& out64Strm,
+               hls::stream<bool>& endOut64Strm) {
+    xf::compression::xxhash32<W>(seed32Strm, in32Strm, inLen32Strm, endIn32Strm, out32Strm, endOut32Strm);
+    xf::compression::xxhash64<W>(seed64Strm, in64Strm, inLen64Strm, endIn64Strm, out64Strm, endOut64Strm);
+}
+
+// Reference XXH32 and XXH64
+static uint32_t rotl32(uint32_t x, int r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+static uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint32_t read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t read64(const uint8_t* p) {
+    return read32(p) | ((uint64_t)read32(p + 4) << 32);
+}
+
+static uint32_t refXxh32(const uint8_t* p, size_t len, uint32_t seed) {
+    const uint32_t P1 = 2654435761U, P2 = 2246822519U, P3 = 3266489917U, P4 = 668265263U, P5 = 374761393U;
+    size_t i = 0;
+    uint32_t h;
+    if (len >= 16) {
+        uint32_t v[4] = {seed + P1 + P2, seed + P2, seed, seed - P1};
+        for (; i + 16 <= len; i += 16)
+            for (int l = 0; l < 4; l++) v[l] = rotl32(v[l] + read32(p + i + 4 * l) * P2, 13) * P1;
+        h = rotl32(v[0], 1) + rotl32(v[1], 7) + rotl32(v[2], 12) + rotl32(v[3], 18);
+    } else {
+        h = seed + P5;
+    }
+    h += (uint32_t)len;
+    for (; i + 4 <= len; i += 4) h = rotl32(h + read32(p + i) * P3, 17) * P4;
+    for (; i < len; i++) h = rotl32(h + p[i] * P5, 11) * P1;
+    h ^= h >> 15;
+    h *= P2;
+    h ^= h >> 13;
+    h *= P3;
+    h ^= h >> 16;
+    return h;
+}
+
+static uint64_t refXxh64(const uint8_t* p, size_t len, uint64_t seed) {
+    const uint64_t P1 = 11400714785074694791ULL, P2 = 14029467366897019727ULL, P3 = 1609587929392839161ULL,
+                   P4 = 9650029242287828579ULL, P5 = 2870177450012600261ULL;
+    size_t i = 0;
+    uint64_t h;
+    if (len >= 32) {
+        uint64_t v[4] = {seed + P1 + P2, seed + P2, seed, seed - P1};
+        for (; i + 32 <= len; i += 32)
+            for (int l = 0; l < 4; l++) v[l] = rotl64(v[l] + read64(p + i + 8 * l) * P2, 31) * P1;
+        h = rotl64(v[0], 1) + rotl64(v[1], 7) + rotl64(v[2], 12) + rotl64(v[3], 18);
+        for (int l = 0; l < 4; l++) h = (h ^ (rotl64(v[l] * P2, 31) * P1)) * P1 + P4;
+    } else {
+        h = seed + P5;
+    }
+    h += (uint64_t)len;
+    for (; i + 8 <= len; i += 8) h = rotl64(h ^ (rotl64(read64(p + i) * P2, 31) * P1), 27) * P1 + P4;
+    if (i + 4 <= len) {
+        h = rotl64(h ^ (read32(p + i) * P1), 23) * P2 + P3;
+        i += 4;
+    }
+    for (; i < len; i++) h = rotl64(h ^ (p[i] * P5), 11) * P1;
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+struct Message {
+    std::vector<uint8_t> data;
+    uint64_t seed;
+};
+
+template <int WB>
+void pushMessages(const std::vector<Message>& msgs,
+                  hls::stream<ap_uint<8 * WB> >& inStrm,
+                  hls::stream<ap_uint<32> >& inLenStrm,
+                  hls::stream<bool>& endInStrm) {
+    for (unsigned int m = 0; m < msgs.size(); m++) {
+        const std::vector<uint8_t>& d = msgs[m].data;
+        for (size_t i = 0; i < d.size(); i += WB) {
+            ap_uint<8 * WB> w = 0;
+            for (int b = 0; b < WB && i + b < d.size(); b++) w.range(8 * b + 7, 8 * b) = d[i + b];
+            inStrm << w;
+        }
+        inLenStrm << (uint32_t)d.size();
+        endInStrm << false;
+    }
+    endInStrm << true;
+}
+
+// Runs the kernels at any word width, and through the top at W
+template <int WB>
+struct Hasher {
+    static void run(hls::stream<ap_uint<32> >& seed32Strm,
+                    hls::stream<ap_uint<8 * WB> >& in32Strm,
+                    hls::stream<ap_uint<32> >& inLen32Strm,
+                    hls::stream<bool>& endIn32Strm,
+                    hls::stream<ap_uint<32> >& out32Strm,
+                    hls::stream<bool>& endOut32Strm,
+                    hls::stream<ap_uint<64> >& seed64Strm,
+                    hls::stream<ap_uint<8 * WB> >& in64Strm,
+                    hls::stream<ap_uint<32> >& inLen64Strm,
+                    hls::stream<bool>& endIn64Strm,
+                    hls::stream<ap_uint<64> >& out64Strm,
+                    hls::stream<bool>& endOut64Strm) {
+        xf::compression::xxhash32<WB>(seed32Strm, in32Strm, inLen32Strm, endIn32Strm, out32Strm, endOut32Strm);
+        xf::compression::xxhash64<WB>(seed64Strm, in64Strm, inLen64Strm, endIn64Strm, out64Strm, endOut64Strm);
+    }
+};
+
+template <>
+struct Hasher<W> {
+    static void run(hls::stream<ap_uint<32> >& seed32Strm,
+                    hls::stream<ap_uint<8 * W> >& in32Strm,
+                    hls::stream<ap_uint<32> >& inLen32Strm,
+                    hls::stream<bool>& endIn32Strm,
+                    hls::stream<ap_uint<32> >& out32Strm,
+                    hls::stream<bool>& endOut32Strm,
+                    hls::stream<ap_uint<64> >& seed64Strm,
+                    hls::stream<ap_uint<8 * W> >& in64Strm,
+                    hls::stream<ap_uint<32> >& inLen64Strm,
+                    hls::stream<bool>& endIn64Strm,
+                    hls::stream<ap_uint<64> >& out64Strm,
+                    hls::stream<bool>& endOut64Strm) {
+        xxhashRun(seed32Strm, in32Strm, inLen32Strm, endIn32Strm, out32Strm, endOut32Strm, seed64Strm, in64Strm,
+                  inLen64Strm, endIn64Strm, out64Strm, endOut64Strm);
+    }
+};
+
+// Hashes all messages with xxhash32<WB> and xxhash64<WB> and compares with the reference, returns the error count
+template <int WB>
+int checkWidth(const std::vector<Message>& msgs) {
+    hls::stream<ap_uint<32> > seed32Strm, out32Strm, inLen32Strm, inLen64Strm;
+    hls::stream<ap_uint<64> > seed64Strm, out64Strm;
+    hls::stream<ap_uint<8 * WB> > in32Strm, in64Strm;
+    hls::stream<bool> endIn32Strm, endOut32Strm, endIn64Strm, endOut64Strm;
+
+    for (unsigned int m = 0; m < msgs.size(); m++) {
+        seed32Strm << (uint32_t)msgs[m].seed;
+        seed64Strm << msgs[m].seed;
+    }
+    pushMessages<WB>(msgs, in32Strm, inLen32Strm, endIn32Strm);
+    pushMessages<WB>(msgs, in64Strm, inLen64Strm, endIn64Strm);
+
+    Hasher<WB>::run(seed32Strm, in32Strm, inLen32Strm, endIn32Strm, out32Strm, endOut32Strm, seed64Strm, in64Strm,
+                    inLen64Strm, endIn64Strm, out64Strm, endOut64Strm);
+
+    int errCnt = 0;
+    for (unsigned int m = 0; m < msgs.size(); m++) {
+        const Message& msg = msgs[m];
+        uint32_t h32 = out32Strm.read();
+        uint64_t h64 = out64Strm.read();
+        if (endOut32Strm.read() || endOut64Strm.read()) errCnt++;
+        if (h32 != refXxh32(msg.data.data(), msg.data.size(), (uint32_t)msg.seed) ||
+            h64 != refXxh64(msg.data.data(), msg.data.size(), msg.seed)) {
+            if (errCnt < 8)
+                std::cout << "W = " << WB << ", length " << msg.data.size() << ", seed 0x" << std::hex << msg.seed
+                          << ": 0x" << h32 << " / 0x" << h64 << std::dec << std::endl;
+            errCnt++;
+        }
+    }
+    if (!endOut32Strm.read() || !endOut64Strm.read()) errCnt++;
+    if (!in32Strm.empty() || !in64Strm.empty() || !out32Strm.empty() || !out64Strm.empty()) errCnt++;
+    std::cout << "W = " << WB << ": " << msgs.size() << " messages" << (errCnt ? " FAILED" : " OK") << std::endl;
+    return errCnt;
+}
+
+int main(int argc, char* argv[]) {
+    std::ifstream inputFile;
+
+    // Input file open for input_size
+    inputFile.open(argv[1], std::ofstream::binary | std::ofstream::in);
+    if (!inputFile.is_open()) {
+        std::cout << "Cannot open the input file!!" << std::endl;
+        exit(0);
+    }
+    std::vector<uint8_t> sample((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+    inputFile.close();
+
+    int errCnt = 0;
+
+    // Known answers of the reference: empty and short inputs, the xxhash documentation example,
+    // and sample.txt, whose XXH32 is the content checksum the lz4 utility writes for it
+    const std::string doc = "Nobody inspects the spammish repetition";
+    const uint8_t* docp = (const uint8_t*)doc.data();
+    if (refXxh32(0, 0, 0) != 0x02CC5D05U || refXxh64(0, 0, 0) != 0xEF46DB3751D8E999ULL ||
+        refXxh32((const uint8_t*)"abc", 3, 0) != 0x32D153FFU ||
+        refXxh64((const uint8_t*)"abc", 3, 0) != 0x44BC2CF5AD770999ULL || refXxh32(docp, doc.size(), 0) != 0xE2293B2FU ||
+        refXxh64(docp, doc.size(), 0) != 0xFBCEA83C8A378BF1ULL ||
+        refXxh32(sample.data(), sample.size(), 0) != 0xA746EF41U) {
+        std::cout << "Reference xxHash does not match the known answers" << std::endl;
+        errCnt++;
+    }
+
+    // Every length up to a few stripes of the widest word, sample.txt, and seeds exercising the upper bits
+    std::vector<Message> msgs;
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (unsigned int len = 0; len <= 300; len++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        Message m;
+        m.seed = (len % 3 == 0) ? 0 : x;
+        for (unsigned int i = 0; i < len; i++) m.data.push_back(sample[(i * 7 + len) % sample.size()]);
+        msgs.push_back(m);
+    }
+    Message whole = {sample, 0};
+    msgs.push_back(whole);
+
+    errCnt += checkWidth<4>(msgs);
+    errCnt += checkWidth<8>(msgs);
+    errCnt += checkWidth<16>(msgs);
+    errCnt += checkWidth<32>(msgs);
+    errCnt += checkWidth<64>(msgs);
+
+    std::cout << (errCnt ? "TEST FAILED" : "TEST PASSED") << std::endl;
+    return errCnt;
+}
@@ -0,0 +1,282 @@
+/*
+ * (c) Copyright 2019-2022 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "lz4SWHost.hpp"
+#include "lz4_compress.hpp"
+#include "lz4_decompress.hpp"
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+using namespace xf::compression;
+
+// Parallel bytes of the software decompress engine
+constexpr auto c_swParallelBytes = 8;
+// Blocks smaller than this are stored, as in the compress kernel
+constexpr auto c_swMinBlockSize = 128;
+
+// Compress one block with the L1 LZ4 core, returns input_size when the block is to be stored
+static uint32_t lz4SWCompressBlock(const uint8_t* in, uint8_t* out, uint32_t input_size) {
+    if (input_size < c_swMinBlockSize) return input_size;
+
+    hls::stream<ap_uint<8> > inStream("inStream");
+    hls::stream<ap_uint<8> > outStream("outStream");
+    hls::stream<bool> outStreamEos("outStreamEos");
+    hls::stream<uint32_t> compressedSize("compressedSize");
+    uint32_t max_lit_limit[1] = {0};
+
+    for (uint32_t i = 0; i < input_size; i++) inStream << in[i];
+    hlsLz4Core<ap_uint<8>, 512, 16, 1>(inStream, outStream, outStreamEos, compressedSize, max_lit_limit, input_size,
+                                       0);
+
+    // Compressed data may grow past the block size, only copy it when it is smaller
+    uint32_t outIdx = 0;
+    for (bool eos = outStreamEos.read(); !eos; eos = outStreamEos.read()) {
+        uint8_t val = outStream.read();
+        if (outIdx < input_size) out[outIdx] = val;
+        outIdx++;
+    }
+    outStream.read();
+    uint32_t compressed_size = compressedSize.read();
+
+    if (max_lit_limit[0] || compressed_size >= input_size) return input_size;
+    return compressed_size;
+}
+
+// Decompress one compressed block with the L1 LZ4 core, returns the decompressed size
+static uint32_t lz4SWDecompressBlock(const uint8_t* in, uint8_t* out, uint32_t input_size, uint32_t max_size) {
+    const int c_parallelBit = c_swParallelBytes * 8;
+    hls::stream<ap_uint<c_parallelBit> > inStream("inStream");
+    hls::stream<ap_uint<c_parallelBit + c_swParallelBytes> > outStream("outStream");
+    hls::stream<uint32_t> blockSizeStream("blockSizeStream");
+
+    for (uint32_t i = 0; i < input_size; i += c_swParallelBytes) {
+        ap_uint<c_parallelBit> val = 0;
+        for (uint32_t j = 0; j < c_swParallelBytes && i + j < input_size; j++) val.range(j * 8 + 7, j * 8) = in[i + j];
+        inStream << val;
+    }
+    blockSizeStream << input_size;
+    blockSizeStream << 0;
+    lz4CoreDecompressEngine<c_swParallelBytes, 64 * 1024>(inStream, outStream, blockSizeStream);
+
+    uint32_t outIdx = 0;
+    for (ap_uint<c_parallelBit + c_swParallelBytes> val = outStream.read(); val.range(c_swParallelBytes - 1, 0) != 0;
+         val = outStream.read()) {
+        for (uint32_t j = 0; j < c_swParallelBytes; j++) {
+            if (val.range(j, j) == 0) continue;
+            if (outIdx < max_size) out[outIdx] = val.range(c_swParallelBytes + j * 8 + 7, c_swParallelBytes + j * 8);
+            outIdx++;
+        }
+    }
+    return outIdx;
+}
+
+// Constructor
+lz4SWHost::lz4SWHost(uint32_t block_size_kb, uint32_t num_threads) {
+    m_addContentSize = false;
+    m_BlockSizeInKb = block_size_kb;
+    m_numThreads = num_threads ? num_threads : std::thread::hardware_concurrency();
+    if (m_numThreads == 0) m_numThreads = 1;
+}
+
+void lz4SWHost::runBlocks(uint32_t nblocks, const std::function<void(uint32_t)>& task) {
+    std::atomic<uint32_t> nextBlock(0);
+    auto worker = [&]() {
+        for (uint32_t bIdx = nextBlock++; bIdx < nblocks; bIdx = nextBlock++) task(bIdx);
+    };
+    uint32_t nthreads = (nblocks < m_numThreads) ? nblocks : m_numThreads;
+    std::vector<std::thread> pool;
+    for (uint32_t i = 1; i < nthreads; i++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+}
+
+// Compress driving API includes header processing and calling core compress engine
+uint64_t lz4SWHost::xilCompress(uint8_t* in, uint8_t* out, size_t input_size) {
+    m_InputSize = input_size;
+    m_frameByteCount = 0;
+
+    // LZ4 header
+    out += writeHeader(out);
+
+    // For end to end compression throughput
+    if (m_enableProfile) {
+        total_start = std::chrono::high_resolution_clock::now();
+    }
+    uint64_t enbytes = compressEngineSeq(in, out, m_InputSize);
+
+    // E2E compression throughput
+    if (m_enableProfile) {
+        total_end = std::chrono::high_resolution_clock::now();
+        auto total_time_ns = std::chrono::duration<double, std::nano>(total_end - total_start);
+        float throughput_in_mbps_1 = (float)input_size * 1000 / total_time_ns.count();
+        std::cout << std::fixed << std::setprecision(2) << throughput_in_mbps_1;
+    }
+    // lz4 frame formatting
+    out = out + enbytes;
+    writeFooter(in, out);
+    enbytes += m_frameByteCount;
+    return enbytes;
+}
+
+// Decompress driving API for calling core decompress engine
+uint64_t lz4SWHost::xilDecompress(uint8_t* in, uint8_t* out, size_t input_size) {
+    in += readHeader(in);
+    m_InputSize = input_size - 15;
+
+    // For end to end decompression throughput
+    if (m_enableProfile) {
+        total_start = std::chrono::high_resolution_clock::now();
+    }
+    uint64_t debytes = decompressEngineSeq(in, out, m_InputSize);
+
+    // For E2E decompression throughput
+    if (m_enableProfile) {
+        total_end = std::chrono::high_resolution_clock::now();
+        auto total_time_ns = std::chrono::duration<double, std::nano>(total_end - total_start);
+        float throughput_in_mbps_1 = (float)input_size * 1000 / total_time_ns.count();
+        std::cout << std::fixed << std::setprecision(2) << throughput_in_mbps_1;
+    }
+    return debytes;
+}
+
+// Core Compress Engine API
+uint64_t lz4SWHost::compressEngineSeq(uint8_t* in, uint8_t* out, size_t input_size) {
+    uint32_t host_buffer_size = m_HostBufferSize;
+    uint32_t block_size_in_bytes = m_BlockSizeInKb * 1024;
+    uint32_t max_num_blks = host_buffer_size / block_size_in_bytes;
+    h_buf_out.resize(host_buffer_size);
+    h_compressSize.resize(max_num_blks);
+
+    std::chrono::duration<double, std::nano> kernel_time_ns_1(0);
+
+    // Keeps track of output buffer index
+    uint64_t outIdx = 0;
+
+    // Input is processed in host buffer sized chunks, the blocks of a chunk
+    // are compressed in parallel in place of one kernel invocation
+    for (uint64_t inIdx = 0; inIdx < input_size; inIdx += host_buffer_size) {
+        uint32_t hostChunk_cu = host_buffer_size;
+        if (inIdx + host_buffer_size > input_size) hostChunk_cu = input_size - inIdx;
+        uint32_t nblocks = (hostChunk_cu - 1) / block_size_in_bytes + 1;
+
+        if (!m_enableProfile) {
+            kernel_start = std::chrono::high_resolution_clock::now();
+        }
+        runBlocks(nblocks, [&](uint32_t bIdx) {
+            uint32_t bs = bIdx * block_size_in_bytes;
+            uint32_t block_size = block_size_in_bytes;
+            if (bs + block_size > hostChunk_cu) block_size = hostChunk_cu - bs;
+            h_compressSize[bIdx] = lz4SWCompressBlock(&in[inIdx + bs], &h_buf_out[bs], block_size);
+        });
+        if (!m_enableProfile) {
+            kernel_end = std::chrono::high_resolution_clock::now();
+            kernel_time_ns_1 += std::chrono::duration<double, std::nano>(kernel_end - kernel_start);
+        }
+
+        // Stored blocks report their input size and are copied from the input
+        writeCompressedBlock<uint8_t>(hostChunk_cu, block_size_in_bytes, h_compressSize.data(), out, in,
+                                      h_buf_out.data(), outIdx, inIdx);
+    }
+    if (!m_enableProfile) {
+        float throughput_in_mbps_1 = (float)input_size * 1000 / kernel_time_ns_1.count();
+        std::cout << std::fixed << std::setprecision(2) << throughput_in_mbps_1;
+    }
+    return outIdx;
+} // End of compress
+
+// Core Decompress Engine API
+uint64_t lz4SWHost::decompressEngineSeq(uint8_t* in, uint8_t* out, size_t input_size) {
+    uint32_t block_size_in_bytes = m_BlockSizeInKb * 1024;
+    uint32_t max_num_blks = HOST_BUFFER_SIZE / block_size_in_bytes;
+    if (max_num_blks == 0) max_num_blks = 1;
+    h_buf_out.resize((uint64_t)max_num_blks * block_size_in_bytes);
+    h_compressSize.resize(max_num_blks);
+    h_decSize.resize(max_num_blks);
+    std::vector<uint64_t> blkOffset(max_num_blks);
+
+    // Maximum allowed outbuffer size, if it exceeds then exit
+    uint64_t c_max_outbuf = input_size * m_maxCR;
+
+    std::chrono::duration<double, std::nano> kernel_time_ns_1(0);
+    uint64_t inIdx = 0;
+    uint64_t output_idx = 0;
+
+    while (inIdx < input_size) {
+        // Collect up to a host buffer worth of blocks
+        uint32_t nblocks = 0;
+        for (; nblocks < max_num_blks && inIdx < input_size; nblocks++) {
+            uint32_t compressed_size = 0;
+            std::memcpy(&compressed_size, &in[inIdx], 4);
+            inIdx += 4;
+            // End mark
+            if (compressed_size == 0) {
+                inIdx = input_size;
+                break;
+            }
+            h_compressSize[nblocks] = compressed_size;
+            blkOffset[nblocks] = inIdx;
+            inIdx += compressed_size & ~(1u << 31);
+        }
+
+        if (!m_enableProfile) {
+            kernel_start = std::chrono::high_resolution_clock::now();
+        }
+        runBlocks(nblocks, [&](uint32_t bIdx) {
+            uint32_t compressed_size = h_compressSize[bIdx];
+            uint8_t* blk_out = &h_buf_out[(uint64_t)bIdx * block_size_in_bytes];
+            if (compressed_size >> 31) {
+                // No Compression, so copy raw data
+                compressed_size &= ~(1u << 31);
+                if (compressed_size > block_size_in_bytes) compressed_size = block_size_in_bytes;
+                std::memcpy(blk_out, &in[blkOffset[bIdx]], compressed_size);
+                h_decSize[bIdx] = compressed_size;
+            } else {
+                h_decSize[bIdx] =
+                    lz4SWDecompressBlock(&in[blkOffset[bIdx]], blk_out, compressed_size, block_size_in_bytes);
+            }
+        });
+        if (!m_enableProfile) {
+            kernel_end = std::chrono::high_resolution_clock::now();
+            kernel_time_ns_1 += std::chrono::duration<double, std::nano>(kernel_end - kernel_start);
+        }
+
+        for (uint32_t bIdx = 0; bIdx < nblocks; bIdx++) {
+            uint32_t block_size = h_decSize[bIdx];
+            if (block_size > block_size_in_bytes) {
+                std::cerr << "Decompressed block exceeds the frame block size" << std::endl;
+                exit(1);
+            }
+            if ((output_idx + block_size) > c_max_outbuf) {
+                std::cout << "\n" << std::endl;
+                std::cout << "\x1B[35mZIP BOMB: Exceeded output buffer size during decompression \033[0m \n"
+                          << std::endl;
+                std::cout
+                    << "\x1B[35mUse -mcr option to increase the maximum compression ratio (Default: 10) \033[0m \n"
+                    << std::endl;
+                std::cout << "\x1B[35mAborting .... \033[0m\n" << std::endl;
+                exit(1);
+            }
+            std::memcpy(&out[output_idx], &h_buf_out[(uint64_t)bIdx * block_size_in_bytes], block_size);
+            output_idx += block_size;
+        }
+    }
+    if (!m_enableProfile) {
+        float throughput_in_mbps_1 = (float)output_idx * 1000 / kernel_time_ns_1.count();
+        std::cout << std::fixed << std::setprecision(2) << throughput_in_mbps_1;
+    }
+    return output_idx;
+} // End of decompress
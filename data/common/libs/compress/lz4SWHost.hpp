@@ -0,0 +1,109 @@
+/*
+ * (c) Copyright 2019-2022 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * @file lz4SWHost.hpp
+ * @brief Header for LZ4 software (no device) functionality
+ *
+ * This file is part of Vitis Data Compression Library host code for lz4 compression.
+ */
+
+#ifndef _XFCOMPRESSION_LZ4_SW_HOST_HPP_
+#define _XFCOMPRESSION_LZ4_SW_HOST_HPP_
+
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "compressBase.hpp"
+#include "lz4Base.hpp"
+
+/**
+ *  lz4SWHost class. Runs the L1 LZ4 compress/decompress engines as plain C++
+ * on a pool of host threads, one block per task, in place of the device
+ * kernels. Frame formatting and buffering are shared with lz4OCLHost, so the
+ * host side of the pipeline can be profiled and tested without a card.
+ */
+class lz4SWHost : public lz4Base {
+   public:
+    /**
+     * @brief Xilinx Compress
+     *
+     * @param in input byte sequence
+     * @param out output byte sequence
+     * @param actual_size input size
+     */
+
+    uint64_t xilCompress(uint8_t* in, uint8_t* out, size_t input_size) override;
+
+    /**
+     * @brief Xilinx Decompress
+     *
+     * @param in input byte sequence
+     * @param out output byte sequence
+     * @param compressed size
+     */
+
+    uint64_t xilDecompress(uint8_t* in, uint8_t* out, size_t input_size) override;
+
+    /**
+     * @brief Initialize the software engine
+     *
+     * @param block_size_kb LZ4 block size in KB
+     * @param num_threads worker threads, 0 uses all hardware threads
+     */
+    lz4SWHost(uint32_t block_size_kb, uint32_t num_threads = 0);
+
+    /**
+     * @brief Compress sequential
+     *
+     * @param in input byte sequence
+     * @param out output byte sequence
+     * @param actual_size input size
+     */
+    uint64_t compressEngineSeq(uint8_t* in, uint8_t* out, size_t input_size);
+
+    /**
+     * @brief Decompress sequential.
+     *
+     * @param in input byte sequence
+     * @param out output byte sequence
+     * @param actual_size input size
+     */
+    uint64_t decompressEngineSeq(uint8_t* in, uint8_t* out, size_t input_size);
+
+   private:
+    /**
+     * @brief Run task(0) .. task(nblocks - 1) on the worker threads and wait
+     *
+     * @param nblocks number of tasks
+     * @param task per block work
+     */
+    void runBlocks(uint32_t nblocks, const std::function<void(uint32_t)>& task);
+
+    uint32_t m_numThreads;
+
+    std::chrono::system_clock::time_point kernel_start;
+    std::chrono::system_clock::time_point kernel_end;
+    std::chrono::system_clock::time_point total_start;
+    std::chrono::system_clock::time_point total_end;
+
+    // Per chunk staging, same layout as the device buffers
+    std::vector<uint8_t> h_buf_out;
+    std::vector<uint32_t> h_compressSize;
+    std::vector<uint32_t> h_decSize;
+};
+
+#endif // _XFCOMPRESSION_LZ4_SW_HOST_HPP_
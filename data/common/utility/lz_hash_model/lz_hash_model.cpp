@@ -0,0 +1,174 @@
+/*
+ * (c) Copyright 2019-2022 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Host-side model for choosing the lzCompress hash policy and dictionary geometry.
+//
+// Every configuration runs the C model of the LZ4 L1 pipeline
+// (lzCompress -> lzBestMatchFilter -> lzBooster -> lz4Compress) over the corpus in 64 KB blocks,
+// and reports the compression ratio with an estimate of the BRAM18 blocks used by the dictionary.
+//
+// Build and run on the sample corpus:
+//   make run
+// or by hand:
+//   g++ -std=c++14 -O2 -I$XILINX_HLS/include -I../../../L1/include/hw lz_hash_model.cpp -o lz_hash_model
+//   ./lz_hash_model <corpus file> [<corpus file> ...]
+
+#include "hls_stream.h"
+#include <ap_int.h>
+#include <stdint.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lz4_compress.hpp"
+#include "lz_compress.hpp"
+#include "lz_optional.hpp"
+
+namespace {
+
+const int c_blockSize = 64 * 1024;
+const int c_matchLen = 6;
+const int c_minMatch = 4;
+const int c_minOffset = 1;
+const int c_leftBytes = 64;
+const int c_maxLitCount = 4096;
+const int c_maxMatchLen = 255;
+const int c_maxOffsetLimit = 65536;
+
+struct ModelResult {
+    uint64_t inBytes;
+    uint64_t outBytes;
+};
+
+// BRAM18 blocks for a simple dual-port RAM of depth x width, using the best aspect ratio
+int bram18Count(int depth, int width) {
+    const int c_depth[] = {512, 1024, 2048, 4096, 8192, 16384};
+    const int c_width[] = {36, 18, 9, 4, 2, 1};
+    int best = -1;
+    for (int i = 0; i < 6; ++i) {
+        int n = ((depth + c_depth[i] - 1) / c_depth[i]) * ((width + c_width[i] - 1) / c_width[i]);
+        if (best < 0 || n < best) best = n;
+    }
+    return best;
+}
+
+// Compress one block with the given lzCompress configuration, return the LZ4 block size
+template <class HASH, int DICT_SIZE, int MATCH_LEVEL>
+uint32_t compressBlock(const uint8_t* in, uint32_t size) {
+    hls::stream<ap_uint<8> > inStream("inStream");
+    hls::stream<ap_uint<32> > compressdStream("compressdStream");
+    hls::stream<ap_uint<32> > bestMatchStream("bestMatchStream");
+    hls::stream<ap_uint<32> > boosterStream("boosterStream");
+    hls::stream<ap_uint<8> > lz4Out("lz4Out");
+    hls::stream<bool> lz4OutEos("lz4OutEos");
+    hls::stream<uint32_t> lz4OutSize("lz4OutSize");
+    uint32_t maxLitLimit[1];
+
+    for (uint32_t i = 0; i < size; ++i) inStream << in[i];
+
+    xf::compression::lzCompress<c_matchLen, c_minMatch, c_maxOffsetLimit, MATCH_LEVEL, c_minOffset, DICT_SIZE,
+                                c_leftBytes, HASH>(inStream, compressdStream, size);
+    xf::compression::lzBestMatchFilter<c_matchLen, c_blockSize>(compressdStream, bestMatchStream, size);
+    xf::compression::lzBooster<c_maxMatchLen>(bestMatchStream, boosterStream, size);
+    xf::compression::lz4Compress<c_maxLitCount, 1>(boosterStream, lz4Out, maxLitLimit, size, lz4OutEos,
+                                                   lz4OutSize, 0);
+
+    // lz4Compress writes the size once per block, after the last byte; drain by eos
+    uint32_t outSize = 0;
+    for (bool eos = lz4OutEos.read(); !eos; eos = lz4OutEos.read()) {
+        lz4Out.read();
+        ++outSize;
+    }
+    lz4Out.read();
+    uint32_t compressedSize = lz4OutSize.read();
+    if (compressedSize != outSize)
+        std::cerr << "lz4Compress reported " << compressedSize << " bytes, streamed " << outSize << std::endl;
+    return outSize;
+}
+
+template <class HASH, int DICT_SIZE, int MATCH_LEVEL>
+void runConfig(const std::string& hashName, const std::vector<std::vector<uint8_t> >& corpus) {
+    ModelResult res = {0, 0};
+    for (size_t f = 0; f < corpus.size(); ++f) {
+        const std::vector<uint8_t>& data = corpus[f];
+        for (size_t off = 0; off < data.size(); off += c_blockSize) {
+            uint32_t size = (uint32_t)std::min<size_t>(c_blockSize, data.size() - off);
+            res.inBytes += size;
+            // too short for the match pipeline, stored as literals
+            if (size <= (uint32_t)(c_leftBytes + c_matchLen)) {
+                res.outBytes += size;
+                continue;
+            }
+            uint32_t outSize = compressBlock<HASH, DICT_SIZE, MATCH_LEVEL>(data.data() + off, size);
+            // incompressible blocks are stored as is
+            res.outBytes += std::min(outSize, size);
+        }
+    }
+
+    const int c_eleW = c_matchLen * 8 + 24;
+    int dictBram = bram18Count(DICT_SIZE, MATCH_LEVEL * c_eleW);
+    int epvBram = bram18Count(DICT_SIZE, MATCH_LEVEL);
+    double ratio = res.outBytes ? (double)res.inBytes / res.outBytes : 0.0;
+
+    std::cout << std::left << std::setw(12) << hashName << std::right << std::setw(8) << DICT_SIZE << std::setw(7)
+              << MATCH_LEVEL << std::setw(10) << std::fixed << std::setprecision(3) << ratio << std::setw(9)
+              << (dictBram + epvBram) << std::endl;
+}
+
+template <class HASH>
+void runHash(const std::string& hashName, const std::vector<std::vector<uint8_t> >& corpus) {
+    runConfig<HASH, 1 << 12, 2>(hashName, corpus);
+    runConfig<HASH, 1 << 12, 4>(hashName, corpus);
+    runConfig<HASH, 1 << 12, 6>(hashName, corpus);
+    runConfig<HASH, 1 << 13, 2>(hashName, corpus);
+    runConfig<HASH, 1 << 13, 4>(hashName, corpus);
+    runConfig<HASH, 1 << 13, 6>(hashName, corpus);
+    runConfig<HASH, 1 << 14, 2>(hashName, corpus);
+    runConfig<HASH, 1 << 14, 4>(hashName, corpus);
+    runConfig<HASH, 1 << 14, 6>(hashName, corpus);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <corpus file> [<corpus file> ...]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t> > corpus;
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream inFile(argv[i], std::ifstream::binary);
+        if (!inFile.is_open()) {
+            std::cout << "Cannot open the input file: " << argv[i] << std::endl;
+            return 1;
+        }
+        corpus.push_back(
+            std::vector<uint8_t>((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>()));
+    }
+
+    std::cout << std::left << std::setw(12) << "hash" << std::right << std::setw(8) << "dict" << std::setw(7)
+              << "ways" << std::setw(10) << "ratio" << std::setw(9) << "BRAM18" << std::endl;
+
+    runHash<xf::compression::lzShiftXorHash>("shift-xor", corpus);
+    runHash<xf::compression::lzFibonacciHash>("fibonacci", corpus);
+    runHash<xf::compression::lzLz4Hash>("lz4", corpus);
+    runHash<xf::compression::lzCrcHash>("crc32c", corpus);
+    return 0;
+}
@@ -29,6 +29,7 @@
 #include <ap_int.h>
 #include <hls_stream.h>
 #include <xf_security/types.hpp>
+#include "xf_security/sha224_256.hpp"
 
 #if !defined(__SYNTHESIS__) && XF_SECURITY_DECRYPT_DEBUG == 1
 #include <iostream>
@@ -293,6 +294,226 @@ void hmacDataflow(hls::stream<ap_uint<dataW> >& keyStrm,
     resHash<dataW, lW, hshW, keyLen, blockSize, F>(kopad2Strm, msgHashStrm, eMsgHashStrm, hshStrm, eHshStrm);
 }
 
+template <int msgW, int lW, int hshW>
+struct sha256Wrapper {
+    static void hash(hls::stream<ap_uint<msgW> >& msgStrm,
+                     hls::stream<ap_uint<64> >& lenStrm,
+                     hls::stream<bool>& eLenStrm,
+                     hls::stream<ap_uint<256> >& hshStrm,
+                     hls::stream<bool>& eHshStrm) {
+        xf::security::sha256<msgW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+
+template <int dataW>
+void kpadToBlock(hls::stream<ap_uint<512> >& kipadStrm,
+                 hls::stream<ap_uint<512> >& kopadStrm,
+                 hls::stream<bool>& eKipadStrm,
+                 hls::stream<ap_uint<dataW> >& padStrm,
+                 hls::stream<ap_uint<64> >& padLenStrm,
+                 hls::stream<bool>& ePadLenStrm,
+                 hls::stream<ap_uint<320> >& initStateStrm) {
+    // SHA-256 IV with zero bytes hashed, both pads are hashed from here
+    ap_uint<320> iv = 0;
+    iv.range(31, 0) = 0x6a09e667U;
+    iv.range(63, 32) = 0xbb67ae85U;
+    iv.range(95, 64) = 0x3c6ef372U;
+    iv.range(127, 96) = 0xa54ff53aU;
+    iv.range(159, 128) = 0x510e527fU;
+    iv.range(191, 160) = 0x9b05688cU;
+    iv.range(223, 192) = 0x1f83d9abU;
+    iv.range(255, 224) = 0x5be0cd19U;
+
+    while (!eKipadStrm.read()) {
+        ap_uint<512> kpad[2];
+        kpad[0] = kipadStrm.read();
+        kpad[1] = kopadStrm.read();
+        for (int p = 0; p < 2; p++) {
+            ePadLenStrm.write(false);
+            padLenStrm.write(64);
+            initStateStrm.write(iv);
+            ap_uint<512> pad = kpad[p];
+            for (int i = 0; i < 512 / dataW; i++) {
+#pragma HLS pipeline II = 1
+                padStrm.write(pad.range(511, 512 - dataW));
+                pad <<= dataW;
+            }
+        }
+    }
+    ePadLenStrm.write(true);
+}
+
+template <int keyNum>
+void storeKeyState(hls::stream<ap_uint<16> >& keyIdStrm,
+                   hls::stream<ap_uint<320> >& stateStrm,
+                   hls::stream<bool>& eStateStrm,
+                   ap_uint<512> keyState[keyNum]) {
+    while (!eStateStrm.read()) {
+        ap_uint<320> ipadState = stateStrm.read();
+        eStateStrm.read();
+        ap_uint<320> opadState = stateStrm.read();
+        ap_uint<16> id = keyIdStrm.read();
+        XF_SECURITY_ASSERT(id < keyNum);
+        ap_uint<512> st;
+        st.range(255, 0) = ipadState.range(255, 0);
+        st.range(511, 256) = opadState.range(255, 0);
+        keyState[id] = st;
+    }
+}
+
+template <int dataW, int keyLen, int keyNum>
+void hmacSha256SetKeyDataflow(hls::stream<ap_uint<dataW> >& keyStrm,
+                              hls::stream<ap_uint<16> >& keyIdStrm,
+                              hls::stream<bool>& eKeyStrm,
+                              ap_uint<512> keyState[keyNum]) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<512> > kipadStrm;
+#pragma HLS stream variable = kipadStrm depth = 4
+#pragma HLS resource variable = kipadStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<512> > kopadStrm;
+#pragma HLS stream variable = kopadStrm depth = 4
+#pragma HLS resource variable = kopadStrm core = FIFO_LUTRAM
+    hls::stream<bool> eKipadStrm;
+#pragma HLS stream variable = eKipadStrm depth = 4
+#pragma HLS resource variable = eKipadStrm core = FIFO_LUTRAM
+
+    hls::stream<ap_uint<dataW> > padStrm;
+#pragma HLS stream variable = padStrm depth = 32
+#pragma HLS resource variable = padStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<64> > padLenStrm;
+#pragma HLS stream variable = padLenStrm depth = 4
+#pragma HLS resource variable = padLenStrm core = FIFO_LUTRAM
+    hls::stream<bool> ePadLenStrm;
+#pragma HLS stream variable = ePadLenStrm depth = 4
+#pragma HLS resource variable = ePadLenStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<320> > initStateStrm;
+#pragma HLS stream variable = initStateStrm depth = 4
+#pragma HLS resource variable = initStateStrm core = FIFO_LUTRAM
+
+    hls::stream<ap_uint<320> > stateStrm;
+#pragma HLS stream variable = stateStrm depth = 4
+#pragma HLS resource variable = stateStrm core = FIFO_LUTRAM
+    hls::stream<bool> eStateStrm;
+#pragma HLS stream variable = eStateStrm depth = 4
+#pragma HLS resource variable = eStateStrm core = FIFO_LUTRAM
+
+    kpad<dataW, 64, 256, keyLen, 64, sha256Wrapper>(keyStrm, eKeyStrm, kipadStrm, kopadStrm, eKipadStrm);
+
+    kpadToBlock<dataW>(kipadStrm, kopadStrm, eKipadStrm, padStrm, padLenStrm, ePadLenStrm, initStateStrm);
+
+    sha256_state_top<dataW, 1>(padStrm, padLenStrm, ePadLenStrm, initStateStrm, stateStrm, eStateStrm);
+
+    storeKeyState<keyNum>(keyIdStrm, stateStrm, eStateStrm, keyState);
+}
+
+template <int lW, int keyNum>
+void innerCtl(const ap_uint<512> keyState[keyNum],
+              hls::stream<ap_uint<lW> >& msgLenStrm,
+              hls::stream<ap_uint<16> >& keyIdStrm,
+              hls::stream<bool>& eLenStrm,
+              hls::stream<ap_uint<64> >& innerLenStrm,
+              hls::stream<bool>& eInnerLenStrm,
+              hls::stream<ap_uint<320> >& innerStateStrm,
+              hls::stream<ap_uint<256> >& opadStateStrm) {
+    while (!eLenStrm.read()) {
+#pragma HLS pipeline II = 1
+        ap_uint<16> id = keyIdStrm.read();
+        XF_SECURITY_ASSERT(id < keyNum);
+        ap_uint<512> st = keyState[id];
+        // resume after the 64-byte K^ipad block
+        ap_uint<320> ipadState;
+        ipadState.range(255, 0) = st.range(255, 0);
+        ipadState.range(319, 256) = 64;
+
+        innerLenStrm.write(ap_uint<64>(msgLenStrm.read()));
+        eInnerLenStrm.write(false);
+        innerStateStrm.write(ipadState);
+        opadStateStrm.write(st.range(511, 256));
+    }
+    eInnerLenStrm.write(true);
+}
+
+template <int dataW>
+void outerCtl(hls::stream<ap_uint<256> >& opadStateStrm,
+              hls::stream<ap_uint<256> >& innerHshStrm,
+              hls::stream<bool>& eInnerHshStrm,
+              hls::stream<ap_uint<dataW> >& outerMsgStrm,
+              hls::stream<ap_uint<64> >& outerLenStrm,
+              hls::stream<bool>& eOuterLenStrm,
+              hls::stream<ap_uint<320> >& outerStateStrm) {
+    while (!eInnerHshStrm.read()) {
+        // resume after the 64-byte K^opad block
+        ap_uint<320> opadState;
+        opadState.range(255, 0) = opadStateStrm.read();
+        opadState.range(319, 256) = 64;
+
+        outerLenStrm.write(32);
+        eOuterLenStrm.write(false);
+        outerStateStrm.write(opadState);
+
+        ap_uint<256> innerHsh = innerHshStrm.read();
+        for (int i = 0; i < 256 / dataW; i++) {
+#pragma HLS pipeline II = 1
+            outerMsgStrm.write(innerHsh.range(dataW - 1, 0));
+            innerHsh >>= dataW;
+        }
+    }
+    eOuterLenStrm.write(true);
+}
+
+template <int dataW, int lW, int keyNum>
+void hmacSha256CachedDataflow(const ap_uint<512> keyState[keyNum],
+                              hls::stream<ap_uint<dataW> >& msgStrm,
+                              hls::stream<ap_uint<lW> >& msgLenStrm,
+                              hls::stream<ap_uint<16> >& keyIdStrm,
+                              hls::stream<bool>& eLenStrm,
+                              hls::stream<ap_uint<256> >& hshStrm,
+                              hls::stream<bool>& eHshStrm) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<64> > innerLenStrm;
+#pragma HLS stream variable = innerLenStrm depth = 4
+#pragma HLS resource variable = innerLenStrm core = FIFO_LUTRAM
+    hls::stream<bool> eInnerLenStrm;
+#pragma HLS stream variable = eInnerLenStrm depth = 4
+#pragma HLS resource variable = eInnerLenStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<320> > innerStateStrm;
+#pragma HLS stream variable = innerStateStrm depth = 4
+#pragma HLS resource variable = innerStateStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<256> > opadStateStrm;
+#pragma HLS stream variable = opadStateStrm depth = 32
+#pragma HLS resource variable = opadStateStrm core = FIFO_LUTRAM
+
+    hls::stream<ap_uint<256> > innerHshStrm;
+#pragma HLS stream variable = innerHshStrm depth = 4
+#pragma HLS resource variable = innerHshStrm core = FIFO_LUTRAM
+    hls::stream<bool> eInnerHshStrm;
+#pragma HLS stream variable = eInnerHshStrm depth = 4
+#pragma HLS resource variable = eInnerHshStrm core = FIFO_LUTRAM
+
+    hls::stream<ap_uint<dataW> > outerMsgStrm;
+#pragma HLS stream variable = outerMsgStrm depth = 16
+#pragma HLS resource variable = outerMsgStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<64> > outerLenStrm;
+#pragma HLS stream variable = outerLenStrm depth = 4
+#pragma HLS resource variable = outerLenStrm core = FIFO_LUTRAM
+    hls::stream<bool> eOuterLenStrm;
+#pragma HLS stream variable = eOuterLenStrm depth = 4
+#pragma HLS resource variable = eOuterLenStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<320> > outerStateStrm;
+#pragma HLS stream variable = outerStateStrm depth = 4
+#pragma HLS resource variable = outerStateStrm core = FIFO_LUTRAM
+
+    innerCtl<lW, keyNum>(keyState, msgLenStrm, keyIdStrm, eLenStrm, innerLenStrm, eInnerLenStrm, innerStateStrm,
+                         opadStateStrm);
+
+    sha256_top<dataW, 256, 1>(msgStrm, innerLenStrm, eInnerLenStrm, innerStateStrm, innerHshStrm, eInnerHshStrm);
+
+    outerCtl<dataW>(opadStateStrm, innerHshStrm, eInnerHshStrm, outerMsgStrm, outerLenStrm, eOuterLenStrm,
+                    outerStateStrm);
+
+    sha256_top<dataW, 256, 1>(outerMsgStrm, outerLenStrm, eOuterLenStrm, outerStateStrm, hshStrm, eHshStrm);
+}
+
 } // end of namespace internal
 
 /**
@@ -346,6 +567,65 @@ void hmac(hls::stream<ap_uint<dataW> >& keyStrm,
     internal::hmacDataflow<dataW, lW, hshW, keyLen, blockSize, F>(keyStrm, msgStrm, msgLenStrm, eLenStrm, hshStrm,
                                                                   eHshStrm);
 }
+
+/**
+ * @brief Install HMAC-SHA256 keys into an on-chip key-state table.
+ *
+ *  For every key, the SHA-256 chaining states after the K^ipad block and after
+ *  the K^opad block are computed once and stored in keyState at the given key ID.
+ *  hmacSha256Cached then resumes from these states, so that each MAC costs two
+ *  compression-function calls less than hmac.
+ *
+ * @tparam dataW the width of input stream keyStrm, 32 or 64.
+ * @tparam keyLen lenght of key (in bytes)
+ * @tparam keyNum number of entries in keyState.
+ *
+ * @param keyStrm input key stream.
+ * @param keyIdStrm the entry of keyState to be written, one per key.
+ * @param eKeyStrm the end flag of key stream, one per key.
+ * @param keyState key-state table, bit [255:0] holds the ipad state and bit [511:256] holds the opad state.
+ *
+ */
+template <int dataW, int keyLen, int keyNum>
+void hmacSha256SetKey(hls::stream<ap_uint<dataW> >& keyStrm,
+                      hls::stream<ap_uint<16> >& keyIdStrm,
+                      hls::stream<bool>& eKeyStrm,
+                      ap_uint<512> keyState[keyNum]) {
+    XF_SECURITY_STATIC_ASSERT((dataW == 32) || (dataW == 64), "dataW must be 32 or 64");
+    internal::hmacSha256SetKeyDataflow<dataW, keyLen, keyNum>(keyStrm, keyIdStrm, eKeyStrm, keyState);
+}
+
+/**
+ * @brief Compute HMAC-SHA256 with keys pre-installed by hmacSha256SetKey.
+ *
+ *  Each message selects its key through keyIdStrm. The inner and the outer hash
+ *  resume from the cached chaining states instead of hashing K^ipad and K^opad.
+ *
+ * @tparam dataW the width of input stream msgStrm, 32 or 64.
+ * @tparam lW the with of input msgLenstrm.
+ * @tparam keyNum number of entries in keyState.
+ *
+ * @param keyState key-state table filled by hmacSha256SetKey.
+ * @param msgStrm input meassge stream.
+ * @param msgLenStrm the length stream of input message stream.
+ * @param keyIdStrm the key ID of each message.
+ * @param eLenStrm the end flag of length stream.
+ * @param hshStrm output stream.
+ * @param eHshStrm end flag of output stream hshStrm.
+ *
+ */
+template <int dataW, int lW, int keyNum>
+void hmacSha256Cached(const ap_uint<512> keyState[keyNum],
+                      hls::stream<ap_uint<dataW> >& msgStrm,
+                      hls::stream<ap_uint<lW> >& msgLenStrm,
+                      hls::stream<ap_uint<16> >& keyIdStrm,
+                      hls::stream<bool>& eLenStrm,
+                      hls::stream<ap_uint<256> >& hshStrm,
+                      hls::stream<bool>& eHshStrm) {
+    XF_SECURITY_STATIC_ASSERT((dataW == 32) || (dataW == 64), "dataW must be 32 or 64");
+    internal::hmacSha256CachedDataflow<dataW, lW, keyNum>(keyState, msgStrm, msgLenStrm, keyIdStrm, eLenStrm, hshStrm,
+                                                          eHshStrm);
+}
 } // end of namespace security
 } // end of namespace xf
 
@@ -34,6 +34,8 @@
 #include <ap_int.h>
 #include <hls_stream.h>
 
+#include "xf_security/utils.hpp"
+
 // for debug
 #ifndef __SYNTHESIS__
 #include <iostream>
@@ -54,24 +56,39 @@ struct blockType {
  * The algorithm reference is : "Secure Hash Standard", which published by NIST in February 2012.
  * The optimization goal of this function is to yield a 512-bit block per cycle.
  *
+ * When RESUME is true, a chaining state and a final flag are read for each message.
+ * The length appended in padding then counts the bytes already hashed in the state,
+ * and a non-final segment, whose length must be a multiple of 64, is emitted without padding.
+ *
+ * @tparam RESUME Whether each message starts from an intermediate chaining state.
+ *
  * @param msg_strm The message being hashed.
  * @param len_strm The message length in byte.
  * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state {bytes hashed, H} to start from, only read when RESUME.
+ * @param final_strm The flag to signal that this segment ends the message, only read when RESUME.
  * @param blk_strm The 512-bit hash block.
  * @param nblk_strm The number of hash block for this message.
  * @param end_nblk_strm End flag for number of hash block.
+ * @param state_fwd_strm The chaining state with updated byte count, forwarded to digest when RESUME.
+ * @param final_fwd_strm The final flag forwarded to digest when RESUME.
  *
  */
 
+template <bool RESUME>
 static void preProcessing(
     // inputs
     hls::stream<ap_uint<32> >& msg_strm,
     hls::stream<ap_uint<64> >& len_strm,
     hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<224> >& init_state_strm,
+    hls::stream<bool>& final_strm,
     // outputs
     hls::stream<blockType>& blk_strm,
     hls::stream<ap_uint<64> >& nblk_strm,
-    hls::stream<bool>& end_nblk_strm) {
+    hls::stream<bool>& end_nblk_strm,
+    hls::stream<ap_uint<224> >& state_fwd_strm,
+    hls::stream<bool>& final_fwd_strm) {
     bool endFlag = end_len_strm.read();
 
 LOOP_PREPROCESSING_MAIN:
@@ -80,11 +97,25 @@ LOOP_PREPROCESSING_MAIN:
         // read message length in byte
         ap_uint<64> len = len_strm.read();
 
+        // number of bytes hashed before this segment, and whether this segment is the last one
+        ap_uint<64> prefix = 0;
+        bool fin = true;
+        if (RESUME) {
+            ap_uint<224> st = init_state_strm.read();
+            fin = final_strm.read();
+            prefix = st.range(223, 160);
+            st.range(223, 160) = prefix + len;
+            state_fwd_strm.write(st);
+            final_fwd_strm.write(fin);
+        }
+        // a non-final segment is not padded, so a partial tail block would shift into the next segment
+        XF_SECURITY_ASSERT(fin || (len & 0x3f) == 0);
+
         // prepare message length in bit which will be appended at the tail of the block according to the standard
-        ap_uint<64> L = 8 * len;
+        ap_uint<64> L = 8 * (prefix + len);
 
         // total number blocks to digest in 512-bit
-        ap_uint<64> blk_num = (len >> 6) + 1 + ((len & 0x3f) > 55);
+        ap_uint<64> blk_num = fin ? (ap_uint<64>)((len >> 6) + 1 + ((len & 0x3f) > 55)) : (ap_uint<64>)(len >> 6);
 
         // inform digest function
         nblk_strm.write(blk_num);
@@ -116,7 +147,9 @@ LOOP_PREPROCESSING_MAIN:
         // number of bytes left which needs to be padded as a new full block
         ap_uint<6> left = (ap_uint<6>)(len & 0x3fUL);
 
-        if (left == 0) {
+        if (!fin) {
+            // non-final segment, no padding
+        } else if (left == 0) {
             // end at block boundary, start with pad 1
             // last block
             blockType b;
@@ -437,23 +470,30 @@ LOOP_GEN_W_MAIN:
  * The implementation is modified for better performance.
  *
  * @tparam w The bit width of each input message word, default value is 32.
+ * @tparam RESUME Whether each message starts from an intermediate chaining state.
  *
  * @param w_strm Message schedule stream.
  * @param nblk_strm Number of message block stream.
  * @param end_nblk_strm End flag for number of message block stream.
+ * @param state_fwd_strm The chaining state to start from, only read when RESUME.
+ * @param final_fwd_strm The flag to signal the last segment, only read when RESUME.
  * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
  * @param end_digest_strm End flag for output digest stream.
  *
  */
 
-template <unsigned int w>
+template <unsigned int w, bool RESUME>
 void SHA1Digest(
     // inputs
     hls::stream<ap_uint<w> >& w_strm,
     hls::stream<ap_uint<64> >& nblk_strm,
     hls::stream<bool>& end_nblk_strm,
+    hls::stream<ap_uint<224> >& state_fwd_strm,
+    hls::stream<bool>& final_fwd_strm,
     // outputs
     hls::stream<ap_uint<5 * w> >& digest_strm,
+    hls::stream<ap_uint<224> >& out_state_strm,
     hls::stream<bool>& end_digest_strm) {
     // the eighty constant 32-bit words of SHA-1
     static const ap_uint<w> K[4] = {
@@ -473,6 +513,19 @@ LOOP_SHA1_MAIN:
         ap_uint<w> H[5] = {0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL};
 #pragma HLS array_partition variable = H complete
 
+        // resume from the chaining state of the previous segment
+        ap_uint<224> st = 0;
+        bool fin = true;
+        if (RESUME) {
+            st = state_fwd_strm.read();
+            fin = final_fwd_strm.read();
+        LOOP_SHA1_LOAD_STATE:
+            for (ap_uint<3> i = 0; i < 5; i++) {
+#pragma HLS unroll
+                H[i] = st.range(32 * i + 31, 32 * i);
+            }
+        }
+
         // total number blocks to digest
         ap_uint<64> blkNum = nblk_strm.read();
 
@@ -532,21 +585,31 @@ LOOP_SHA1_MAIN:
 #endif
         }
 
-        // emit digest
-        ap_uint<5 * w> digest;
-    LOOP_SHA1_EMIT:
-        for (ap_uint<3> i = 0; i < 5; i++) {
+        if (!fin) {
+            // emit chaining state of a non-final segment
+        LOOP_SHA1_SAVE_STATE:
+            for (ap_uint<3> i = 0; i < 5; i++) {
 #pragma HLS unroll
-            ap_uint<w> l = H[i];
-            // XXX shift algorithm's big-endian to HLS's little-endian
-            ap_uint<8> t0 = ((l >> 24) & 0xff);
-            ap_uint<8> t1 = ((l >> 16) & 0xff);
-            ap_uint<8> t2 = ((l >> 8) & 0xff);
-            ap_uint<8> t3 = (l & 0xff);
-            digest.range(w * i + w - 1, w * i) =
-                ((ap_uint<w>)t0) | (((ap_uint<w>)t1) << 8) | (((ap_uint<w>)t2) << 16) | (((ap_uint<w>)t3) << 24);
+                st.range(32 * i + 31, 32 * i) = H[i];
+            }
+            out_state_strm.write(st);
+        } else {
+            // emit digest
+            ap_uint<5 * w> digest;
+        LOOP_SHA1_EMIT:
+            for (ap_uint<3> i = 0; i < 5; i++) {
+#pragma HLS unroll
+                ap_uint<w> l = H[i];
+                // XXX shift algorithm's big-endian to HLS's little-endian
+                ap_uint<8> t0 = ((l >> 24) & 0xff);
+                ap_uint<8> t1 = ((l >> 16) & 0xff);
+                ap_uint<8> t2 = ((l >> 8) & 0xff);
+                ap_uint<8> t3 = (l & 0xff);
+                digest.range(w * i + w - 1, w * i) =
+                    ((ap_uint<w>)t0) | (((ap_uint<w>)t1) << 8) | (((ap_uint<w>)t2) << 16) | (((ap_uint<w>)t3) << 24);
+            }
+            digest_strm.write(digest);
         }
-        digest_strm.write(digest);
         end_digest_strm.write(false);
 
         end = end_nblk_strm.read();
@@ -556,38 +619,40 @@ LOOP_SHA1_MAIN:
 
 } // end SHA1Digest
 
-} // end namespace internal
-
 /**
  *
- * @brief Top function of SHA-1.
- *
- * The algorithm reference is : "Secure Hash Standard", which published by NIST in February 2012.
- * The implementation dataflows the pre-processing part and message digest part.
+ * @brief Dataflow of SHA-1 with optional chaining state input and output.
  *
  * @tparam w The bit width of each input message word, default value is 32.
+ * @tparam RESUME Whether each message starts from an intermediate chaining state.
  *
  * @param msg_strm The message being hashed.
  * @param len_strm The message length in byte.
  * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state to start from, only read when RESUME.
+ * @param final_strm The flag to signal the last segment, only read when RESUME.
  * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
  * @param end_digest_strm End flag for output digest stream.
  *
  */
 
-template <unsigned int w>
-void sha1(
+template <unsigned int w, bool RESUME>
+void sha1Top(
     // inputs
     hls::stream<ap_uint<w> >& msg_strm,
     hls::stream<ap_uint<64> >& len_strm,
     hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<224> >& init_state_strm,
+    hls::stream<bool>& final_strm,
     // outputs
     hls::stream<ap_uint<5 * w> >& digest_strm,
+    hls::stream<ap_uint<224> >& out_state_strm,
     hls::stream<bool>& end_digest_strm) {
 #pragma HLS dataflow
 
     // 512-bit processing block stream
-    hls::stream<internal::blockType> blk_strm("blk_strm");
+    hls::stream<blockType> blk_strm("blk_strm");
 #pragma HLS stream variable = blk_strm depth = 4
 #pragma HLS resource variable = blk_strm core = FIFO_LUTRAM
 
@@ -607,19 +672,110 @@ void sha1(
 #pragma HLS stream variable = end_nblk_strm2 depth = 4
 #pragma HLS resource variable = end_nblk_strm2 core = FIFO_LUTRAM
 
+    // chaining state and final flag bypassing the message schedule
+    hls::stream<ap_uint<224> > state_fwd_strm("state_fwd_strm");
+#pragma HLS stream variable = state_fwd_strm depth = 32
+#pragma HLS resource variable = state_fwd_strm core = FIFO_LUTRAM
+    hls::stream<bool> final_fwd_strm("final_fwd_strm");
+#pragma HLS stream variable = final_fwd_strm depth = 32
+#pragma HLS resource variable = final_fwd_strm core = FIFO_LUTRAM
+
     // message schedule stream
     hls::stream<ap_uint<w> > w_strm("w_strm");
 #pragma HLS stream variable = w_strm depth = 320
 #pragma HLS resource variable = w_strm core = FIFO_BRAM
 
     // padding and appending message words into blocks
-    internal::preProcessing(msg_strm, len_strm, end_len_strm, blk_strm, nblk_strm1, end_nblk_strm1);
+    preProcessing<RESUME>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, blk_strm, nblk_strm1,
+                          end_nblk_strm1, state_fwd_strm, final_fwd_strm);
 
     // generate the message schedule in stream
-    internal::generateMsgSchedule<w>(blk_strm, nblk_strm1, end_nblk_strm1, w_strm, nblk_strm2, end_nblk_strm2);
+    generateMsgSchedule<w>(blk_strm, nblk_strm1, end_nblk_strm1, w_strm, nblk_strm2, end_nblk_strm2);
 
     // digest precessing blocks into hash value
-    internal::SHA1Digest<w>(w_strm, nblk_strm2, end_nblk_strm2, digest_strm, end_digest_strm);
+    SHA1Digest<w, RESUME>(w_strm, nblk_strm2, end_nblk_strm2, state_fwd_strm, final_fwd_strm, digest_strm,
+                          out_state_strm, end_digest_strm);
+
+} // end sha1Top
+
+} // end namespace internal
+
+/**
+ *
+ * @brief Top function of SHA-1.
+ *
+ * The algorithm reference is : "Secure Hash Standard", which published by NIST in February 2012.
+ * The implementation dataflows the pre-processing part and message digest part.
+ *
+ * @tparam w The bit width of each input message word, default value is 32.
+ *
+ * @param msg_strm The message being hashed.
+ * @param len_strm The message length in byte.
+ * @param end_len_strm The flag to signal end of input message stream.
+ * @param digest_strm Output digest stream.
+ * @param end_digest_strm End flag for output digest stream.
+ *
+ */
+
+template <unsigned int w>
+void sha1(
+    // inputs
+    hls::stream<ap_uint<w> >& msg_strm,
+    hls::stream<ap_uint<64> >& len_strm,
+    hls::stream<bool>& end_len_strm,
+    // outputs
+    hls::stream<ap_uint<5 * w> >& digest_strm,
+    hls::stream<bool>& end_digest_strm) {
+    // chaining state streams are left unused
+    hls::stream<ap_uint<224> > init_state_strm("init_state_strm");
+    hls::stream<bool> final_strm("final_strm");
+    hls::stream<ap_uint<224> > out_state_strm("out_state_strm");
+
+    internal::sha1Top<w, false>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, digest_strm,
+                                out_state_strm, end_digest_strm);
+
+} // end sha1
+
+/**
+ *
+ * @brief Top function of SHA-1 resuming from an intermediate chaining state.
+ *
+ * Each message is one segment of a longer message. It starts from the chaining state read from init_state_strm,
+ * which holds the number of bytes hashed so far in bits [223:160] and H[i] in bits [32i+31:32i].
+ * Use 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 with zero bytes hashed for the first segment.
+ * A non-final segment must be a multiple of 64 bytes long, and its chaining state is written to out_state_strm.
+ * The final segment is padded with the total length and its digest is written to digest_strm.
+ * End flag false is written once per segment in either case.
+ * The segment length is not checked in hardware: the tail of a non-final segment that is not a whole number of
+ * blocks is taken as the head of the next segment and every later result is wrong. C simulation asserts on it.
+ *
+ * @tparam w The bit width of each input message word, default value is 32.
+ *
+ * @param msg_strm The message being hashed.
+ * @param len_strm The segment length in byte.
+ * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state to start from, one per segment.
+ * @param final_strm The flag to signal that this segment ends the message, one per segment.
+ * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
+ * @param end_digest_strm End flag for output digest stream.
+ *
+ */
+
+template <unsigned int w>
+void sha1(
+    // inputs
+    hls::stream<ap_uint<w> >& msg_strm,
+    hls::stream<ap_uint<64> >& len_strm,
+    hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<224> >& init_state_strm,
+    hls::stream<bool>& final_strm,
+    // outputs
+    hls::stream<ap_uint<5 * w> >& digest_strm,
+    hls::stream<ap_uint<224> >& out_state_strm,
+    hls::stream<bool>& end_digest_strm) {
+    internal::sha1Top<w, true>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, digest_strm,
+                               out_state_strm, end_digest_strm);
 
 } // end sha1
 
@@ -47,18 +47,46 @@ static inline ap_uint<32> Maj(ap_uint<32> a, ap_uint<32> b, ap_uint<32> c) {
     return (a & b) ^ (a & c) ^ (b & c);
 }
 
+// K常数数组
+static const ap_uint<32> SHA256_K[64] = {
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+    0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+    0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+    0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+    0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+    0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+    0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+// 续算模式：NONE 不带中间状态；SEGMENT 每段另读是否为最终分段；
+// FINAL 每段均为最终分段，只从给定状态续算出摘要；PARTIAL 每段均非最终分段，只输出中间状态
+enum sha256ResumeMode {
+    SHA256_RESUME_NONE = 0,
+    SHA256_RESUME_SEGMENT = 1,
+    SHA256_RESUME_FINAL = 2,
+    SHA256_RESUME_PARTIAL = 3
+};
+
 // 处理块结构
 struct SHA256Block {
     ap_uint<32> M[16];
 };
 
 // 预处理函数（32位版本）- 简化版本避免综合错误
-inline void preProcessing(hls::stream<ap_uint<32> >& msg_strm,
-                         hls::stream<ap_uint<64> >& len_strm,
-                         hls::stream<bool>& end_len_strm,
-                         hls::stream<SHA256Block>& blk_strm,
-                         hls::stream<uint64_t>& nblk_strm,
-                         hls::stream<bool>& end_nblk_strm) {
+// RESUME 非零时每条消息额外读入中间状态 {已处理字节数, H}，SEGMENT 模式另读是否为最终分段，
+// 长度域按 已处理字节数+len 计算；非最终分段 len 须为64的整数倍且不做填充
+template <int RESUME>
+void preProcessing(hls::stream<ap_uint<32> >& msg_strm,
+                   hls::stream<ap_uint<64> >& len_strm,
+                   hls::stream<bool>& end_len_strm,
+                   hls::stream<ap_uint<320> >& init_state_strm,
+                   hls::stream<bool>& final_strm,
+                   hls::stream<SHA256Block>& blk_strm,
+                   hls::stream<uint64_t>& nblk_strm,
+                   hls::stream<bool>& end_nblk_strm,
+                   hls::stream<ap_uint<320> >& state_fwd_strm,
+                   hls::stream<bool>& final_fwd_strm) {
     
     bool end_flag = end_len_strm.read();
     
@@ -67,8 +95,24 @@ LOOP_SHA256_GENENERATE_MAIN_32:
         #pragma HLS LOOP_TRIPCOUNT min=1 max=10
         
         uint64_t len = len_strm.read();
-        uint64_t L = 8 * len;
-        uint64_t blk_num = (len >> 6) + 1 + ((len & 0x3f) > 55);
+        uint64_t prefix = 0;
+        bool fin = true;
+        if (RESUME) {
+            ap_uint<320> st = init_state_strm.read();
+            if (RESUME == SHA256_RESUME_SEGMENT) {
+                fin = final_strm.read();
+                final_fwd_strm.write(fin);
+            } else {
+                fin = (RESUME == SHA256_RESUME_FINAL);
+            }
+            prefix = st.range(319, 256);
+            st.range(319, 256) = prefix + len;
+            state_fwd_strm.write(st);
+        }
+        // 非最终分段不做填充，长度不是64的整数倍时其尾部字节会错位到下一分段
+        XF_SECURITY_ASSERT(fin || (len & 0x3f) == 0);
+        uint64_t L = 8 * (prefix + len);
+        uint64_t blk_num = fin ? ((len >> 6) + 1 + ((len & 0x3f) > 55)) : (len >> 6);
         nblk_strm.write(blk_num);
         end_nblk_strm.write(false);
 
@@ -94,7 +138,9 @@ LOOP_SHA256_GENENERATE_MAIN_32:
             blk_strm.write(b0);
         }
 
-        if (left == 0) {
+        if (!fin) {
+            // 非最终分段：只输出整块
+        } else if (left == 0) {
             SHA256Block b;
             #pragma HLS ARRAY_PARTITION variable=b.M complete dim=1
             b.M[0] = 0x80000000U;
@@ -205,12 +251,19 @@ LOOP_SHA256_GENENERATE_MAIN_32:
 }
 
 // 预处理函数（64位版本）- 简化版本
-inline void preProcessing(hls::stream<ap_uint<64> >& msg_strm,
-                         hls::stream<ap_uint<64> >& len_strm,
-                         hls::stream<bool>& end_len_strm,
-                         hls::stream<SHA256Block>& blk_strm,
-                         hls::stream<uint64_t>& nblk_strm,
-                         hls::stream<bool>& end_nblk_strm) {
+// RESUME 非零时每条消息额外读入中间状态 {已处理字节数, H}，SEGMENT 模式另读是否为最终分段，
+// 长度域按 已处理字节数+len 计算；非最终分段 len 须为64的整数倍且不做填充
+template <int RESUME>
+void preProcessing(hls::stream<ap_uint<64> >& msg_strm,
+                   hls::stream<ap_uint<64> >& len_strm,
+                   hls::stream<bool>& end_len_strm,
+                   hls::stream<ap_uint<320> >& init_state_strm,
+                   hls::stream<bool>& final_strm,
+                   hls::stream<SHA256Block>& blk_strm,
+                   hls::stream<uint64_t>& nblk_strm,
+                   hls::stream<bool>& end_nblk_strm,
+                   hls::stream<ap_uint<320> >& state_fwd_strm,
+                   hls::stream<bool>& final_fwd_strm) {
     
     bool end_flag = end_len_strm.read();
     
@@ -219,8 +272,24 @@ LOOP_SHA256_GENENERATE_MAIN_64:
         #pragma HLS LOOP_TRIPCOUNT min=1 max=10
         
         uint64_t len = len_strm.read();
-        uint64_t L = 8 * len;
-        uint64_t blk_num = (len >> 6) + 1 + ((len & 0x3f) > 55);
+        uint64_t prefix = 0;
+        bool fin = true;
+        if (RESUME) {
+            ap_uint<320> st = init_state_strm.read();
+            if (RESUME == SHA256_RESUME_SEGMENT) {
+                fin = final_strm.read();
+                final_fwd_strm.write(fin);
+            } else {
+                fin = (RESUME == SHA256_RESUME_FINAL);
+            }
+            prefix = st.range(319, 256);
+            st.range(319, 256) = prefix + len;
+            state_fwd_strm.write(st);
+        }
+        // 非最终分段不做填充，长度不是64的整数倍时其尾部字节会错位到下一分段
+        XF_SECURITY_ASSERT(fin || (len & 0x3f) == 0);
+        uint64_t L = 8 * (prefix + len);
+        uint64_t blk_num = fin ? ((len >> 6) + 1 + ((len & 0x3f) > 55)) : (len >> 6);
         nblk_strm.write(blk_num);
         end_nblk_strm.write(false);
 
@@ -253,7 +322,9 @@ LOOP_SHA256_GENENERATE_MAIN_64:
             blk_strm.write(b0);
         }
 
-        if (left == 0) {
+        if (!fin) {
+            // 非最终分段：只输出整块
+        } else if (left == 0) {
             SHA256Block b;
             #pragma HLS ARRAY_PARTITION variable=b.M complete dim=1
             b.M[0] = 0x80000000U;
@@ -364,73 +435,86 @@ LOOP_SHA256_GENENERATE_MAIN_64:
     end_nblk_strm.write(true);
 }
 
-// 压缩函数 - 简化版本
-static inline void compress_one(const ap_uint<32> M_in[16], ap_uint<32> H[8]) {
+// 不带中间状态的预处理接口
+template <int m_width>
+void preProcessing(hls::stream<ap_uint<m_width> >& msg_strm,
+                   hls::stream<ap_uint<64> >& len_strm,
+                   hls::stream<bool>& end_len_strm,
+                   hls::stream<SHA256Block>& blk_strm,
+                   hls::stream<uint64_t>& nblk_strm,
+                   hls::stream<bool>& end_nblk_strm) {
+    hls::stream<ap_uint<320> > init_state_strm;
+    hls::stream<bool> final_strm;
+    hls::stream<ap_uint<320> > state_fwd_strm;
+    hls::stream<bool> final_fwd_strm;
+    preProcessing<false>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, blk_strm, nblk_strm,
+                         end_nblk_strm, state_fwd_strm, final_fwd_strm);
+}
+
+// 多轮/拍压缩函数：每拍展开RPC轮，K[i]+W[i]提前一拍算好寄存，
+// 多操作数加法交由综合工具映射为进位保存/三元加法器
+template <int RPC>
+static void compress_multi(const ap_uint<32> M_in[16], ap_uint<32> H[8]) {
 #pragma HLS INLINE off
-    
-    ap_uint<32> wbuf[16];
-#pragma HLS ARRAY_PARTITION variable=wbuf complete dim=1
-
-    // K常数数组
-    const ap_uint<32> K[64] = {
-        0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
-        0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
-        0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
-        0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
-        0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
-        0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
-        0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
-        0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
-    };
-
-    // 预装载消息字
-LOAD_W0_15:
+    XF_SECURITY_STATIC_ASSERT((RPC == 1) || (RPC == 2) || (RPC == 4), "RPC must be 1, 2 or 4");
+
+    // w[j] 保存 W[i+j]，kw[k] 保存 K[i+k]+W[i+k]
+    ap_uint<32> w[16];
+#pragma HLS ARRAY_PARTITION variable=w complete dim=1
+    ap_uint<32> kw[RPC];
+#pragma HLS ARRAY_PARTITION variable=kw complete dim=1
+
+LOAD_W0_15_MULTI:
     for (int i = 0; i < 16; i++) {
         #pragma HLS UNROLL
-        wbuf[i] = M_in[i];
+        w[i] = M_in[i];
+    }
+PRE_KW_MULTI:
+    for (int k = 0; k < RPC; k++) {
+        #pragma HLS UNROLL
+        kw[k] = SHA256_K[k] + w[k];
     }
 
     ap_uint<32> a = H[0], b = H[1], c = H[2], d = H[3];
     ap_uint<32> e = H[4], f = H[5], g = H[6], h = H[7];
 
-RoundLoop:
-    for (int i = 0; i < 64; i++) {
+MultiRoundLoop:
+    for (int i = 0; i < 64; i += RPC) {
         #pragma HLS PIPELINE II=1
-        
-        ap_uint<32> Wi;
-        if (i < 16) {
-            Wi = wbuf[i];
-        } else {
-            ap_uint<4> i_m2 = (i - 2) & 15;
-            ap_uint<4> i_m7 = (i - 7) & 15;
-            ap_uint<4> i_m15 = (i - 15) & 15;
-            ap_uint<4> i_m16 = (i - 16) & 15;
-
-            ap_uint<32> s1 = sigma1(wbuf[i_m2]);
-            ap_uint<32> s0 = sigma0(wbuf[i_m15]);
-            ap_uint<32> t1 = s1 + wbuf[i_m7];
-            ap_uint<32> t2 = s0 + wbuf[i_m16];
-            Wi = t1 + t2;
-
-            wbuf[i & 15] = Wi;
+
+        // 消息调度与轮函数并行：生成后续RPC个W
+        ap_uint<32> nw[RPC];
+#pragma HLS ARRAY_PARTITION variable=nw complete dim=1
+        for (int k = 0; k < RPC; k++) {
+            #pragma HLS UNROLL
+            ap_uint<32> w_m2 = (k < 2) ? w[14 + k] : nw[(k - 2) & (RPC - 1)];
+            nw[k] = sigma1(w_m2) + w[9 + k] + sigma0(w[1 + k]) + w[k];
+        }
+
+        for (int k = 0; k < RPC; k++) {
+            #pragma HLS UNROLL
+            ap_uint<32> T1 = h + Sigma1(e) + Ch(e, f, g) + kw[k];
+            ap_uint<32> T2 = Sigma0(a) + Maj(a, b, c);
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + T1;
+            d = c;
+            c = b;
+            b = a;
+            a = T1 + T2;
         }
 
-        ap_uint<32> S1_e = Sigma1(e);
-        ap_uint<32> ch_efg = Ch(e, f, g);
-        ap_uint<32> S0_a = Sigma0(a);
-        ap_uint<32> maj_abc = Maj(a, b, c);
-
-        ap_uint<32> T1 = h + S1_e + ch_efg + K[i] + Wi;
-        ap_uint<32> T2 = S0_a + maj_abc;
-
-        h = g;
-        g = f;
-        f = e;
-        e = d + T1;
-        d = c;
-        c = b;
-        b = a;
-        a = T1 + T2;
+        for (int j = 0; j < 16 - RPC; j++) {
+            #pragma HLS UNROLL
+            w[j] = w[j + RPC];
+        }
+        for (int k = 0; k < RPC; k++) {
+            #pragma HLS UNROLL
+            w[16 - RPC + k] = nw[k];
+            kw[k] = SHA256_K[(i + RPC + k) & 63] + w[k];
+        }
     }
 
     H[0] = H[0] + a;
@@ -444,11 +528,14 @@ RoundLoop:
 }
 
 // 融合摘要计算
-template <int h_width>
+template <int h_width, int RPC, int RESUME>
 void fusedDigest(hls::stream<SHA256Block>& blk_strm,
                 hls::stream<uint64_t>& nblk_strm,
                 hls::stream<bool>& end_nblk_strm,
+                hls::stream<ap_uint<320> >& state_fwd_strm,
+                hls::stream<bool>& final_fwd_strm,
                 hls::stream<ap_uint<h_width> >& hash_strm,
+                hls::stream<ap_uint<320> >& out_state_strm,
                 hls::stream<bool>& end_hash_strm) {
     XF_SECURITY_STATIC_ASSERT((h_width == 256) || (h_width == 224), "Unsupported hash width, must be 224 or 256");
 
@@ -460,11 +547,27 @@ MAIN_MSG_LOOP:
         
         uint64_t blk_num = nblk_strm.read();
 
+        ap_uint<320> st = 0;
+        bool fin = true;
+        if (RESUME) {
+            st = state_fwd_strm.read();
+            if (RESUME == SHA256_RESUME_SEGMENT) {
+                fin = final_fwd_strm.read();
+            } else {
+                fin = (RESUME == SHA256_RESUME_FINAL);
+            }
+        }
+
         ap_uint<32> H[8];
         #pragma HLS ARRAY_PARTITION variable=H complete dim=1
         
-        // 初始化哈希值
-        if (h_width == 224) {
+        // 初始化哈希值，续算时取自中间状态
+        if (RESUME) {
+            for (int i = 0; i < 8; ++i) {
+                #pragma HLS UNROLL
+                H[i] = st.range(32*i+31, 32*i);
+            }
+        } else if (h_width == 224) {
             H[0] = 0xc1059ed8U;
             H[1] = 0x367cd507U;
             H[2] = 0x3070dd17U;
@@ -491,11 +594,17 @@ MAIN_MSG_LOOP:
             
             SHA256Block blk = blk_strm.read();
             #pragma HLS ARRAY_PARTITION variable=blk.M complete
-            compress_one(blk.M, H);
+            compress_multi<RPC>(blk.M, H);
         }
 
-        // 输出哈希值
-        if (h_width == 224) {
+        // 输出哈希值，非最终分段输出中间状态
+        if (!fin) {
+            for (int i = 0; i < 8; ++i) {
+                #pragma HLS UNROLL
+                st.range(32*i+31, 32*i) = H[i];
+            }
+            out_state_strm.write(st);
+        } else if (h_width == 224) {
             ap_uint<224> out_hash = 0;
             for (int i = 0; i < 7; ++i) {
                 #pragma HLS UNROLL
@@ -527,17 +636,214 @@ MAIN_MSG_LOOP:
     end_hash_strm.write(true);
 }
 
+// 消息调度级：每拍输出一个 K[t]+W[t]，与轮函数级以数据流方式并行，
+// 下一块的调度在当前块轮运算期间即已开始
+inline void msgSchedule(hls::stream<SHA256Block>& blk_strm,
+                        hls::stream<uint64_t>& nblk_strm,
+                        hls::stream<bool>& end_nblk_strm,
+                        hls::stream<ap_uint<32> >& kw_strm,
+                        hls::stream<uint64_t>& nblk_out_strm,
+                        hls::stream<bool>& end_nblk_out_strm) {
+    bool end_flag = end_nblk_strm.read();
+
+LOOP_SHA256_SCHEDULE_MAIN:
+    while (!end_flag) {
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=10
+
+        uint64_t blk_num = nblk_strm.read();
+        nblk_out_strm.write(blk_num);
+        end_nblk_out_strm.write(false);
+
+        // m 为当前块尚未输出的消息字，w[j] 保存 W[t-16+j]
+        ap_uint<32> m[16];
+#pragma HLS ARRAY_PARTITION variable=m complete dim=1
+        ap_uint<32> w[16];
+#pragma HLS ARRAY_PARTITION variable=w complete dim=1
+
+    LOOP_SHA256_SCHEDULE_WORDS:
+        for (uint64_t t = 0; t < blk_num * 64; ++t) {
+            #pragma HLS PIPELINE II=1
+            #pragma HLS LOOP_TRIPCOUNT min=64 max=128
+            ap_uint<6> r = t & 63;
+            if (r == 0) {
+                SHA256Block blk = blk_strm.read();
+                for (int i = 0; i < 16; ++i) {
+                    #pragma HLS UNROLL
+                    m[i] = blk.M[i];
+                }
+            }
+
+            ap_uint<32> Wt;
+            if (r < 16) {
+                Wt = m[0];
+                for (int i = 0; i < 15; ++i) {
+                    #pragma HLS UNROLL
+                    m[i] = m[i + 1];
+                }
+            } else {
+                Wt = sigma1(w[14]) + w[9] + sigma0(w[1]) + w[0];
+            }
+            for (int i = 0; i < 15; ++i) {
+                #pragma HLS UNROLL
+                w[i] = w[i + 1];
+            }
+            w[15] = Wt;
+
+            kw_strm.write(SHA256_K[r] + Wt);
+        }
+
+        end_flag = end_nblk_strm.read();
+    }
+    end_nblk_out_strm.write(true);
+}
+
+// 轮函数级：同一消息的所有块在一个II=1循环内连续处理，
+// 前馈累加并入每块第63轮（H0+T2、H4+d 与 T1 并行计算），块间无气泡
+template <int h_width, int RESUME>
+void roundDigest(hls::stream<ap_uint<32> >& kw_strm,
+                 hls::stream<uint64_t>& nblk_strm,
+                 hls::stream<bool>& end_nblk_strm,
+                 hls::stream<ap_uint<320> >& state_fwd_strm,
+                 hls::stream<bool>& final_fwd_strm,
+                 hls::stream<ap_uint<h_width> >& hash_strm,
+                 hls::stream<ap_uint<320> >& out_state_strm,
+                 hls::stream<bool>& end_hash_strm) {
+    XF_SECURITY_STATIC_ASSERT((h_width == 256) || (h_width == 224), "Unsupported hash width, must be 224 or 256");
+
+    bool end_flag = end_nblk_strm.read();
+
+LOOP_SHA256_ROUND_MAIN:
+    while (!end_flag) {
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=10
+
+        uint64_t blk_num = nblk_strm.read();
+
+        ap_uint<320> st = 0;
+        bool fin = true;
+        if (RESUME) {
+            st = state_fwd_strm.read();
+            if (RESUME == SHA256_RESUME_SEGMENT) {
+                fin = final_fwd_strm.read();
+            } else {
+                fin = (RESUME == SHA256_RESUME_FINAL);
+            }
+        }
+
+        ap_uint<32> H[8];
+        #pragma HLS ARRAY_PARTITION variable=H complete dim=1
+
+        // 初始化哈希值，续算时取自中间状态
+        if (RESUME) {
+            for (int i = 0; i < 8; ++i) {
+                #pragma HLS UNROLL
+                H[i] = st.range(32*i+31, 32*i);
+            }
+        } else if (h_width == 224) {
+            H[0] = 0xc1059ed8U;
+            H[1] = 0x367cd507U;
+            H[2] = 0x3070dd17U;
+            H[3] = 0xf70e5939U;
+            H[4] = 0xffc00b31U;
+            H[5] = 0x68581511U;
+            H[6] = 0x64f98fa7U;
+            H[7] = 0xbefa4fa4U;
+        } else {
+            H[0] = 0x6a09e667U;
+            H[1] = 0xbb67ae85U;
+            H[2] = 0x3c6ef372U;
+            H[3] = 0xa54ff53aU;
+            H[4] = 0x510e527fU;
+            H[5] = 0x9b05688cU;
+            H[6] = 0x1f83d9abU;
+            H[7] = 0x5be0cd19U;
+        }
+
+        ap_uint<32> a = H[0], b = H[1], c = H[2], d = H[3];
+        ap_uint<32> e = H[4], f = H[5], g = H[6], h = H[7];
+
+    LOOP_SHA256_ROUNDS:
+        for (uint64_t t = 0; t < blk_num * 64; ++t) {
+            #pragma HLS PIPELINE II=1
+            #pragma HLS LOOP_TRIPCOUNT min=64 max=128
+            ap_uint<32> kw = kw_strm.read();
+
+            ap_uint<32> T1 = h + Sigma1(e) + Ch(e, f, g) + kw;
+            ap_uint<32> T2 = Sigma0(a) + Maj(a, b, c);
+
+            if ((t & 63) == 63) {
+                ap_uint<32> hT2 = H[0] + T2;
+                ap_uint<32> hd = H[4] + d;
+                H[7] = H[7] + g;
+                H[6] = H[6] + f;
+                H[5] = H[5] + e;
+                H[4] = hd + T1;
+                H[3] = H[3] + c;
+                H[2] = H[2] + b;
+                H[1] = H[1] + a;
+                H[0] = hT2 + T1;
+
+                a = H[0];
+                b = H[1];
+                c = H[2];
+                d = H[3];
+                e = H[4];
+                f = H[5];
+                g = H[6];
+                h = H[7];
+            } else {
+                h = g;
+                g = f;
+                f = e;
+                e = d + T1;
+                d = c;
+                c = b;
+                b = a;
+                a = T1 + T2;
+            }
+        }
+
+        // 输出哈希值，非最终分段输出中间状态
+        if (!fin) {
+            for (int i = 0; i < 8; ++i) {
+                #pragma HLS UNROLL
+                st.range(32*i+31, 32*i) = H[i];
+            }
+            out_state_strm.write(st);
+        } else {
+            ap_uint<h_width> out_hash = 0;
+            for (int i = 0; i < h_width / 32; ++i) {
+                #pragma HLS UNROLL
+                ap_uint<32> word = H[i];
+                ap_uint<32> little_endian = ((word & 0x000000ffU) << 24) |
+                                          ((word & 0x0000ff00U) << 8) |
+                                          ((word & 0x00ff0000U) >> 8) |
+                                          ((word & 0xff000000U) >> 24);
+                out_hash.range(32*i+31, 32*i) = little_endian;
+            }
+            hash_strm.write(out_hash);
+        }
+        end_hash_strm.write(false);
+
+        end_flag = end_nblk_strm.read();
+    }
+    end_hash_strm.write(true);
+}
+
 // 顶层数据流
-template <int m_width, int h_width>
+template <int m_width, int h_width, int RPC, int RESUME>
 inline void sha256_top(hls::stream<ap_uint<m_width> >& msg_strm,
                       hls::stream<ap_uint<64> >& len_strm,
                       hls::stream<bool>& end_len_strm,
+                      hls::stream<ap_uint<320> >& init_state_strm,
+                      hls::stream<bool>& final_strm,
                       hls::stream<ap_uint<h_width> >& hash_strm,
+                      hls::stream<ap_uint<320> >& out_state_strm,
                       hls::stream<bool>& end_hash_strm) {
     #pragma HLS DATAFLOW
     
     XF_SECURITY_STATIC_ASSERT((m_width == 32) || (m_width == 64), "m_width must be 32 or 64");
     XF_SECURITY_STATIC_ASSERT((h_width == 224) || (h_width == 256), "h_width must be 224 or 256");
+    XF_SECURITY_STATIC_ASSERT((RPC == 1) || (RPC == 2) || (RPC == 4), "ROUNDS_PER_CYCLE must be 1, 2 or 4");
 
     // 流配置
     hls::stream<SHA256Block> blk_strm("blk_strm");
@@ -549,39 +855,372 @@ inline void sha256_top(hls::stream<ap_uint<m_width> >& msg_strm,
     hls::stream<bool> end_nblk_strm("end_nblk_strm");
     #pragma HLS STREAM variable=end_nblk_strm depth=8
 
+    hls::stream<ap_uint<32> > kw_strm("kw_strm");
+    #pragma HLS STREAM variable=kw_strm depth=64
+
+    hls::stream<uint64_t> nblk2_strm("nblk2_strm");
+    #pragma HLS STREAM variable=nblk2_strm depth=8
+
+    hls::stream<bool> end_nblk2_strm("end_nblk2_strm");
+    #pragma HLS STREAM variable=end_nblk2_strm depth=8
+
+    hls::stream<ap_uint<320> > state_fwd_strm("state_fwd_strm");
+    #pragma HLS STREAM variable=state_fwd_strm depth=32
+
+    hls::stream<bool> final_fwd_strm("final_fwd_strm");
+    #pragma HLS STREAM variable=final_fwd_strm depth=32
+
     // 选择预处理函数
     if (m_width == 32) {
-        preProcessing((hls::stream<ap_uint<32> >&)msg_strm, len_strm, 
-                     end_len_strm, blk_strm, nblk_strm, end_nblk_strm);
+        preProcessing<RESUME>((hls::stream<ap_uint<32> >&)msg_strm, len_strm, end_len_strm, init_state_strm,
+                              final_strm, blk_strm, nblk_strm, end_nblk_strm, state_fwd_strm, final_fwd_strm);
+    } else {
+        preProcessing<RESUME>((hls::stream<ap_uint<64> >&)msg_strm, len_strm, end_len_strm, init_state_strm,
+                              final_strm, blk_strm, nblk_strm, end_nblk_strm, state_fwd_strm, final_fwd_strm);
+    }
+
+    if (RPC == 1) {
+        // 单轮/拍：调度级与轮函数级拆分，块间流水衔接
+        msgSchedule(blk_strm, nblk_strm, end_nblk_strm, kw_strm, nblk2_strm, end_nblk2_strm);
+        roundDigest<h_width, RESUME>(kw_strm, nblk2_strm, end_nblk2_strm, state_fwd_strm, final_fwd_strm, hash_strm,
+                                     out_state_strm, end_hash_strm);
     } else {
-        preProcessing((hls::stream<ap_uint<64> >&)msg_strm, len_strm, 
-                     end_len_strm, blk_strm, nblk_strm, end_nblk_strm);
+        fusedDigest<h_width, RPC, RESUME>(blk_strm, nblk_strm, end_nblk_strm, state_fwd_strm, final_fwd_strm,
+                                          hash_strm, out_state_strm, end_hash_strm);
     }
+}
 
-    fusedDigest<h_width>(blk_strm, nblk_strm, end_nblk_strm, hash_strm, end_hash_strm);
+// 不带中间状态的顶层数据流
+template <int m_width, int h_width, int RPC>
+void sha256_top(hls::stream<ap_uint<m_width> >& msg_strm,
+                hls::stream<ap_uint<64> >& len_strm,
+                hls::stream<bool>& end_len_strm,
+                hls::stream<ap_uint<h_width> >& hash_strm,
+                hls::stream<bool>& end_hash_strm) {
+    hls::stream<ap_uint<320> > init_state_strm;
+    hls::stream<bool> final_strm;
+    hls::stream<ap_uint<320> > out_state_strm;
+    sha256_top<m_width, h_width, RPC, SHA256_RESUME_NONE>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm,
+                                             hash_strm, out_state_strm, end_hash_strm);
+}
+
+// 从给定中间状态续算且每段均为最终分段的顶层数据流，无 final/out_state 流
+template <int m_width, int h_width, int RPC>
+void sha256_top(hls::stream<ap_uint<m_width> >& msg_strm,
+                hls::stream<ap_uint<64> >& len_strm,
+                hls::stream<bool>& end_len_strm,
+                hls::stream<ap_uint<320> >& init_state_strm,
+                hls::stream<ap_uint<h_width> >& hash_strm,
+                hls::stream<bool>& end_hash_strm) {
+    hls::stream<bool> final_strm;
+    hls::stream<ap_uint<320> > out_state_strm;
+    sha256_top<m_width, h_width, RPC, SHA256_RESUME_FINAL>(msg_strm, len_strm, end_len_strm, init_state_strm,
+                                                           final_strm, hash_strm, out_state_strm, end_hash_strm);
+}
+
+// 每段均为非最终分段的顶层数据流，只输出中间状态，无 final/hash 流；
+// 每段长度须为64的整数倍
+template <int m_width, int RPC>
+void sha256_state_top(hls::stream<ap_uint<m_width> >& msg_strm,
+                      hls::stream<ap_uint<64> >& len_strm,
+                      hls::stream<bool>& end_len_strm,
+                      hls::stream<ap_uint<320> >& init_state_strm,
+                      hls::stream<ap_uint<320> >& out_state_strm,
+                      hls::stream<bool>& end_state_strm) {
+    hls::stream<bool> final_strm;
+    hls::stream<ap_uint<256> > hash_strm;
+    sha256_top<m_width, 256, RPC, SHA256_RESUME_PARTIAL>(msg_strm, len_strm, end_len_strm, init_state_strm,
+                                                         final_strm, hash_strm, out_state_strm, end_state_strm);
+}
+
+// 多通道交织摘要：N个独立消息轮流占用同一套轮函数数据通路，
+// 第t拍处理通道 t%N 的第 t/N 轮，同一通道相邻两轮之间相隔N拍，
+// 从而隐藏64轮串行依赖，使流水线保持满载
+template <int N, int h_width>
+void multiChannelDigest(hls::stream<SHA256Block> blk_strm[N],
+                        hls::stream<uint64_t> nblk_strm[N],
+                        hls::stream<bool> end_nblk_strm[N],
+                        hls::stream<ap_uint<h_width> > hash_strm[N],
+                        hls::stream<bool> end_hash_strm[N]) {
+    XF_SECURITY_STATIC_ASSERT((h_width == 256) || (h_width == 224), "Unsupported hash width, must be 224 or 256");
+
+    // 各通道的链接值、工作变量和消息调度窗口
+    ap_uint<32> Hs[N][8];
+#pragma HLS ARRAY_PARTITION variable=Hs complete dim=2
+    ap_uint<32> vars[N][8];
+#pragma HLS ARRAY_PARTITION variable=vars complete dim=2
+    ap_uint<32> Ws[N][16];
+#pragma HLS ARRAY_PARTITION variable=Ws complete dim=2
+    // 当前消息剩余块数、本轮块是否有效、通道是否已结束
+    uint64_t left[N];
+    bool busy[N];
+    bool done[N];
+
+INIT_CHANNELS:
+    for (int c = 0; c < N; ++c) {
+        #pragma HLS PIPELINE II=1
+        left[c] = 0;
+        busy[c] = false;
+        done[c] = false;
+    }
+
+    int n_done = 0;
+
+MULTI_CH_SLOT_LOOP:
+    while (n_done < N) {
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=10
+
+    MULTI_CH_ROUND_LOOP:
+        for (int r = 0; r < 64; ++r) {
+        MULTI_CH_CHANNEL_LOOP:
+            for (int c = 0; c < N; ++c) {
+                #pragma HLS PIPELINE II=1
+                #pragma HLS DEPENDENCE variable=vars inter distance=N true
+                #pragma HLS DEPENDENCE variable=Ws inter distance=N true
+                #pragma HLS DEPENDENCE variable=Hs inter distance=N true
+
+                ap_uint<32> a, b, cc, d, e, f, g, h;
+                ap_uint<32> Wi;
+
+                if (r == 0) {
+                    // 块边界：必要时取下一条消息，再取下一个块
+                    if (left[c] == 0 && !done[c]) {
+                        if (end_nblk_strm[c].read()) {
+                            done[c] = true;
+                            end_hash_strm[c].write(true);
+                            ++n_done;
+                        } else {
+                            left[c] = nblk_strm[c].read();
+                            if (h_width == 224) {
+                                Hs[c][0] = 0xc1059ed8U;
+                                Hs[c][1] = 0x367cd507U;
+                                Hs[c][2] = 0x3070dd17U;
+                                Hs[c][3] = 0xf70e5939U;
+                                Hs[c][4] = 0xffc00b31U;
+                                Hs[c][5] = 0x68581511U;
+                                Hs[c][6] = 0x64f98fa7U;
+                                Hs[c][7] = 0xbefa4fa4U;
+                            } else {
+                                Hs[c][0] = 0x6a09e667U;
+                                Hs[c][1] = 0xbb67ae85U;
+                                Hs[c][2] = 0x3c6ef372U;
+                                Hs[c][3] = 0xa54ff53aU;
+                                Hs[c][4] = 0x510e527fU;
+                                Hs[c][5] = 0x9b05688cU;
+                                Hs[c][6] = 0x1f83d9abU;
+                                Hs[c][7] = 0x5be0cd19U;
+                            }
+                        }
+                    }
+                    busy[c] = (left[c] != 0);
+                    if (busy[c]) {
+                        SHA256Block blk = blk_strm[c].read();
+                        for (int i = 0; i < 16; ++i) {
+                            #pragma HLS UNROLL
+                            Ws[c][i] = blk.M[i];
+                        }
+                        Wi = blk.M[0];
+                    }
+                    a = Hs[c][0];
+                    b = Hs[c][1];
+                    cc = Hs[c][2];
+                    d = Hs[c][3];
+                    e = Hs[c][4];
+                    f = Hs[c][5];
+                    g = Hs[c][6];
+                    h = Hs[c][7];
+                } else {
+                    if (r < 16) {
+                        Wi = Ws[c][r];
+                    } else {
+                        ap_uint<4> i_m2 = (r - 2) & 15;
+                        ap_uint<4> i_m7 = (r - 7) & 15;
+                        ap_uint<4> i_m15 = (r - 15) & 15;
+                        ap_uint<4> i_m16 = (r - 16) & 15;
+                        Wi = sigma1(Ws[c][i_m2]) + Ws[c][i_m7] + sigma0(Ws[c][i_m15]) + Ws[c][i_m16];
+                        if (busy[c]) {
+                            Ws[c][r & 15] = Wi;
+                        }
+                    }
+                    a = vars[c][0];
+                    b = vars[c][1];
+                    cc = vars[c][2];
+                    d = vars[c][3];
+                    e = vars[c][4];
+                    f = vars[c][5];
+                    g = vars[c][6];
+                    h = vars[c][7];
+                }
+
+                if (busy[c]) {
+                    ap_uint<32> T1 = h + Sigma1(e) + Ch(e, f, g) + SHA256_K[r] + Wi;
+                    ap_uint<32> T2 = Sigma0(a) + Maj(a, b, cc);
+
+                    h = g;
+                    g = f;
+                    f = e;
+                    e = d + T1;
+                    d = cc;
+                    cc = b;
+                    b = a;
+                    a = T1 + T2;
+
+                    if (r == 63) {
+                        // 前馈累加，消息最后一块时输出摘要
+                        Hs[c][0] += a;
+                        Hs[c][1] += b;
+                        Hs[c][2] += cc;
+                        Hs[c][3] += d;
+                        Hs[c][4] += e;
+                        Hs[c][5] += f;
+                        Hs[c][6] += g;
+                        Hs[c][7] += h;
+                        --left[c];
+                        if (left[c] == 0) {
+                            ap_uint<h_width> out_hash = 0;
+                            for (int i = 0; i < h_width / 32; ++i) {
+                                #pragma HLS UNROLL
+                                ap_uint<32> word = Hs[c][i];
+                                ap_uint<32> little_endian = ((word & 0x000000ffU) << 24) |
+                                                          ((word & 0x0000ff00U) << 8) |
+                                                          ((word & 0x00ff0000U) >> 8) |
+                                                          ((word & 0xff000000U) >> 24);
+                                out_hash.range(32*i+31, 32*i) = little_endian;
+                            }
+                            hash_strm[c].write(out_hash);
+                            end_hash_strm[c].write(false);
+                        }
+                    } else {
+                        vars[c][0] = a;
+                        vars[c][1] = b;
+                        vars[c][2] = cc;
+                        vars[c][3] = d;
+                        vars[c][4] = e;
+                        vars[c][5] = f;
+                        vars[c][6] = g;
+                        vars[c][7] = h;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 多通道顶层数据流：每个通道独立预处理，共享一套压缩数据通路
+template <int N, int m_width, int h_width>
+inline void sha256MultiChannel_top(hls::stream<ap_uint<m_width> > msg_strm[N],
+                                   hls::stream<ap_uint<64> > len_strm[N],
+                                   hls::stream<bool> end_len_strm[N],
+                                   hls::stream<ap_uint<h_width> > hash_strm[N],
+                                   hls::stream<bool> end_hash_strm[N]) {
+    #pragma HLS DATAFLOW
+
+    XF_SECURITY_STATIC_ASSERT(N >= 1, "N must be at least 1");
+    XF_SECURITY_STATIC_ASSERT((m_width == 32) || (m_width == 64), "m_width must be 32 or 64");
+    XF_SECURITY_STATIC_ASSERT((h_width == 224) || (h_width == 256), "h_width must be 224 or 256");
+
+    // 流配置
+    hls::stream<SHA256Block> blk_strm[N];
+    #pragma HLS STREAM variable=blk_strm depth=32
+
+    hls::stream<uint64_t> nblk_strm[N];
+    #pragma HLS STREAM variable=nblk_strm depth=8
+
+    hls::stream<bool> end_nblk_strm[N];
+    #pragma HLS STREAM variable=end_nblk_strm depth=8
+
+PRE_PROCESSING_CHANNELS:
+    for (int c = 0; c < N; ++c) {
+        #pragma HLS UNROLL
+        if (m_width == 32) {
+            preProcessing((hls::stream<ap_uint<32> >&)msg_strm[c], len_strm[c],
+                         end_len_strm[c], blk_strm[c], nblk_strm[c], end_nblk_strm[c]);
+        } else {
+            preProcessing((hls::stream<ap_uint<64> >&)msg_strm[c], len_strm[c],
+                         end_len_strm[c], blk_strm[c], nblk_strm[c], end_nblk_strm[c]);
+        }
+    }
+
+    multiChannelDigest<N, h_width>(blk_strm, nblk_strm, end_nblk_strm, hash_strm, end_hash_strm);
 }
 
 } // namespace internal
 
-// 顶层接口
-template <int m_width>
+// 顶层接口，ROUNDS_PER_CYCLE 可选 1/2/4，取2或4时单块延迟降为约32/16拍
+template <int m_width, int ROUNDS_PER_CYCLE = 1>
 void sha224(hls::stream<ap_uint<m_width> >& msg_strm,
            hls::stream<ap_uint<64> >& len_strm,
            hls::stream<bool>& end_len_strm,
            hls::stream<ap_uint<224> >& hash_strm,
            hls::stream<bool>& end_hash_strm) {
     #pragma HLS INLINE off
-    internal::sha256_top<m_width, 224>(msg_strm, len_strm, end_len_strm, hash_strm, end_hash_strm);
+    internal::sha256_top<m_width, 224, ROUNDS_PER_CYCLE>(msg_strm, len_strm, end_len_strm, hash_strm, end_hash_strm);
 }
 
-template <int m_width>
+template <int m_width, int ROUNDS_PER_CYCLE = 1>
 void sha256(hls::stream<ap_uint<m_width> >& msg_strm,
            hls::stream<ap_uint<64> >& len_strm,
            hls::stream<bool>& end_len_strm,
            hls::stream<ap_uint<256> >& hash_strm,
            hls::stream<bool>& end_hash_strm) {
     #pragma HLS INLINE off
-    internal::sha256_top<m_width, 256>(msg_strm, len_strm, end_len_strm, hash_strm, end_hash_strm);
+    internal::sha256_top<m_width, 256, ROUNDS_PER_CYCLE>(msg_strm, len_strm, end_len_strm, hash_strm, end_hash_strm);
+}
+
+// 续算接口：每条消息为长消息的一个分段，从 init_state_strm 读入中间状态
+// {[319:256] 已处理字节数, [32i+31:32i] H[i]}，首段取IV且字节数为0；
+// final_strm 为假的分段长度须为64的整数倍，其中间状态写入 out_state_strm，
+// 最终分段按总长度填充并输出摘要；每个分段均写一次 end_hash_strm=false。
+// 硬件不检查分段长度：非最终分段若不是64的整数倍，其尾部字节会被当作下一分段的开头，
+// 此后的摘要均错误；C仿真中此情形触发 XF_SECURITY_ASSERT
+template <int m_width, int ROUNDS_PER_CYCLE = 1>
+void sha224(hls::stream<ap_uint<m_width> >& msg_strm,
+           hls::stream<ap_uint<64> >& len_strm,
+           hls::stream<bool>& end_len_strm,
+           hls::stream<ap_uint<320> >& init_state_strm,
+           hls::stream<bool>& final_strm,
+           hls::stream<ap_uint<224> >& hash_strm,
+           hls::stream<ap_uint<320> >& out_state_strm,
+           hls::stream<bool>& end_hash_strm) {
+    #pragma HLS INLINE off
+    internal::sha256_top<m_width, 224, ROUNDS_PER_CYCLE, internal::SHA256_RESUME_SEGMENT>(
+        msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, hash_strm, out_state_strm, end_hash_strm);
+}
+
+template <int m_width, int ROUNDS_PER_CYCLE = 1>
+void sha256(hls::stream<ap_uint<m_width> >& msg_strm,
+           hls::stream<ap_uint<64> >& len_strm,
+           hls::stream<bool>& end_len_strm,
+           hls::stream<ap_uint<320> >& init_state_strm,
+           hls::stream<bool>& final_strm,
+           hls::stream<ap_uint<256> >& hash_strm,
+           hls::stream<ap_uint<320> >& out_state_strm,
+           hls::stream<bool>& end_hash_strm) {
+    #pragma HLS INLINE off
+    internal::sha256_top<m_width, 256, ROUNDS_PER_CYCLE, internal::SHA256_RESUME_SEGMENT>(
+        msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, hash_strm, out_state_strm, end_hash_strm);
+}
+
+// 多通道顶层接口：N路独立的消息/长度流，协议与sha224/sha256相同，
+// 建议N不小于轮函数流水深度，以保证II=1
+template <int N, int m_width>
+void sha224MultiChannel(hls::stream<ap_uint<m_width> > msg_strm[N],
+                       hls::stream<ap_uint<64> > len_strm[N],
+                       hls::stream<bool> end_len_strm[N],
+                       hls::stream<ap_uint<224> > hash_strm[N],
+                       hls::stream<bool> end_hash_strm[N]) {
+    #pragma HLS INLINE off
+    internal::sha256MultiChannel_top<N, m_width, 224>(msg_strm, len_strm, end_len_strm, hash_strm, end_hash_strm);
+}
+
+template <int N, int m_width>
+void sha256MultiChannel(hls::stream<ap_uint<m_width> > msg_strm[N],
+                       hls::stream<ap_uint<64> > len_strm[N],
+                       hls::stream<bool> end_len_strm[N],
+                       hls::stream<ap_uint<256> > hash_strm[N],
+                       hls::stream<bool> end_hash_strm[N]) {
+    #pragma HLS INLINE off
+    internal::sha256MultiChannel_top<N, m_width, 256>(msg_strm, len_strm, end_len_strm, hash_strm, end_hash_strm);
 }
 
 } // namespace security
@@ -34,6 +34,8 @@
 #include <ap_int.h>
 #include <hls_stream.h>
 
+#include "xf_security/utils.hpp"
+
 // for debug
 #ifndef __SYNTHESIS__
 #include <iostream>
@@ -54,27 +56,40 @@ struct blockType {
  * The algorithm reference is : "Secure Hash Standard", which published by NIST in February 2012.
  * The optimization goal of this function is to yield a 1024-bit block per cycle.
  *
+ * When RESUME is true, a chaining state and a final flag are read for each message.
+ * The length appended in padding then counts the bytes already hashed in the state,
+ * and a non-final segment, whose length must be a multiple of 128, is emitted without padding.
+ *
  * @tparam w The bit width of each input message word, default value is 64.
+ * @tparam RESUME Whether each message starts from an intermediate chaining state.
  *
  * @param msg_strm The message being hashed.
  * @param len_strm The message length in byte.
  * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state {bytes hashed, H} to start from, only read when RESUME.
+ * @param final_strm The flag to signal that this segment ends the message, only read when RESUME.
  * @param blk_strm The 1024-bit hash block.
  * @param nblk_strm The number of hash block for this message.
  * @param end_nblk_strm End flag for number of hash block.
+ * @param state_fwd_strm The chaining state with updated byte count, forwarded to digest when RESUME.
+ * @param final_fwd_strm The final flag forwarded to digest when RESUME.
  *
  */
 
-template <unsigned int w>
+template <unsigned int w, bool RESUME>
 static void preProcessing(
     // inputs
     hls::stream<ap_uint<w> >& msg_strm,
     hls::stream<ap_uint<128> >& len_strm,
     hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<640> >& init_state_strm,
+    hls::stream<bool>& final_strm,
     // outputs
     hls::stream<blockType>& blk_strm,
     hls::stream<ap_uint<128> >& nblk_strm,
-    hls::stream<bool>& end_nblk_strm) {
+    hls::stream<bool>& end_nblk_strm,
+    hls::stream<ap_uint<640> >& state_fwd_strm,
+    hls::stream<bool>& final_fwd_strm) {
     bool endFlag = end_len_strm.read();
 
 LOOP_PREPROCESSING_MAIN:
@@ -83,11 +98,25 @@ LOOP_PREPROCESSING_MAIN:
         // read message length in byte
         ap_uint<128> len = len_strm.read();
 
+        // number of bytes hashed before this segment, and whether this segment is the last one
+        ap_uint<128> prefix = 0;
+        bool fin = true;
+        if (RESUME) {
+            ap_uint<640> st = init_state_strm.read();
+            fin = final_strm.read();
+            prefix = st.range(639, 512);
+            st.range(639, 512) = prefix + len;
+            state_fwd_strm.write(st);
+            final_fwd_strm.write(fin);
+        }
+        // a non-final segment is not padded, so a partial tail block would shift into the next segment
+        XF_SECURITY_ASSERT(fin || (len & 0x7f) == 0);
+
         // prepare message length in bit which will be appended at the tail of the block according to the standard
-        ap_uint<128> L = 8 * len;
+        ap_uint<128> L = 8 * (prefix + len);
 
         // total number blocks to digest in 1024-bit
-        ap_uint<128> blk_num = (len >> 7) + 1 + ((len & 0x7f) > 111);
+        ap_uint<128> blk_num = fin ? (ap_uint<128>)((len >> 7) + 1 + ((len & 0x7f) > 111)) : (ap_uint<128>)(len >> 7);
 
         // inform digest function
         nblk_strm.write(blk_num);
@@ -121,7 +150,9 @@ LOOP_PREPROCESSING_MAIN:
         // number of bytes left which needs to be padded as a new full block
         ap_uint<7> left = (ap_uint<7>)(len & 0x7fUL);
 
-        if (left == 0) {
+        if (!fin) {
+            // non-final segment, no padding
+        } else if (left == 0) {
             // end at block boundary, start with pad 1
             // last block
             blockType b;
@@ -639,23 +670,30 @@ LOOP_GEN_W_MAIN:
  *
  * @tparam w The bit width of each input message word, default value is 64.
  * @tparam hash_width The bit width of hash width, which depends on specific algorithm.
+ * @tparam RESUME Whether each message starts from an intermediate chaining state.
  *
  * @param w_strm Message schedule stream.
  * @param nblk_strm Number of message block stream.
  * @param end_nblk_strm End flag for number of message block stream.
+ * @param state_fwd_strm The chaining state to start from, only read when RESUME.
+ * @param final_fwd_strm The flag to signal the last segment, only read when RESUME.
  * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
  * @param end_digest_strm End flag for output digest stream.
  *
  */
 
-template <unsigned int w, unsigned int hash_width>
+template <unsigned int w, unsigned int hash_width, bool RESUME>
 void SHA512Digest(
     // inputs
     hls::stream<ap_uint<w> >& w_strm,
     hls::stream<ap_uint<128> >& nblk_strm,
     hls::stream<bool>& end_nblk_strm,
+    hls::stream<ap_uint<640> >& state_fwd_strm,
+    hls::stream<bool>& final_fwd_strm,
     // outputs
     hls::stream<ap_uint<hash_width> >& digest_strm,
+    hls::stream<ap_uint<640> >& out_state_strm,
     hls::stream<bool>& end_digest_strm) {
     // the eighty constant 64-bit words of SHA-384, SHA-512, and SHA-512/t
     static const ap_uint<w> K[80] = {
@@ -728,6 +766,19 @@ LOOP_SHA1_MAIN:
         }
 #pragma HLS array_partition variable = H complete
 
+        // resume from the chaining state of the previous segment
+        ap_uint<640> st = 0;
+        bool fin = true;
+        if (RESUME) {
+            st = state_fwd_strm.read();
+            fin = final_fwd_strm.read();
+        LOOP_SHA512_LOAD_STATE:
+            for (ap_uint<4> i = 0; i < 8; i++) {
+#pragma HLS unroll
+                H[i] = st.range(64 * i + 63, 64 * i);
+            }
+        }
+
         // total number blocks to digest
         ap_uint<128> blkNum = nblk_strm.read();
 
@@ -795,28 +846,38 @@ LOOP_SHA1_MAIN:
 #endif
         }
 
-        // emit digest
-        ap_uint<8 * w> digest;
-    LOOP_SHA512_EMIT:
-        for (ap_uint<4> i = 0; i < 8; i++) {
+        if (!fin) {
+            // emit chaining state of a non-final segment
+        LOOP_SHA512_SAVE_STATE:
+            for (ap_uint<4> i = 0; i < 8; i++) {
 #pragma HLS unroll
-            ap_uint<w> l = H[i];
-            // XXX shift algorithm's big-endian to HLS's little-endian
-            ap_uint<8> byte0 = ((l >> 56) & 0xff);
-            ap_uint<8> byte1 = ((l >> 48) & 0xff);
-            ap_uint<8> byte2 = ((l >> 40) & 0xff);
-            ap_uint<8> byte3 = ((l >> 32) & 0xff);
-            ap_uint<8> byte4 = ((l >> 24) & 0xff);
-            ap_uint<8> byte5 = ((l >> 16) & 0xff);
-            ap_uint<8> byte6 = ((l >> 8) & 0xff);
-            ap_uint<8> byte7 = (l & 0xff);
-            digest.range(w * i + w - 1, w * i) = ((ap_uint<w>)byte0) | (((ap_uint<w>)byte1) << 8) |
-                                                 (((ap_uint<w>)byte2) << 16) | (((ap_uint<w>)byte3) << 24) |
-                                                 (((ap_uint<w>)byte4) << 32) | (((ap_uint<w>)byte5) << 40) |
-                                                 (((ap_uint<w>)byte6) << 48) | (((ap_uint<w>)byte7) << 56);
+                st.range(64 * i + 63, 64 * i) = H[i];
+            }
+            out_state_strm.write(st);
+        } else {
+            // emit digest
+            ap_uint<8 * w> digest;
+        LOOP_SHA512_EMIT:
+            for (ap_uint<4> i = 0; i < 8; i++) {
+#pragma HLS unroll
+                ap_uint<w> l = H[i];
+                // XXX shift algorithm's big-endian to HLS's little-endian
+                ap_uint<8> byte0 = ((l >> 56) & 0xff);
+                ap_uint<8> byte1 = ((l >> 48) & 0xff);
+                ap_uint<8> byte2 = ((l >> 40) & 0xff);
+                ap_uint<8> byte3 = ((l >> 32) & 0xff);
+                ap_uint<8> byte4 = ((l >> 24) & 0xff);
+                ap_uint<8> byte5 = ((l >> 16) & 0xff);
+                ap_uint<8> byte6 = ((l >> 8) & 0xff);
+                ap_uint<8> byte7 = (l & 0xff);
+                digest.range(w * i + w - 1, w * i) = ((ap_uint<w>)byte0) | (((ap_uint<w>)byte1) << 8) |
+                                                     (((ap_uint<w>)byte2) << 16) | (((ap_uint<w>)byte3) << 24) |
+                                                     (((ap_uint<w>)byte4) << 32) | (((ap_uint<w>)byte5) << 40) |
+                                                     (((ap_uint<w>)byte6) << 48) | (((ap_uint<w>)byte7) << 56);
+            }
+            // obtain the digest by trancating the left-most hash_width bits of 512-bit hash value
+            digest_strm.write(digest.range(hash_width - 1, 0));
         }
-        // obtain the digest by trancating the left-most hash_width bits of 512-bit hash value
-        digest_strm.write(digest.range(hash_width - 1, 0));
         end_digest_strm.write(false);
 
         end = end_nblk_strm.read();
@@ -835,23 +896,30 @@ LOOP_SHA1_MAIN:
  *
  * @tparam w The bit width of each input message word, default value is 64.
  * @tparam hash_width The bit width of hash width, which depends on specific algorithm.
+ * @tparam RESUME Whether each message starts from an intermediate chaining state.
  *
  * @param msg_strm The message being hashed.
  * @param len_strm The message length in byte.
  * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state to start from, only read when RESUME.
+ * @param final_strm The flag to signal the last segment, only read when RESUME.
  * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
  * @param end_digest_strm End flag for output digest stream.
  *
  */
 
-template <unsigned int w, unsigned int hash_width>
+template <unsigned int w, unsigned int hash_width, bool RESUME>
 void sha512Top(
     // inputs
     hls::stream<ap_uint<w> >& msg_strm,
     hls::stream<ap_uint<128> >& len_strm,
     hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<640> >& init_state_strm,
+    hls::stream<bool>& final_strm,
     // outputs
     hls::stream<ap_uint<hash_width> >& digest_strm,
+    hls::stream<ap_uint<640> >& out_state_strm,
     hls::stream<bool>& end_digest_strm) {
 #pragma HLS dataflow
 
@@ -882,13 +950,22 @@ void sha512Top(
 #pragma HLS stream variable = end_nblk_strm2 depth = 32
 #pragma HLS resource variable = end_nblk_strm2 core = FIFO_LUTRAM
 
+    // chaining state and final flag bypassing the message schedule
+    hls::stream<ap_uint<640> > state_fwd_strm("state_fwd_strm");
+#pragma HLS stream variable = state_fwd_strm depth = 32
+#pragma HLS resource variable = state_fwd_strm core = FIFO_LUTRAM
+    hls::stream<bool> final_fwd_strm("final_fwd_strm");
+#pragma HLS stream variable = final_fwd_strm depth = 32
+#pragma HLS resource variable = final_fwd_strm core = FIFO_LUTRAM
+
     // message schedule stream
     hls::stream<ap_uint<w> > w_strm("w_strm");
 #pragma HLS stream variable = w_strm depth = 32
 #pragma HLS resource variable = w_strm core = FIFO_LUTRAM
 
     // padding and appending message words into blocks
-    preProcessing<w>(msg_strm, len_strm, end_len_strm, blk_strm, nblk_strm, end_nblk_strm);
+    preProcessing<w, RESUME>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, blk_strm, nblk_strm,
+                             end_nblk_strm, state_fwd_strm, final_fwd_strm);
 
     // duplicate number of block stream and its end flag stream
     dup_strm<128>(nblk_strm, end_nblk_strm, nblk_strm1, end_nblk_strm1, nblk_strm2, end_nblk_strm2);
@@ -897,7 +974,42 @@ void sha512Top(
     generateMsgSchedule<w>(blk_strm, nblk_strm1, end_nblk_strm1, w_strm);
 
     // digest precessing blocks into hash value
-    SHA512Digest<w, hash_width>(w_strm, nblk_strm2, end_nblk_strm2, digest_strm, end_digest_strm);
+    SHA512Digest<w, hash_width, RESUME>(w_strm, nblk_strm2, end_nblk_strm2, state_fwd_strm, final_fwd_strm,
+                                        digest_strm, out_state_strm, end_digest_strm);
+
+} // end sha512Top
+
+/**
+ *
+ * @brief Top function of SHA-512 starting from the initial hash value of each message.
+ *
+ * @tparam w The bit width of each input message word, default value is 64.
+ * @tparam hash_width The bit width of hash width, which depends on specific algorithm.
+ *
+ * @param msg_strm The message being hashed.
+ * @param len_strm The message length in byte.
+ * @param end_len_strm The flag to signal end of input message stream.
+ * @param digest_strm Output digest stream.
+ * @param end_digest_strm End flag for output digest stream.
+ *
+ */
+
+template <unsigned int w, unsigned int hash_width>
+void sha512Top(
+    // inputs
+    hls::stream<ap_uint<w> >& msg_strm,
+    hls::stream<ap_uint<128> >& len_strm,
+    hls::stream<bool>& end_len_strm,
+    // outputs
+    hls::stream<ap_uint<hash_width> >& digest_strm,
+    hls::stream<bool>& end_digest_strm) {
+    // chaining state streams are left unused
+    hls::stream<ap_uint<640> > init_state_strm("init_state_strm");
+    hls::stream<bool> final_strm("final_strm");
+    hls::stream<ap_uint<640> > out_state_strm("out_state_strm");
+
+    sha512Top<w, hash_width, false>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, digest_strm,
+                                    out_state_strm, end_digest_strm);
 
 } // end sha512Top
 
@@ -1333,6 +1445,126 @@ void sha512_t(
 
 } // end sha512_t
 
+/**
+ *
+ * @brief SHA-384 algorithm resuming from an intermediate chaining state.
+ *
+ * Each message is one segment of a longer message. It starts from the chaining state read from init_state_strm,
+ * which holds the number of bytes hashed so far in bits [639:512] and H[i] in bits [64i+63:64i].
+ * Use the SHA-384 initial hash value with zero bytes hashed for the first segment.
+ * A non-final segment must be a multiple of 128 bytes long, and its chaining state is written to out_state_strm.
+ * The final segment is padded with the total length and its digest is written to digest_strm.
+ * End flag false is written once per segment in either case.
+ * The segment length is not checked in hardware: the tail of a non-final segment that is not a whole number of
+ * blocks is taken as the head of the next segment and every later result is wrong. C simulation asserts on it.
+ *
+ * @tparam w The bit width of each input message word, default value is 64.
+ *
+ * @param msg_strm The message being hashed.
+ * @param len_strm The segment length in byte.
+ * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state to start from, one per segment.
+ * @param final_strm The flag to signal that this segment ends the message, one per segment.
+ * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
+ * @param end_digest_strm End flag for output digest stream.
+ *
+ */
+
+template <unsigned int w>
+void sha384(
+    // inputs
+    hls::stream<ap_uint<w> >& msg_strm,
+    hls::stream<ap_uint<128> >& len_strm,
+    hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<640> >& init_state_strm,
+    hls::stream<bool>& final_strm,
+    // outputs
+    hls::stream<ap_uint<384> >& digest_strm,
+    hls::stream<ap_uint<640> >& out_state_strm,
+    hls::stream<bool>& end_digest_strm) {
+    internal::sha512Top<w, 384, true>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, // input streams
+                                      digest_strm, out_state_strm, end_digest_strm);                 // output streams
+
+} // end sha384
+
+/**
+ *
+ * @brief SHA-512 algorithm resuming from an intermediate chaining state.
+ *
+ * The chaining state layout and segment rules are the same as the resumable sha384.
+ * Use the SHA-512 initial hash value for the first segment.
+ * Every non-final segment must be a multiple of 128 bytes long; this is only asserted in C simulation.
+ *
+ * @tparam w The bit width of each input message word, default value is 64.
+ *
+ * @param msg_strm The message being hashed.
+ * @param len_strm The segment length in byte.
+ * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state to start from, one per segment.
+ * @param final_strm The flag to signal that this segment ends the message, one per segment.
+ * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
+ * @param end_digest_strm End flag for output digest stream.
+ *
+ */
+
+template <unsigned int w>
+void sha512(
+    // inputs
+    hls::stream<ap_uint<w> >& msg_strm,
+    hls::stream<ap_uint<128> >& len_strm,
+    hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<640> >& init_state_strm,
+    hls::stream<bool>& final_strm,
+    // outputs
+    hls::stream<ap_uint<512> >& digest_strm,
+    hls::stream<ap_uint<640> >& out_state_strm,
+    hls::stream<bool>& end_digest_strm) {
+    internal::sha512Top<w, 512, true>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, // input streams
+                                      digest_strm, out_state_strm, end_digest_strm);                 // output streams
+
+} // end sha512
+
+/**
+ *
+ * @brief SHA-512/t algorithm resuming from an intermediate chaining state.
+ *
+ * The chaining state layout and segment rules are the same as the resumable sha384.
+ * Use the SHA-512/t initial hash value for the first segment.
+ * Every non-final segment must be a multiple of 128 bytes long; this is only asserted in C simulation.
+ *
+ * @tparam w The bit width of each input message word, default value is 64.
+ * @tparam t The bit width of the digest which depends on specific algorithm, typically is 224 or 256.
+ *
+ * @param msg_strm The message being hashed.
+ * @param len_strm The segment length in byte.
+ * @param end_len_strm The flag to signal end of input message stream.
+ * @param init_state_strm The chaining state to start from, one per segment.
+ * @param final_strm The flag to signal that this segment ends the message, one per segment.
+ * @param digest_strm Output digest stream.
+ * @param out_state_strm Output chaining state of a non-final segment.
+ * @param end_digest_strm End flag for output digest stream.
+ *
+ */
+
+template <unsigned int w, unsigned int t>
+void sha512_t(
+    // inputs
+    hls::stream<ap_uint<w> >& msg_strm,
+    hls::stream<ap_uint<128> >& len_strm,
+    hls::stream<bool>& end_len_strm,
+    hls::stream<ap_uint<640> >& init_state_strm,
+    hls::stream<bool>& final_strm,
+    // outputs
+    hls::stream<ap_uint<t> >& digest_strm,
+    hls::stream<ap_uint<640> >& out_state_strm,
+    hls::stream<bool>& end_digest_strm) {
+    internal::sha512Top<w, t, true>(msg_strm, len_strm, end_len_strm, init_state_strm, final_strm, // input streams
+                                    digest_strm, out_state_strm, end_digest_strm);                 // output streams
+
+} // end sha512_t
+
 /**
  * @brief SHA384 + HMAC-SHA384.
  *
@@ -26,6 +26,7 @@
 #include <ap_int.h>
 #include "xf_security/ecc.hpp"
 #include "xf_security/types.hpp"
+#include "xf_security/utils.hpp"
 
 namespace xf {
 namespace security {
@@ -40,15 +41,35 @@ struct sm3BlkPack {
     }
 };
 
+// When RESUME, each message is a segment starting from state {bits hashed, V} in initStateStrm.
+// Only the final segment is padded, non-final ones must be a multiple of 512 bits.
+template <bool RESUME>
 static void sm3Packing(hls::stream<ap_uint<64> >& msgStrm,
                        hls::stream<ap_uint<64> >& lenStrm,
                        hls::stream<bool>& endLenStrm,
+                       hls::stream<ap_uint<320> >& initStateStrm,
+                       hls::stream<bool>& finalStrm,
                        hls::stream<sm3BlkPack>& packStrm,
                        hls::stream<ap_uint<64> >& numPackStrm,
-                       hls::stream<bool>& endNumPackStrm) {
+                       hls::stream<bool>& endNumPackStrm,
+                       hls::stream<ap_uint<320> >& stateFwdStrm,
+                       hls::stream<bool>& finalFwdStrm) {
     while (!endLenStrm.read()) {
         ap_uint<64> len = lenStrm.read();
-        ap_uint<64> numPack = (len >> 9) + 1 + ((len & 0x1ff) > 447);
+        ap_uint<64> prefix = 0;
+        bool fin = true;
+        if (RESUME) {
+            ap_uint<320> st = initStateStrm.read();
+            fin = finalStrm.read();
+            prefix = st.range(319, 256);
+            st.range(319, 256) = prefix + len;
+            stateFwdStrm.write(st);
+            finalFwdStrm.write(fin);
+        }
+        // a non-final segment is not padded, so a partial tail block would shift into the next segment
+        XF_SECURITY_ASSERT(fin || (len & 0x1ff) == 0);
+        ap_uint<64> total = prefix + len;
+        ap_uint<64> numPack = fin ? (ap_uint<64>)((len >> 9) + 1 + ((len & 0x1ff) > 447)) : (ap_uint<64>)(len >> 9);
         numPackStrm.write(numPack);
         endNumPackStrm.write(false);
         for (ap_uint<64> i = 0; i < ap_uint<64>(len >> 9); i++) {
@@ -69,43 +90,45 @@ static void sm3Packing(hls::stream<ap_uint<64> >& msgStrm,
                 }
             }
         }
-        // last pack
-        ap_uint<10> left = len.range(8, 0);
-        sm3BlkPack blkPack;
-        for (ap_uint<10> i = 0; i < 512; i += 64) {
-            if (i < left) {
-                ap_uint<10> ii = (i >> 5);
-                uint64_t ll = msgStrm.read().to_uint64();
-                uint32_t l = ll & 0xffffffffUL;
-                l = ((0x000000ffUL & l) << 24) | ((0x0000ff00UL & l) << 8) | ((0x00ff0000UL & l) >> 8) |
-                    ((0xff000000UL & l) >> 24);
-                blkPack.M[ii] = l;
-                l = (ll >> 32) & 0xffffffffUL;
-                l = ((0x000000ffUL & l) << 24) | ((0x0000ff00UL & l) << 8) | ((0x00ff0000UL & l) >> 8) |
-                    ((0xff000000UL & l) >> 24);
-                blkPack.M[ii + 1] = l;
-            } else {
-                ap_uint<10> ii = (i >> 5);
-                blkPack.M[ii] = 0;
-                blkPack.M[ii + 1] = 0;
+        // last pack, non-final segment ends at block boundary without padding
+        if (fin) {
+            ap_uint<10> left = len.range(8, 0);
+            sm3BlkPack blkPack;
+            for (ap_uint<10> i = 0; i < 512; i += 64) {
+                if (i < left) {
+                    ap_uint<10> ii = (i >> 5);
+                    uint64_t ll = msgStrm.read().to_uint64();
+                    uint32_t l = ll & 0xffffffffUL;
+                    l = ((0x000000ffUL & l) << 24) | ((0x0000ff00UL & l) << 8) | ((0x00ff0000UL & l) >> 8) |
+                        ((0xff000000UL & l) >> 24);
+                    blkPack.M[ii] = l;
+                    l = (ll >> 32) & 0xffffffffUL;
+                    l = ((0x000000ffUL & l) << 24) | ((0x0000ff00UL & l) << 8) | ((0x00ff0000UL & l) >> 8) |
+                        ((0xff000000UL & l) >> 24);
+                    blkPack.M[ii + 1] = l;
+                } else {
+                    ap_uint<10> ii = (i >> 5);
+                    blkPack.M[ii] = 0;
+                    blkPack.M[ii + 1] = 0;
+                }
             }
-        }
-        ap_uint<4> ptr = left >> 5;
-        ap_uint<5> res = left & 0x1f;
-        blkPack.M[ptr] |= (1 << (31 - res));
-        if (left < 448) {
-            blkPack.M[14] = len.range(63, 32);
-            blkPack.M[15] = len.range(31, 0);
-            packStrm.write(blkPack);
-        } else {
-            packStrm.write(blkPack);
-            for (int i = 0; i < 14; i++) {
+            ap_uint<4> ptr = left >> 5;
+            ap_uint<5> res = left & 0x1f;
+            blkPack.M[ptr] |= (1 << (31 - res));
+            if (left < 448) {
+                blkPack.M[14] = total.range(63, 32);
+                blkPack.M[15] = total.range(31, 0);
+                packStrm.write(blkPack);
+            } else {
+                packStrm.write(blkPack);
+                for (int i = 0; i < 14; i++) {
 #pragma HLS unroll
-                blkPack.M[i] = 0;
+                    blkPack.M[i] = 0;
+                }
+                blkPack.M[14] = total.range(63, 32);
+                blkPack.M[15] = total.range(31, 0);
+                packStrm.write(blkPack);
             }
-            blkPack.M[14] = len.range(63, 32);
-            blkPack.M[15] = len.range(31, 0);
-            packStrm.write(blkPack);
         }
     }
     endNumPackStrm.write(true);
@@ -168,10 +191,15 @@ static ap_uint<32> sm3ByteShift(ap_uint<32> x) {
     return res;
 }
 
+// When RESUME, V is loaded from stateFwdStrm, and a non-final segment writes V to outStateStrm instead of digest.
+template <bool RESUME>
 static void sm3Expand(hls::stream<sm3BlkPack>& packStrm,
                       hls::stream<ap_uint<64> >& numPackStrm,
                       hls::stream<bool>& endNumPackStrm,
+                      hls::stream<ap_uint<320> >& stateFwdStrm,
+                      hls::stream<bool>& finalFwdStrm,
                       hls::stream<ap_uint<256> >& digestStrm,
+                      hls::stream<ap_uint<320> >& outStateStrm,
                       hls::stream<bool>& endDigestStrm) {
     while (!endNumPackStrm.read()) {
         ap_uint<64> numPack = numPackStrm.read();
@@ -183,6 +211,20 @@ static void sm3Expand(hls::stream<sm3BlkPack>& packStrm,
         ap_uint<32> regF = ap_uint<32>("0x163138aa");
         ap_uint<32> regG = ap_uint<32>("0xe38dee4d");
         ap_uint<32> regH = ap_uint<32>("0xb0fb0e4e");
+        ap_uint<320> st = 0;
+        bool fin = true;
+        if (RESUME) {
+            st = stateFwdStrm.read();
+            fin = finalFwdStrm.read();
+            regA = st.range(31, 0);
+            regB = st.range(63, 32);
+            regC = st.range(95, 64);
+            regD = st.range(127, 96);
+            regE = st.range(159, 128);
+            regF = st.range(191, 160);
+            regG = st.range(223, 192);
+            regH = st.range(255, 224);
+        }
         ap_uint<32> recA = regA;
         ap_uint<32> recB = regB;
         ap_uint<32> recC = regC;
@@ -250,21 +292,65 @@ static void sm3Expand(hls::stream<sm3BlkPack>& packStrm,
                 }
             }
         }
-        ap_uint<256> digest;
-        digest.range(31, 0) = sm3ByteShift(regA);
-        digest.range(63, 32) = sm3ByteShift(regB);
-        digest.range(95, 64) = sm3ByteShift(regC);
-        digest.range(127, 96) = sm3ByteShift(regD);
-        digest.range(159, 128) = sm3ByteShift(regE);
-        digest.range(191, 160) = sm3ByteShift(regF);
-        digest.range(223, 192) = sm3ByteShift(regG);
-        digest.range(255, 224) = sm3ByteShift(regH);
-        digestStrm.write(digest);
+        if (!fin) {
+            st.range(31, 0) = regA;
+            st.range(63, 32) = regB;
+            st.range(95, 64) = regC;
+            st.range(127, 96) = regD;
+            st.range(159, 128) = regE;
+            st.range(191, 160) = regF;
+            st.range(223, 192) = regG;
+            st.range(255, 224) = regH;
+            outStateStrm.write(st);
+        } else {
+            ap_uint<256> digest;
+            digest.range(31, 0) = sm3ByteShift(regA);
+            digest.range(63, 32) = sm3ByteShift(regB);
+            digest.range(95, 64) = sm3ByteShift(regC);
+            digest.range(127, 96) = sm3ByteShift(regD);
+            digest.range(159, 128) = sm3ByteShift(regE);
+            digest.range(191, 160) = sm3ByteShift(regF);
+            digest.range(223, 192) = sm3ByteShift(regG);
+            digest.range(255, 224) = sm3ByteShift(regH);
+            digestStrm.write(digest);
+        }
         endDigestStrm.write(false);
     }
     endDigestStrm.write(true);
 }
 
+template <bool RESUME>
+void sm3Top(hls::stream<ap_uint<64> >& msgStrm,
+            hls::stream<ap_uint<64> >& lenStrm,
+            hls::stream<bool>& endLenStrm,
+            hls::stream<ap_uint<320> >& initStateStrm,
+            hls::stream<bool>& finalStrm,
+            hls::stream<ap_uint<256> >& hashStrm,
+            hls::stream<ap_uint<320> >& outStateStrm,
+            hls::stream<bool>& endHashStrm) {
+#pragma HLS dataflow
+    hls::stream<sm3BlkPack> packStrm;
+#pragma HLS stream variable = packStrm depth = 4
+#pragma HLS resource variable = packStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<64> > numPackStrm;
+#pragma HLS stream variable = numPackStrm depth = 4
+#pragma HLS resource variable = numPackStrm core = FIFO_LUTRAM
+    hls::stream<bool> endNumPackStrm;
+#pragma HLS stream variable = endNumPackStrm depth = 4
+#pragma HLS resource variable = endNumPackStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<320> > stateFwdStrm;
+#pragma HLS stream variable = stateFwdStrm depth = 4
+#pragma HLS resource variable = stateFwdStrm core = FIFO_LUTRAM
+    hls::stream<bool> finalFwdStrm;
+#pragma HLS stream variable = finalFwdStrm depth = 4
+#pragma HLS resource variable = finalFwdStrm core = FIFO_LUTRAM
+
+    sm3Packing<RESUME>(msgStrm, lenStrm, endLenStrm, initStateStrm, finalStrm, packStrm, numPackStrm, endNumPackStrm,
+                       stateFwdStrm, finalFwdStrm);
+    sm3Expand<RESUME>(packStrm, numPackStrm, endNumPackStrm, stateFwdStrm, finalFwdStrm, hashStrm, outStateStrm,
+                      endHashStrm);
+}
+
 template <int k>
 uint32_t sm4LSH(uint32_t x) {
 #pragma HLS inline
@@ -412,19 +498,38 @@ void sm3(hls::stream<ap_uint<64> >& msgStrm,
          hls::stream<bool>& endLenStrm,
          hls::stream<ap_uint<256> >& hashStrm,
          hls::stream<bool>& endHashStrm) {
-#pragma HLS dataflow
-    hls::stream<xf::security::internal::sm3BlkPack> packStrm;
-#pragma HLS stream variable = packStrm depth = 4
-#pragma HLS resource variable = packStrm core = FIFO_LUTRAM
-    hls::stream<ap_uint<64> > numPackStrm;
-#pragma HLS stream variable = numPackStrm depth = 4
-#pragma HLS resource variable = numPackStrm core = FIFO_LUTRAM
-    hls::stream<bool> endNumPackStrm;
-#pragma HLS stream variable = endNumPackStrm depth = 4
-#pragma HLS resource variable = endNumPackStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<320> > initStateStrm;
+    hls::stream<bool> finalStrm;
+    hls::stream<ap_uint<320> > outStateStrm;
+
+    xf::security::internal::sm3Top<false>(msgStrm, lenStrm, endLenStrm, initStateStrm, finalStrm, hashStrm,
+                                          outStateStrm, endHashStrm);
+}
 
-    xf::security::internal::sm3Packing(msgStrm, lenStrm, endLenStrm, packStrm, numPackStrm, endNumPackStrm);
-    xf::security::internal::sm3Expand(packStrm, numPackStrm, endNumPackStrm, hashStrm, endHashStrm);
+/**
+ * @brief SM3 function resuming from an intermediate state, to hash a long message in segments.
+ * @param msgStrm Stream to input messages to be signed.
+ * @param lenStrm Stream to input length of input segments in bits.
+ * @param endLenStrm Stream of end flag of lenStrm.
+ * @param initStateStrm Stream to input state of each segment, bits hashed so far in [319:256] and V[i] in
+ * [32i+31:32i]. The first segment starts from the IV with zero bits hashed.
+ * @param finalStrm Stream to input whether each segment ends its message. Non-final segments must be a multiple of
+ * 512 bits long. This is not checked in hardware, where a partial tail block would be taken as the head of the next
+ * segment; C simulation asserts on it.
+ * @param hashStrm Stream to output digests of final segments.
+ * @param outStateStrm Stream to output state of non-final segments.
+ * @param endHashStrm Stream of end flag of hashStrm, false is written once per segment.
+ */
+void sm3(hls::stream<ap_uint<64> >& msgStrm,
+         hls::stream<ap_uint<64> >& lenStrm,
+         hls::stream<bool>& endLenStrm,
+         hls::stream<ap_uint<320> >& initStateStrm,
+         hls::stream<bool>& finalStrm,
+         hls::stream<ap_uint<256> >& hashStrm,
+         hls::stream<ap_uint<320> >& outStateStrm,
+         hls::stream<bool>& endHashStrm) {
+    xf::security::internal::sm3Top<true>(msgStrm, lenStrm, endLenStrm, initStateStrm, finalStrm, hashStrm,
+                                         outStateStrm, endHashStrm);
 }
 
 /**
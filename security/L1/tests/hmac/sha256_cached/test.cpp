@@ -0,0 +1,180 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// the size of each message word in byte
+#define MSG_SIZE 4
+// the size of the digest in byte
+#define HASH_SIZE 32
+#define KEYL 32
+// number of entries in the key-state table
+#define KEY_NUM 4
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/hmac.hpp"
+#include "xf_security/sha224_256.hpp"
+
+#define LENW 64
+#define KEYW (8 * MSG_SIZE)
+#define MSGW (8 * MSG_SIZE)
+#define HSHW (8 * HASH_SIZE)
+#define BLOCK_SIZE 64
+
+typedef ap_uint<64> u64;
+
+template <int msgW, int lW, int hshW>
+struct sha256_wrapper {
+    static void hash(hls::stream<ap_uint<msgW> >& msgStrm,
+                     hls::stream<u64>& lenStrm,
+                     hls::stream<bool>& eLenStrm,
+                     hls::stream<ap_uint<256> >& hshStrm,
+                     hls::stream<bool>& eHshStrm) {
+        xf::security::sha256<msgW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+
+// install the keys, then MAC the messages with the cached states
+void test_hmac_sha256_cached(hls::stream<ap_uint<KEYW> >& keyStrm,
+                             hls::stream<ap_uint<16> >& keyIdStrm,
+                             hls::stream<bool>& eKeyStrm,
+                             hls::stream<ap_uint<MSGW> >& msgStrm,
+                             hls::stream<u64>& lenStrm,
+                             hls::stream<ap_uint<16> >& msgKeyIdStrm,
+                             hls::stream<bool>& eLenStrm,
+                             hls::stream<ap_uint<HSHW> >& hshStrm,
+                             hls::stream<bool>& eHshStrm) {
+    ap_uint<512> keyState[KEY_NUM];
+    xf::security::hmacSha256SetKey<KEYW, KEYL, KEY_NUM>(keyStrm, keyIdStrm, eKeyStrm, keyState);
+    xf::security::hmacSha256Cached<MSGW, LENW, KEY_NUM>(keyState, msgStrm, lenStrm, msgKeyIdStrm, eLenStrm, hshStrm,
+                                                        eHshStrm);
+}
+
+template <int W>
+void string2Strm(const std::string& data, hls::stream<ap_uint<W> >& strm) {
+    for (std::string::size_type i = 0; i < data.length(); i += W / 8) {
+        ap_uint<W> oneWord = 0;
+        for (std::string::size_type n = 0; n < W / 8 && i + n < data.length(); n++)
+            oneWord.range(7 + 8 * n, 8 * n) = (unsigned char)data[i + n];
+        strm.write(oneWord);
+    }
+}
+
+std::string hash2str(const ap_uint<HSHW>& h) {
+    std::ostringstream oss;
+    oss << std::hex;
+    for (int i = 0; i < HASH_SIZE; i++) oss << std::setw(2) << std::setfill('0') << h.range(7 + 8 * i, 8 * i).to_uint();
+    return oss.str();
+}
+
+int main() {
+    std::cout << "********************************" << std::endl;
+    std::cout << "   Testing cached hmac+SHA256   " << std::endl;
+    std::cout << "********************************" << std::endl;
+
+    const char message[] =
+        "The quick brown fox jumps over the lazy dog. Its hmac is 80070713463e7749b90c2dc24911e275"
+        "The quick brown fox jumps over the lazy dog. Its hmac is 80070713463e7749b90c2dc24911e275"
+        "The quick brown fox jumps over the lazy dog.";
+    // lengths around the one-block and two-block padding boundaries
+    const unsigned int lens[] = {0, 1, 55, 56, 63, 64, 65, 119, 120, 200};
+    const unsigned int nmsg = sizeof(lens) / sizeof(lens[0]);
+
+    std::vector<std::string> keys;
+    for (unsigned int k = 0; k < KEY_NUM; k++) {
+        std::string key(KEYL, 0);
+        for (unsigned int i = 0; i < KEYL; i++) key[i] = (char)(0x11 * (k + 1) + 7 * i);
+        keys.push_back(key);
+    }
+
+    hls::stream<ap_uint<KEYW> > keyStrm("keyStrm");
+    hls::stream<ap_uint<16> > keyIdStrm("keyIdStrm");
+    hls::stream<bool> eKeyStrm("eKeyStrm");
+    hls::stream<ap_uint<MSGW> > msgStrm("msgStrm");
+    hls::stream<u64> lenStrm("lenStrm");
+    hls::stream<ap_uint<16> > msgKeyIdStrm("msgKeyIdStrm");
+    hls::stream<bool> eLenStrm("eLenStrm");
+    hls::stream<ap_uint<HSHW> > hshStrm("hshStrm");
+    hls::stream<bool> eHshStrm("eHshStrm");
+
+    // reference: the uncached hmac on the same key and message
+    hls::stream<ap_uint<KEYW> > refKeyStrm("refKeyStrm");
+    hls::stream<ap_uint<MSGW> > refMsgStrm("refMsgStrm");
+    hls::stream<u64> refLenStrm("refLenStrm");
+    hls::stream<bool> refELenStrm("refELenStrm");
+    hls::stream<ap_uint<HSHW> > refHshStrm("refHshStrm");
+    hls::stream<bool> refEHshStrm("refEHshStrm");
+
+    // install the keys in reverse slot order
+    for (unsigned int k = 0; k < KEY_NUM; k++) {
+        string2Strm<KEYW>(keys[k], keyStrm);
+        keyIdStrm.write(KEY_NUM - 1 - k);
+        eKeyStrm.write(false);
+    }
+    eKeyStrm.write(true);
+
+    for (unsigned int i = 0; i < nmsg; i++) {
+        unsigned int k = (i * 3) % KEY_NUM;
+        std::string msg(message, lens[i]);
+        string2Strm<MSGW>(msg, msgStrm);
+        lenStrm.write(lens[i]);
+        msgKeyIdStrm.write(KEY_NUM - 1 - k);
+        eLenStrm.write(false);
+
+        string2Strm<KEYW>(keys[k], refKeyStrm);
+        string2Strm<MSGW>(msg, refMsgStrm);
+        refLenStrm.write(lens[i]);
+        refELenStrm.write(false);
+    }
+    eLenStrm.write(true);
+    refELenStrm.write(true);
+
+    test_hmac_sha256_cached(keyStrm, keyIdStrm, eKeyStrm, msgStrm, lenStrm, msgKeyIdStrm, eLenStrm, hshStrm,
+                            eHshStrm);
+    xf::security::hmac<MSGW, LENW, HSHW, KEYL, BLOCK_SIZE, sha256_wrapper>(refKeyStrm, refMsgStrm, refLenStrm,
+                                                                           refELenStrm, refHshStrm, refEHshStrm);
+
+    unsigned int nerror = 0;
+    for (unsigned int i = 0; i < nmsg; i++) {
+        ap_uint<HSHW> digest = hshStrm.read();
+        ap_uint<HSHW> golden = refHshStrm.read();
+        if (eHshStrm.read() || refEHshStrm.read() || digest != golden) {
+            ++nerror;
+            std::cout << "len " << std::dec << lens[i] << std::endl;
+            std::cout << "fpga   : " << hash2str(digest) << std::endl;
+            std::cout << "golden : " << hash2str(golden) << std::endl;
+        }
+    }
+    if (!eHshStrm.read() || !refEHshStrm.read() || !hshStrm.empty() || !msgStrm.empty() || !keyStrm.empty()) {
+        ++nerror;
+        std::cout << "unexpected data left in the streams" << std::endl;
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << std::dec << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << std::dec << nmsg << " inputs verified, no error found." << std::endl;
+    }
+
+    return nerror;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Hash a different message on every channel of the multi-channel SHA-256 and
+// SHA-224, so that the channels finish their messages on different blocks, and
+// check every digest against a known answer. The lengths 0, 55, 56, 64 and 119
+// bytes cover the one and two block paddings on both sides of the 56 byte limit.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/sha224_256.hpp"
+
+#define CH 5
+#define MSGW 32
+#define NUM_MSG 2
+
+void test_sha256_multichannel(hls::stream<ap_uint<MSGW> > msgStrm[CH],
+                              hls::stream<ap_uint<64> > lenStrm[CH],
+                              hls::stream<bool> eLenStrm[CH],
+                              hls::stream<ap_uint<256> > hshStrm[CH],
+                              hls::stream<bool> eHshStrm[CH]) {
+    xf::security::sha256MultiChannel<CH, MSGW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+}
+
+template <int HW>
+struct Hasher;
+
+template <>
+struct Hasher<256> {
+    static void run(hls::stream<ap_uint<MSGW> > msgStrm[CH],
+                    hls::stream<ap_uint<64> > lenStrm[CH],
+                    hls::stream<bool> eLenStrm[CH],
+                    hls::stream<ap_uint<256> > hshStrm[CH],
+                    hls::stream<bool> eHshStrm[CH]) {
+        test_sha256_multichannel(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+
+template <>
+struct Hasher<224> {
+    static void run(hls::stream<ap_uint<MSGW> > msgStrm[CH],
+                    hls::stream<ap_uint<64> > lenStrm[CH],
+                    hls::stream<bool> eLenStrm[CH],
+                    hls::stream<ap_uint<224> > hshStrm[CH],
+                    hls::stream<bool> eHshStrm[CH]) {
+        xf::security::sha224MultiChannel<CH, MSGW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+
+void pushMsg(const unsigned char* msg, unsigned int len, hls::stream<ap_uint<MSGW> >& strm) {
+    for (unsigned int i = 0; i < len; i += MSGW / 8) {
+        ap_uint<MSGW> w = 0;
+        for (unsigned int b = 0; b < MSGW / 8 && i + b < len; b++) w.range(8 * b + 7, 8 * b) = msg[i + b];
+        strm.write(w);
+    }
+}
+
+template <int HW>
+std::string hash2str(const ap_uint<HW>& h) {
+    std::ostringstream oss;
+    oss << std::hex;
+    for (int i = 0; i < HW / 8; i++) oss << std::setw(2) << std::setfill('0') << h.range(7 + 8 * i, 8 * i).to_uint();
+    return oss.str();
+}
+
+// channel c hashes the prefixes lens[(c + m) % CH] for m = 0 .. NUM_MSG - 1
+template <int HW>
+unsigned int checkChannels(const unsigned char* msg, const unsigned int lens[CH], const std::string golden[CH]) {
+    unsigned int nerror = 0;
+    hls::stream<ap_uint<MSGW> > msgStrm[CH];
+    hls::stream<ap_uint<64> > lenStrm[CH];
+    hls::stream<bool> eLenStrm[CH];
+    hls::stream<ap_uint<HW> > hshStrm[CH];
+    hls::stream<bool> eHshStrm[CH];
+
+    for (int c = 0; c < CH; c++) {
+        for (int m = 0; m < NUM_MSG; m++) {
+            unsigned int len = lens[(c + m) % CH];
+            pushMsg(msg, len, msgStrm[c]);
+            lenStrm[c].write(len);
+            eLenStrm[c].write(false);
+        }
+        eLenStrm[c].write(true);
+    }
+
+    Hasher<HW>::run(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+
+    for (int c = 0; c < CH; c++) {
+        for (int m = 0; m < NUM_MSG; m++) {
+            int k = (c + m) % CH;
+            if (eHshStrm[c].read()) {
+                ++nerror;
+                std::cout << "SHA-" << HW << " channel " << c << ": missing digest " << m << std::endl;
+                break;
+            }
+            std::string digest = hash2str<HW>(hshStrm[c].read());
+            if (digest != golden[k]) {
+                ++nerror;
+                std::cout << "SHA-" << HW << " channel " << c << ", " << lens[k] << " bytes: " << digest
+                          << ", golden: " << golden[k] << std::endl;
+            }
+        }
+        if (!eHshStrm[c].read() || !hshStrm[c].empty() || !eHshStrm[c].empty() || !msgStrm[c].empty()) {
+            ++nerror;
+            std::cout << "SHA-" << HW << " channel " << c << ": unexpected data left in the streams" << std::endl;
+        }
+    }
+    return nerror;
+}
+
+int main() {
+    const unsigned int lens[CH] = {0, 55, 56, 64, 119};
+    // digests of the first lens[k] bytes of the message below
+    const std::string golden256[CH] = {"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+                                       "e7313d333c272e639f790978283f9eb392e843d0f29b7016828bb1daa4aac70b",
+                                       "4324d65f3c103567f5589c710bc08f8523f929a9272e3af36fc968e52abc6c27",
+                                       "39e3d7b6b5d075d37d053ad89b24b41bef4f3c29760c84447cab3f3be1882241",
+                                       "9ce7368e4daf32341631b492e80359dc9f594b48453cd0dd5bf0b19279cc177e"};
+    const std::string golden224[CH] = {"d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f",
+                                       "703a7d6e61c83903b5db54ddf6dda2268211b47c90bbdac2ed306d8a",
+                                       "850fef35478d7a94a417713dbded4a39c18be2b40e6f20f47066d306",
+                                       "e480c1c21ffd3f109fc0cde0daf967c748932b64f8e259d98db17420",
+                                       "6c9c99e7d1090cb995200ccc9fc757a4383d3a1004cc36bc266c7947"};
+    unsigned char msg[119];
+    for (int i = 0; i < 119; i++) msg[i] = (unsigned char)(i * 7 + 3);
+
+    unsigned int nerror = checkChannels<256>(msg, lens, golden256);
+    nerror += checkChannels<224>(msg, lens, golden224);
+
+    if (nerror) {
+        std::cout << "FAIL: " << std::dec << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << std::dec << 2 * CH * NUM_MSG << " digests verified, no error found." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Hash messages on both sides of the 55/56 byte padding limit and of the
+// 64 byte block boundary through SHA-256 with 2 and 4 rounds per cycle, and
+// check every digest against a known answer.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/sha224_256.hpp"
+
+#define NUM_MSG 10
+#define MAX_LEN 128
+
+void test_sha256_rounds(hls::stream<ap_uint<32> >& msgStrm,
+                        hls::stream<ap_uint<64> >& lenStrm,
+                        hls::stream<bool>& eLenStrm,
+                        hls::stream<ap_uint<256> >& hshStrm,
+                        hls::stream<bool>& eHshStrm) {
+    xf::security::sha256<32, 2>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+}
+
+template <int MSGW, int RPC>
+struct Hasher {
+    static void run(hls::stream<ap_uint<MSGW> >& msgStrm,
+                    hls::stream<ap_uint<64> >& lenStrm,
+                    hls::stream<bool>& eLenStrm,
+                    hls::stream<ap_uint<256> >& hshStrm,
+                    hls::stream<bool>& eHshStrm) {
+        xf::security::sha256<MSGW, RPC>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+
+template <>
+struct Hasher<32, 2> {
+    static void run(hls::stream<ap_uint<32> >& msgStrm,
+                    hls::stream<ap_uint<64> >& lenStrm,
+                    hls::stream<bool>& eLenStrm,
+                    hls::stream<ap_uint<256> >& hshStrm,
+                    hls::stream<bool>& eHshStrm) {
+        test_sha256_rounds(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+
+template <int MSGW>
+void pushMsg(const unsigned char* msg, unsigned int len, hls::stream<ap_uint<MSGW> >& strm) {
+    for (unsigned int i = 0; i < len; i += MSGW / 8) {
+        ap_uint<MSGW> w = 0;
+        for (unsigned int b = 0; b < MSGW / 8 && i + b < len; b++) w.range(8 * b + 7, 8 * b) = msg[i + b];
+        strm.write(w);
+    }
+}
+
+std::string hash2str(const ap_uint<256>& h) {
+    std::ostringstream oss;
+    oss << std::hex;
+    for (int i = 0; i < 32; i++) oss << std::setw(2) << std::setfill('0') << h.range(7 + 8 * i, 8 * i).to_uint();
+    return oss.str();
+}
+
+// hashes every prefix lens[k] of the message in one call and compares with golden[k]
+template <int MSGW, int RPC>
+unsigned int checkLengths(const unsigned char* msg,
+                          const unsigned int lens[NUM_MSG],
+                          const std::string golden[NUM_MSG]) {
+    unsigned int nerror = 0;
+    hls::stream<ap_uint<MSGW> > msgStrm("msgStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> eLenStrm("eLenStrm");
+    hls::stream<ap_uint<256> > hshStrm("hshStrm");
+    hls::stream<bool> eHshStrm("eHshStrm");
+
+    for (int k = 0; k < NUM_MSG; k++) {
+        pushMsg<MSGW>(msg, lens[k], msgStrm);
+        lenStrm.write(lens[k]);
+        eLenStrm.write(false);
+    }
+    eLenStrm.write(true);
+
+    Hasher<MSGW, RPC>::run(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+
+    for (int k = 0; k < NUM_MSG; k++) {
+        if (eHshStrm.read()) {
+            ++nerror;
+            std::cout << "sha256<" << MSGW << ", " << RPC << ">: missing digest " << k << std::endl;
+            break;
+        }
+        std::string digest = hash2str(hshStrm.read());
+        if (digest != golden[k]) {
+            ++nerror;
+            std::cout << "sha256<" << MSGW << ", " << RPC << ">, " << lens[k] << " bytes: " << digest
+                      << ", golden: " << golden[k] << std::endl;
+        }
+    }
+    if (!eHshStrm.read() || !hshStrm.empty() || !eHshStrm.empty() || !msgStrm.empty()) {
+        ++nerror;
+        std::cout << "sha256<" << MSGW << ", " << RPC << ">: unexpected data left in the streams" << std::endl;
+    }
+    return nerror;
+}
+
+int main() {
+    const unsigned int lens[NUM_MSG] = {0, 1, 55, 56, 63, 64, 65, 119, 120, 128};
+    // digests of the first lens[k] bytes of the message below
+    const std::string golden[NUM_MSG] = {"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+                                         "084fed08b978af4d7d196a7446a86b58009e636b611db16211b65a9aadff29c5",
+                                         "e7313d333c272e639f790978283f9eb392e843d0f29b7016828bb1daa4aac70b",
+                                         "4324d65f3c103567f5589c710bc08f8523f929a9272e3af36fc968e52abc6c27",
+                                         "81c80242132f230c3bd41b3e63bbcff16107339549214a99614ff26664625055",
+                                         "39e3d7b6b5d075d37d053ad89b24b41bef4f3c29760c84447cab3f3be1882241",
+                                         "aacca6ff74fdbb296d165a45cecfa04e5127bc008770fbbdd48006f2d2fae95e",
+                                         "9ce7368e4daf32341631b492e80359dc9f594b48453cd0dd5bf0b19279cc177e",
+                                         "7836b787757e95e58b3ca5aec90b1b004e8deba1e50e9675af9cabf1a13a04b5",
+                                         "d2742f1f4ac6bb7ca2b239ee18402ba8b3f9f8e652d2a72973c2b9ba11c08cf6"};
+    unsigned char msg[MAX_LEN];
+    for (int i = 0; i < MAX_LEN; i++) msg[i] = (unsigned char)(i * 7 + 3);
+
+    unsigned int nerror = checkLengths<32, 2>(msg, lens, golden);
+    nerror += checkLengths<64, 4>(msg, lens, golden);
+
+    if (nerror) {
+        std::cout << "FAIL: " << std::dec << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << std::dec << 2 * NUM_MSG << " digests verified, no error found." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Hash one message in several segment splits through the resumable SHA-512
+// and SHA-384 and check every split against the single-call digest of the same
+// bytes, and the whole message against a known answer.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/sha512_t.hpp"
+
+#define MSGW 64
+#define LENW 128
+#define STW 640
+#define MSG_LEN 300
+
+void test_sha512_resume(hls::stream<ap_uint<MSGW> >& msgStrm,
+                        hls::stream<ap_uint<LENW> >& lenStrm,
+                        hls::stream<bool>& eLenStrm,
+                        hls::stream<ap_uint<STW> >& initStateStrm,
+                        hls::stream<bool>& finalStrm,
+                        hls::stream<ap_uint<512> >& hshStrm,
+                        hls::stream<ap_uint<STW> >& outStateStrm,
+                        hls::stream<bool>& eHshStrm) {
+    xf::security::sha512<MSGW>(msgStrm, lenStrm, eLenStrm, initStateStrm, finalStrm, hshStrm, outStateStrm, eHshStrm);
+}
+
+template <int HW>
+struct Hasher;
+
+template <>
+struct Hasher<512> {
+    static void once(hls::stream<ap_uint<MSGW> >& msgStrm,
+                     hls::stream<ap_uint<LENW> >& lenStrm,
+                     hls::stream<bool>& eLenStrm,
+                     hls::stream<ap_uint<512> >& hshStrm,
+                     hls::stream<bool>& eHshStrm) {
+        xf::security::sha512<MSGW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+    static void resume(hls::stream<ap_uint<MSGW> >& msgStrm,
+                       hls::stream<ap_uint<LENW> >& lenStrm,
+                       hls::stream<bool>& eLenStrm,
+                       hls::stream<ap_uint<STW> >& initStateStrm,
+                       hls::stream<bool>& finalStrm,
+                       hls::stream<ap_uint<512> >& hshStrm,
+                       hls::stream<ap_uint<STW> >& outStateStrm,
+                       hls::stream<bool>& eHshStrm) {
+        test_sha512_resume(msgStrm, lenStrm, eLenStrm, initStateStrm, finalStrm, hshStrm, outStateStrm, eHshStrm);
+    }
+};
+
+template <>
+struct Hasher<384> {
+    static void once(hls::stream<ap_uint<MSGW> >& msgStrm,
+                     hls::stream<ap_uint<LENW> >& lenStrm,
+                     hls::stream<bool>& eLenStrm,
+                     hls::stream<ap_uint<384> >& hshStrm,
+                     hls::stream<bool>& eHshStrm) {
+        xf::security::sha384<MSGW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+    static void resume(hls::stream<ap_uint<MSGW> >& msgStrm,
+                       hls::stream<ap_uint<LENW> >& lenStrm,
+                       hls::stream<bool>& eLenStrm,
+                       hls::stream<ap_uint<STW> >& initStateStrm,
+                       hls::stream<bool>& finalStrm,
+                       hls::stream<ap_uint<384> >& hshStrm,
+                       hls::stream<ap_uint<STW> >& outStateStrm,
+                       hls::stream<bool>& eHshStrm) {
+        xf::security::sha384<MSGW>(msgStrm, lenStrm, eLenStrm, initStateStrm, finalStrm, hshStrm, outStateStrm,
+                                   eHshStrm);
+    }
+};
+
+void pushMsg(const unsigned char* msg, unsigned int len, hls::stream<ap_uint<MSGW> >& strm) {
+    for (unsigned int i = 0; i < len; i += MSGW / 8) {
+        ap_uint<MSGW> w = 0;
+        for (unsigned int b = 0; b < MSGW / 8 && i + b < len; b++) w.range(8 * b + 7, 8 * b) = msg[i + b];
+        strm.write(w);
+    }
+}
+
+template <int HW>
+std::string hash2str(const ap_uint<HW>& h) {
+    std::ostringstream oss;
+    oss << std::hex;
+    for (int i = 0; i < HW / 8; i++) oss << std::setw(2) << std::setfill('0') << h.range(7 + 8 * i, 8 * i).to_uint();
+    return oss.str();
+}
+
+template <int HW>
+unsigned int checkSplits(const unsigned char* msg,
+                         const std::string& golden,
+                         const unsigned long long iv[8],
+                         const std::vector<std::vector<unsigned int> >& splits) {
+    unsigned int nerror = 0;
+    hls::stream<ap_uint<MSGW> > msgStrm("msgStrm");
+    hls::stream<ap_uint<LENW> > lenStrm("lenStrm");
+    hls::stream<bool> eLenStrm("eLenStrm");
+    hls::stream<ap_uint<HW> > hshStrm("hshStrm");
+    hls::stream<bool> eHshStrm("eHshStrm");
+
+    // IV with zero bytes hashed
+    ap_uint<STW> ivState = 0;
+    for (int i = 0; i < 8; i++) ivState.range(64 * i + 63, 64 * i) = iv[i];
+
+    for (unsigned int s = 0; s < splits.size(); s++) {
+        unsigned int total = 0;
+        for (unsigned int k = 0; k < splits[s].size(); k++) total += splits[s][k];
+
+        // single-call digest of the same bytes
+        pushMsg(msg, total, msgStrm);
+        lenStrm.write(total);
+        eLenStrm.write(false);
+        eLenStrm.write(true);
+        Hasher<HW>::once(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+        ap_uint<HW> ref = hshStrm.read();
+        eHshStrm.read();
+        eHshStrm.read();
+        if (total == MSG_LEN && hash2str<HW>(ref) != golden) {
+            ++nerror;
+            std::cout << "SHA-" << HW << " single call: " << hash2str<HW>(ref) << ", golden: " << golden << std::endl;
+        }
+
+        ap_uint<STW> st = ivState;
+        unsigned int off = 0;
+        ap_uint<HW> digest = 0;
+        for (unsigned int k = 0; k < splits[s].size(); k++) {
+            unsigned int len = splits[s][k];
+            bool fin = (k + 1 == splits[s].size());
+            hls::stream<ap_uint<STW> > initStateStrm("initStateStrm");
+            hls::stream<bool> finalStrm("finalStrm");
+            hls::stream<ap_uint<STW> > outStateStrm("outStateStrm");
+            pushMsg(msg + off, len, msgStrm);
+            lenStrm.write(len);
+            eLenStrm.write(false);
+            eLenStrm.write(true);
+            initStateStrm.write(st);
+            finalStrm.write(fin);
+            Hasher<HW>::resume(msgStrm, lenStrm, eLenStrm, initStateStrm, finalStrm, hshStrm, outStateStrm, eHshStrm);
+            if (eHshStrm.read()) ++nerror;
+            if (fin) {
+                digest = hshStrm.read();
+            } else {
+                st = outStateStrm.read();
+                if (st.range(STW - 1, 512) != off + len) ++nerror;
+            }
+            if (!eHshStrm.read() || !hshStrm.empty() || !outStateStrm.empty() || !msgStrm.empty()) ++nerror;
+            off += len;
+        }
+        if (digest != ref) {
+            ++nerror;
+            std::cout << "SHA-" << HW << " split " << s << ": " << hash2str<HW>(digest)
+                      << ", expected: " << hash2str<HW>(ref) << std::endl;
+        }
+    }
+    return nerror;
+}
+
+int main() {
+    // digests of the 300-byte message below
+    const std::string golden512 =
+        "46e56ad30db9ef50f8b6762ba55839737f3fba34ab47863c9daff7b3f58f97fe"
+        "3465a52dd364560db47f802909ced49093322621ea0aebf8e0696b85ca8f81f0";
+    const std::string golden384 =
+        "060eb8e1c01cc6c6c8c03fcb7898155f2b836fb97c9d331a7a296a1a209aac9d261b2b268c4ba3c7299a3dd12b5bf81f";
+    const unsigned long long iv512[8] = {0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+                                         0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+                                         0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+    const unsigned long long iv384[8] = {0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL,
+                                         0x152fecd8f70e5939ULL, 0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL,
+                                         0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL};
+    unsigned char msg[MSG_LEN];
+    for (int i = 0; i < MSG_LEN; i++) msg[i] = (unsigned char)(i * 7 + 3);
+
+    // segment lengths of each split, all but the last are whole blocks; a split may hash a prefix of the message
+    const std::vector<std::vector<unsigned int> > splits = {{300},      {128, 172},     {0, 128, 172}, {256, 44},
+                                                            {256, 0},   {128, 128, 44}, {128, 111},    {128, 112}};
+
+    unsigned int nerror = checkSplits<512>(msg, golden512, iv512, splits);
+    nerror += checkSplits<384>(msg, golden384, iv384, splits);
+
+    if (nerror) {
+        std::cout << "FAIL: " << std::dec << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << std::dec << 2 * splits.size() << " splits verified, no error found." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Hash one message in several segment splits through the resumable SM3 and
+// check every split against the single-call digest of the same bytes, and the
+// whole message against a known answer.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/sm234.hpp"
+
+#define MSGW 64
+#define HSHW 256
+#define STW 320
+#define MSG_LEN 300
+
+void test_sm3_resume(hls::stream<ap_uint<MSGW> >& msgStrm,
+                     hls::stream<ap_uint<64> >& lenStrm,
+                     hls::stream<bool>& eLenStrm,
+                     hls::stream<ap_uint<STW> >& initStateStrm,
+                     hls::stream<bool>& finalStrm,
+                     hls::stream<ap_uint<HSHW> >& hshStrm,
+                     hls::stream<ap_uint<STW> >& outStateStrm,
+                     hls::stream<bool>& eHshStrm) {
+    xf::security::sm3(msgStrm, lenStrm, eLenStrm, initStateStrm, finalStrm, hshStrm, outStateStrm, eHshStrm);
+}
+
+void pushMsg(const unsigned char* msg, unsigned int len, hls::stream<ap_uint<MSGW> >& strm) {
+    for (unsigned int i = 0; i < len; i += MSGW / 8) {
+        ap_uint<MSGW> w = 0;
+        for (unsigned int b = 0; b < MSGW / 8 && i + b < len; b++) w.range(8 * b + 7, 8 * b) = msg[i + b];
+        strm.write(w);
+    }
+}
+
+std::string hash2str(const ap_uint<HSHW>& h) {
+    std::ostringstream oss;
+    oss << std::hex;
+    for (int i = 0; i < HSHW / 8; i++) oss << std::setw(2) << std::setfill('0') << h.range(7 + 8 * i, 8 * i).to_uint();
+    return oss.str();
+}
+
+int main() {
+    // SM3 of the 300-byte message below
+    const std::string golden = "35d034cc89d7ec8fa8c3a460f3429e98f3f993c5878219dc4e3f0559510f9534";
+    unsigned char msg[MSG_LEN];
+    for (int i = 0; i < MSG_LEN; i++) msg[i] = (unsigned char)(i * 7 + 3);
+
+    // segment lengths in bytes of each split, all but the last are whole blocks; a split may hash a prefix of the
+    // message. The SM3 length and state count bits.
+    const std::vector<std::vector<unsigned int> > splits = {
+        {300}, {64, 236}, {0, 128, 172}, {256, 44}, {192, 64, 44}, {256, 0}, {64, 64, 64, 64, 44}, {128, 55}, {128, 56}};
+
+    unsigned int nerror = 0;
+
+    hls::stream<ap_uint<MSGW> > msgStrm("msgStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> eLenStrm("eLenStrm");
+    hls::stream<ap_uint<HSHW> > hshStrm("hshStrm");
+    hls::stream<bool> eHshStrm("eHshStrm");
+
+    // IV with zero bytes hashed
+    const unsigned int iv[8] = {0x7380166f, 0x4914b2b9, 0x172442d7, 0xda8a0600,
+                                0xa96f30bc, 0x163138aa, 0xe38dee4d, 0xb0fb0e4e};
+    ap_uint<STW> ivState = 0;
+    for (int i = 0; i < 8; i++) ivState.range(32 * i + 31, 32 * i) = iv[i];
+
+    for (unsigned int s = 0; s < splits.size(); s++) {
+        unsigned int total = 0;
+        for (unsigned int k = 0; k < splits[s].size(); k++) total += splits[s][k];
+
+        // single-call digest of the same bytes
+        pushMsg(msg, total, msgStrm);
+        lenStrm.write(8 * total);
+        eLenStrm.write(false);
+        eLenStrm.write(true);
+        xf::security::sm3(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+        ap_uint<HSHW> ref = hshStrm.read();
+        eHshStrm.read();
+        eHshStrm.read();
+        if (total == MSG_LEN && hash2str(ref) != golden) {
+            ++nerror;
+            std::cout << "single call: " << hash2str(ref) << ", golden: " << golden << std::endl;
+        }
+
+        ap_uint<STW> st = ivState;
+        unsigned int off = 0;
+        ap_uint<HSHW> digest = 0;
+        for (unsigned int k = 0; k < splits[s].size(); k++) {
+            unsigned int len = splits[s][k];
+            bool fin = (k + 1 == splits[s].size());
+            hls::stream<ap_uint<STW> > initStateStrm("initStateStrm");
+            hls::stream<bool> finalStrm("finalStrm");
+            hls::stream<ap_uint<STW> > outStateStrm("outStateStrm");
+            pushMsg(msg + off, len, msgStrm);
+            lenStrm.write(8 * len);
+            eLenStrm.write(false);
+            eLenStrm.write(true);
+            initStateStrm.write(st);
+            finalStrm.write(fin);
+            test_sm3_resume(msgStrm, lenStrm, eLenStrm, initStateStrm, finalStrm, hshStrm, outStateStrm, eHshStrm);
+            if (eHshStrm.read()) ++nerror;
+            if (fin) {
+                digest = hshStrm.read();
+            } else {
+                st = outStateStrm.read();
+                if (st.range(STW - 1, 256) != 8 * (off + len)) ++nerror;
+            }
+            if (!eHshStrm.read() || !hshStrm.empty() || !outStateStrm.empty() || !msgStrm.empty()) ++nerror;
+            off += len;
+        }
+        if (digest != ref) {
+            ++nerror;
+            std::cout << "split " << s << ": " << hash2str(digest) << ", expected: " << hash2str(ref) << std::endl;
+        }
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << std::dec << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << std::dec << splits.size() << " splits verified, no error found." << std::endl;
+    }
+    return nerror;
+}
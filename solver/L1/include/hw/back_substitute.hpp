@@ -29,6 +29,7 @@
 
 #include "ap_fixed.h"
 #include "hls_x_complex.h"
+#include "utils/x_matrix_utils.hpp"
 #include "hls_stream.h"
 #include <complex>
 
@@ -365,6 +366,8 @@ void backSubstituteTop(const InputType A[RowsColsA][RowsColsA], OutputType B[Row
  * @tparam InputType    Input data type
  * @tparam OutputType   Output data type
  * @tparam TRIATS       Traits class
+ * @tparam Layout       Stream layout of A and B. FullLayout, PackedUpper (upper triangular A and B, packed) or
+ * PackedLower (lower triangular A^H in, B^H out, packed).
  *
  * @param matrixAStrm   Stream of Input matrix
  * @param matrixBStrm   Stream of Output matrix.
@@ -373,24 +376,53 @@ void backSubstituteTop(const InputType A[RowsColsA][RowsColsA], OutputType B[Row
 template <int RowsColsA,
           typename InputType,
           typename OutputType,
-          typename TRAITS = backSubstituteTraits<RowsColsA, InputType, OutputType> >
+          typename TRAITS = backSubstituteTraits<RowsColsA, InputType, OutputType>,
+          class Layout = FullLayout>
 void backSubstitute(hls::stream<InputType>& matrixAStrm, hls::stream<OutputType>& matrixBStrm, int& is_singular) {
     InputType A[RowsColsA][RowsColsA];
     OutputType B[RowsColsA][RowsColsA];
 
-    for (int r = 0; r < RowsColsA; r++) {
+    if (Layout::LayoutType == 0) {
+        for (int r = 0; r < RowsColsA; r++) {
 #pragma HLS PIPELINE
-        for (int c = 0; c < RowsColsA; c++) {
-            matrixAStrm.read(A[r][c]);
+            for (int c = 0; c < RowsColsA; c++) {
+                matrixAStrm.read(A[r][c]);
+            }
+        }
+    } else {
+        // Only the upper triangle of A is used, a packed lower triangle is the conjugate transpose of it
+        int r = 0;
+        int c = 0;
+        for (int i = 0; i < layoutStreamSize<Layout, RowsColsA>::Value; i++) {
+#pragma HLS PIPELINE II = 1
+            InputType a = matrixAStrm.read();
+            if (Layout::LayoutType == 1)
+                A[c][r] = hls::x_conj(a);
+            else
+                A[r][c] = a;
+            layoutNext<Layout, RowsColsA>(r, c);
         }
     }
 
     backSubstituteTop<RowsColsA, TRAITS, InputType, OutputType>(A, B, is_singular);
 
-    for (int r = 0; r < RowsColsA; r++) {
+    if (Layout::LayoutType == 0) {
+        for (int r = 0; r < RowsColsA; r++) {
 #pragma HLS PIPELINE
-        for (int c = 0; c < RowsColsA; c++) {
-            matrixBStrm.write(B[r][c]);
+            for (int c = 0; c < RowsColsA; c++) {
+                matrixBStrm.write(B[r][c]);
+            }
+        }
+    } else {
+        int r = 0;
+        int c = 0;
+        for (int i = 0; i < layoutStreamSize<Layout, RowsColsA>::Value; i++) {
+#pragma HLS PIPELINE II = 1
+            if (Layout::LayoutType == 1)
+                matrixBStrm.write(hls::x_conj(B[c][r]));
+            else
+                matrixBStrm.write(B[r][c]);
+            layoutNext<Layout, RowsColsA>(r, c);
         }
     }
 }
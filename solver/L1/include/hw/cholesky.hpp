@@ -8,7 +8,7 @@
 #include "utils/x_matrix_utils.hpp"
 #include "hls_stream.h"
 
-// ǿƼܹѡ-1  traits0/1/2 ǿѡĬǿ Alt2=2ȷܵ¼ܹ
+// ǿƼܹѡ-1  traits0/1/2/3 ǿѡ3 Ϊ SystolicĬǿ Alt2=2ȷܵ¼ܹ
 #ifndef XF_SOLVER_FORCE_ARCH
 #define XF_SOLVER_FORCE_ARCH 2
 #endif
@@ -233,6 +233,12 @@ void cholesky_rsqrt(ap_fixed<W1, I1, Q1, O1, N1> x, ap_fixed<W2, I2, Q2, O2, N2>
     res = one / sc;
 }
 
+template <typename T_IN, typename T_OUT>
+void cholesky_recip(T_IN x, T_OUT& one_over_x) {
+    T_OUT one = 1;
+    one_over_x = one / x;
+}
+
 template <typename AType, typename BType, typename CType>
 void cholesky_prod_sum_mult(AType A, BType B, CType& C) {
     C = A * B;
@@ -264,6 +270,13 @@ inline void chol_assign_real(std::complex<T>& out, const TReal& r) {
     out.imag((T)0);
 }
 
+// rsqrt ܹԪ飺 DIAG_T ת֮жתСԪص 0 ʱܹһ£
+// NonPositive ʱԪҲʧܣrsqrt(0)  NaN УֻиԪʧ
+template <bool NonPositive, typename DiagType>
+inline bool cholesky_pivot_fail(const DiagType& Aminus_cast) {
+    return NonPositive ? (hls::x_real(Aminus_cast) <= 0) : (hls::x_real(Aminus_cast) < 0);
+}
+
 // =======================================================================
 // Basicԭʵ֣
 template <bool LowerTriangularL, int RowsColsA, typename CholeskyTraits, class InputType, class OutputType>
@@ -425,9 +438,21 @@ row_loop:
 
 // =======================================================================
 // Alt2k II=1 + i IU УԽ rsqrt+mulFSqrt潵Latency
-template <bool LowerTriangularL, int RowsColsA, typename CholeskyTraits, class InputType, class OutputType>
-int choleskyAlt2(const InputType A[RowsColsA][RowsColsA], OutputType L[RowsColsA][RowsColsA]) {
+// ֻֽϽ n x nn <= RowsColsA鰴 RowsColsA 䣬ʱάȵڹñʵ
+// fail_col صһʧԪУΪ -1EarlyExit ʱΪԪڸֹL Ч
+// ΪԪжܹ cholesky_sqrt_op ͬ
+template <bool LowerTriangularL,
+          int RowsColsA,
+          typename CholeskyTraits,
+          class InputType,
+          class OutputType,
+          bool EarlyExit>
+int choleskyAlt2Core(const InputType A[RowsColsA][RowsColsA],
+                     OutputType L[RowsColsA][RowsColsA],
+                     int n,
+                     int& fail_col) {
     int return_code = 0;
+    fail_col = -1;
 
     OutputType L_internal[RowsColsA][RowsColsA];
     typename CholeskyTraits::ACCUM_T diag_sum[RowsColsA];
@@ -439,18 +464,26 @@ int choleskyAlt2(const InputType A[RowsColsA][RowsColsA], OutputType L[RowsColsA
 
 // ʼ
 init_diag:
-    for (int i = 0; i < RowsColsA; i++) {
+    for (int i = 0; i < n; i++) {
 #pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = RowsColsA
         diag_sum[i] = 0;
     }
 
 col_loop:
-    for (int j = 0; j < RowsColsA; j++) {
+    for (int j = 0; j < n; j++) {
+#pragma HLS loop_tripcount max = RowsColsA
         // 1) Խ L[j][j]rsqrt + ˷
         typename CholeskyTraits::ACCUM_T Ajj = A[j][j];
         typename CholeskyTraits::ADD_T Aminus = Ajj - diag_sum[j];
 
         typename CholeskyTraits::DIAG_T Aminus_cast = Aminus;
+        // EarlyExit ʱԪҲʧܣcholesky ķֵֻԪ
+        if (cholesky_pivot_fail<EarlyExit>(Aminus_cast)) {
+            if (return_code == 0) fail_col = j;
+            return_code = 1;
+            if (EarlyExit) break;
+        }
         typename CholeskyTraits::RECIP_DIAG_T inv_Ljj;
         cholesky_rsqrt(hls::x_real(Aminus_cast), inv_Ljj);
 
@@ -466,7 +499,8 @@ col_loop:
 
         // 2)  j ķǶԽǣi=j+1.. IU п黯k  II=1
     iblock_loop:
-        for (int ib = j + 1; ib < RowsColsA; ib += CholeskyTraits::IU) {
+        for (int ib = j + 1; ib < n; ib += CholeskyTraits::IU) {
+#pragma HLS loop_tripcount max = RowsColsA / CholeskyTraits::IU
             typename CholeskyTraits::ACCUM_T psum[CholeskyTraits::IU];
 #pragma HLS ARRAY_PARTITION variable = psum complete
 
@@ -474,7 +508,7 @@ col_loop:
             for (int u = 0; u < CholeskyTraits::IU; u++) {
 #pragma HLS UNROLL
                 int ii = ib + u;
-                if (ii < RowsColsA) {
+                if (ii < n) {
                     psum[u] = LowerTriangularL ? (typename CholeskyTraits::ACCUM_T)A[ii][j]
                                                : (typename CholeskyTraits::ACCUM_T)hls::x_conj(A[j][ii]);
                 }
@@ -483,12 +517,13 @@ col_loop:
         k_loop:
             for (int k = 0; k < j; k++) {
 #pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = RowsColsA
                 OutputType top = -hls::x_conj(L_internal[j][k]);
             lanes:
                 for (int u = 0; u < CholeskyTraits::IU; u++) {
 #pragma HLS UNROLL
                     int ii = ib + u;
-                    if (ii < RowsColsA) {
+                    if (ii < n) {
                         typename CholeskyTraits::PROD_T pr = (typename CholeskyTraits::PROD_T)(L_internal[ii][k] * top);
                         psum[u] = psum[u] + (typename CholeskyTraits::ACCUM_T)pr;
                     }
@@ -499,7 +534,7 @@ col_loop:
             for (int u = 0; u < CholeskyTraits::IU; u++) {
 #pragma HLS UNROLL
                 int ii = ib + u;
-                if (ii < RowsColsA) {
+                if (ii < n) {
                     typename CholeskyTraits::OFF_DIAG_T off = (typename CholeskyTraits::OFF_DIAG_T)psum[u];
                     typename CholeskyTraits::OFF_DIAG_T Lij;
                     // ˷Lij = off * inv_Ljj
@@ -520,12 +555,14 @@ col_loop:
     }
 
     // 3) һ
-    if (CholeskyTraits::ARCH2_ZERO_LOOP) {
+    if (CholeskyTraits::ARCH2_ZERO_LOOP && !(EarlyExit && return_code)) {
     zero_rows:
-        for (int i = 0; i < RowsColsA - 1; i++) {
+        for (int i = 0; i < n - 1; i++) {
+#pragma HLS loop_tripcount max = RowsColsA
         zero_cols:
-            for (int j = i + 1; j < RowsColsA; j++) {
+            for (int j = i + 1; j < n; j++) {
 #pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = RowsColsA / 2
                 if (LowerTriangularL)
                     L[i][j] = 0;
                 else
@@ -536,6 +573,99 @@ col_loop:
     return return_code;
 }
 
+template <bool LowerTriangularL, int RowsColsA, typename CholeskyTraits, class InputType, class OutputType>
+int choleskyAlt2(const InputType A[RowsColsA][RowsColsA], OutputType L[RowsColsA][RowsColsA]) {
+    int fail_col;
+    return choleskyAlt2Core<LowerTriangularL, RowsColsA, CholeskyTraits, InputType, OutputType, false>(A, L, RowsColsA,
+                                                                                                       fail_col);
+}
+
+// =======================================================================
+// SystolicARCH=3 PE Уӣright-lookingƽ
+// ߽絥Ԫ (j,j)  rsqrtеԪ (i,j) ţڲԪ (i,k) ۼ -L[i][j]*conj(L[k][j])
+// ÿһеԪУӳΪ N  xrsqrt + ˷ + MAC N ԣԼ N*N/2  MAC
+template <bool LowerTriangularL, int RowsColsA, typename CholeskyTraits, class InputType, class OutputType>
+int choleskySystolic(const InputType A[RowsColsA][RowsColsA], OutputType L[RowsColsA][RowsColsA]) {
+    int return_code = 0;
+
+    // ڲԪۼӼĴֻ
+    typename CholeskyTraits::ACCUM_T acc[RowsColsA][RowsColsA];
+    typename CholeskyTraits::ACCUM_T diag_sum[RowsColsA];
+    OutputType L_col[RowsColsA];
+#pragma HLS ARRAY_PARTITION variable = acc complete dim = 0
+#pragma HLS ARRAY_PARTITION variable = diag_sum complete
+#pragma HLS ARRAY_PARTITION variable = L_col complete
+#pragma HLS ARRAY_PARTITION variable = A complete dim = CholeskyTraits::UNROLL_DIM
+#pragma HLS ARRAY_PARTITION variable = L complete dim = CholeskyTraits::UNROLL_DIM
+
+init_pe:
+    for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS UNROLL
+        diag_sum[i] = 0;
+        for (int k = 0; k < RowsColsA; k++) {
+#pragma HLS UNROLL
+            acc[i][k] = 0;
+        }
+    }
+
+step_loop:
+    for (int j = 0; j < RowsColsA; j++) {
+        // 1) ߽絥Ԫ
+        typename CholeskyTraits::ACCUM_T Ajj = A[j][j];
+        typename CholeskyTraits::ADD_T Aminus = Ajj - diag_sum[j];
+        typename CholeskyTraits::DIAG_T Aminus_cast = Aminus;
+        if (cholesky_pivot_fail<false>(Aminus_cast)) return_code = 1;
+        typename CholeskyTraits::RECIP_DIAG_T inv_Ljj;
+        cholesky_rsqrt(hls::x_real(Aminus_cast), inv_Ljj);
+
+        typename CholeskyTraits::RECIP_DIAG_T Ljj_real = hls::x_real(Aminus_cast) * inv_Ljj;
+        typename CholeskyTraits::L_OUTPUT_T Ljj_out;
+        chol_assign_real(Ljj_out, Ljj_real);
+
+        // 2)  j еĵԪŲУһǵ 0
+    col_pe:
+        for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS UNROLL
+            typename CholeskyTraits::L_OUTPUT_T Lij_out;
+            if (i > j) {
+                typename CholeskyTraits::ACCUM_T a = LowerTriangularL
+                                                         ? (typename CholeskyTraits::ACCUM_T)A[i][j]
+                                                         : (typename CholeskyTraits::ACCUM_T)hls::x_conj(A[j][i]);
+                typename CholeskyTraits::OFF_DIAG_T off = (typename CholeskyTraits::OFF_DIAG_T)(a + acc[i][j]);
+                typename CholeskyTraits::OFF_DIAG_T Lij;
+                cholesky_prod_sum_mult(off, inv_Ljj, Lij);
+                Lij_out = Lij;
+                diag_sum[i] = diag_sum[i] + (typename CholeskyTraits::ACCUM_T)(hls::x_conj(Lij_out) * Lij_out);
+            } else if (i == j) {
+                Lij_out = Ljj_out;
+            } else {
+                Lij_out = 0;
+            }
+            L_col[i] = Lij_out;
+            if (LowerTriangularL)
+                L[i][j] = Lij_out;
+            else
+                L[j][i] = hls::x_conj(Lij_out);
+        }
+
+        // 3) ڲԪ (i,k)j < k < i
+    internal_pe_i:
+        for (int i = 1; i < RowsColsA; i++) {
+#pragma HLS UNROLL
+        internal_pe_k:
+            for (int k = 0; k < RowsColsA; k++) {
+#pragma HLS UNROLL
+                if (k > j && k < i) {
+                    OutputType top = -hls::x_conj(L_col[k]);
+                    typename CholeskyTraits::PROD_T pr = (typename CholeskyTraits::PROD_T)(L_col[i] * top);
+                    acc[i][k] = acc[i][k] + (typename CholeskyTraits::ACCUM_T)pr;
+                }
+            }
+        }
+    }
+    return return_code;
+}
+
 // =======================================================================
 // ܹѡ
 template <bool LowerTriangularL, int RowsColsA, typename CholeskyTraits, class InputType, class OutputType>
@@ -548,6 +678,8 @@ int choleskyTop(const InputType A[RowsColsA][RowsColsA], OutputType L[RowsColsA]
             return choleskyAlt<LowerTriangularL, RowsColsA, CholeskyTraits, InputType, OutputType>(A, L);
         case 2:
             return choleskyAlt2<LowerTriangularL, RowsColsA, CholeskyTraits, InputType, OutputType>(A, L);
+        case 3:
+            return choleskySystolic<LowerTriangularL, RowsColsA, CholeskyTraits, InputType, OutputType>(A, L);
         default:
             return choleskyBasic<LowerTriangularL, RowsColsA, CholeskyTraits, InputType, OutputType>(A, L);
     }
@@ -555,31 +687,505 @@ int choleskyTop(const InputType A[RowsColsA][RowsColsA], OutputType L[RowsColsA]
 
 // =======================================================================
 // 㣺I/O չƽ + II=1
+// ʽʱ L һ벻Alt2 ѭʡ
+template <typename CholeskyTraits>
+struct choleskyPackedTraits : CholeskyTraits {
+    static const int ARCH2_ZERO_LOOP = false;
+};
+
+// Layout Ϊ PackedLower/PackedUpper ʱ A ֻǣһ Hermitian ԳƵõ
+// L Ǵ PackedLower PackedUpper N*(N+1)/2 Ԫ
 template <bool LowerTriangularL,
           int RowsColsA,
           class InputType,
           class OutputType,
-          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType> >
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType>,
+          class Layout = FullLayout>
 int cholesky(hls::stream<InputType>& matrixAStrm, hls::stream<OutputType>& matrixLStrm) {
     InputType A[RowsColsA][RowsColsA];
     OutputType L[RowsColsA][RowsColsA];
 
+    if (Layout::LayoutType == 0) {
+    read_loop:
+        for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+            A[i / RowsColsA][i % RowsColsA] = matrixAStrm.read();
+        }
+    } else {
+        // ֻܹ L ͬǣһʱ浽Գλ
+        const bool mirror = ((Layout::LayoutType == 1) != LowerTriangularL);
+        int r = 0;
+        int c = 0;
+    packed_read_loop:
+        for (int i = 0; i < layoutStreamSize<Layout, RowsColsA>::Value; i++) {
+#pragma HLS PIPELINE II = 1
+            InputType a = matrixAStrm.read();
+            if (mirror)
+                A[c][r] = hls::x_conj(a);
+            else
+                A[r][c] = a;
+            layoutNext<Layout, RowsColsA>(r, c);
+        }
+    }
+
+    int ret;
+    if (Layout::LayoutType == 0) {
+        ret = choleskyTop<LowerTriangularL, RowsColsA, TRAITS, InputType, OutputType>(A, L);
+    } else {
+        ret = choleskyTop<LowerTriangularL, RowsColsA, choleskyPackedTraits<TRAITS>, InputType, OutputType>(A, L);
+    }
+
+    if (Layout::LayoutType == 0) {
+    write_loop:
+        for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+            matrixLStrm.write(L[i / RowsColsA][i % RowsColsA]);
+        }
+    } else {
+        int r = 0;
+        int c = 0;
+    packed_write_loop:
+        for (int i = 0; i < layoutStreamSize<Layout, RowsColsA>::Value; i++) {
+#pragma HLS PIPELINE II = 1
+            matrixLStrm.write(L[r][c]);
+            if (LowerTriangularL)
+                layoutNext<PackedLower, RowsColsA>(r, c);
+            else
+                layoutNext<PackedUpper, RowsColsA>(r, c);
+        }
+    }
+    return ret;
+}
+
+// =======================================================================
+// ϵĶ㣺ÿһ״̬-1 ɹΪһԪкţ
+// ɹʱ L cholesky ͬʧʱڸǰֹҲ LֱӴһ
+template <bool LowerTriangularL,
+          int RowsColsA,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType> >
+void choleskyStatus(hls::stream<InputType>& matrixAStrm,
+                    hls::stream<OutputType>& matrixLStrm,
+                    hls::stream<int>& statusStrm,
+                    int numMatrices) {
+    InputType A[RowsColsA][RowsColsA];
+    OutputType L[RowsColsA][RowsColsA];
+
+matrix_loop:
+    for (int m = 0; m < numMatrices; m++) {
+    read_loop:
+        for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+            A[i / RowsColsA][i % RowsColsA] = matrixAStrm.read();
+        }
+
+        int fail_col;
+        choleskyAlt2Core<LowerTriangularL, RowsColsA, TRAITS, InputType, OutputType, true>(A, L, RowsColsA, fail_col);
+        statusStrm.write(fail_col);
+
+        if (fail_col < 0) {
+        write_loop:
+            for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+                matrixLStrm.write(L[i / RowsColsA][i % RowsColsA]);
+            }
+        }
+    }
+}
+
+// =======================================================================
+// ʱάȣn <= RowsColsMaxѭ߽ n ţһ˸Ƕйģ
+template <bool LowerTriangularL, int RowsColsMax, typename CholeskyTraits, class InputType, class OutputType>
+int choleskyDynAlt2(const InputType A[RowsColsMax][RowsColsMax], OutputType L[RowsColsMax][RowsColsMax], int n) {
+    int fail_col;
+    return choleskyAlt2Core<LowerTriangularL, RowsColsMax, CholeskyTraits, InputType, OutputType, false>(A, L, n,
+                                                                                                         fail_col);
+}
+
+// 㣺ֻ n*n ԪأУ cholesky<n> ͬ
+// n  [1, RowsColsMax] ڣԽʱ 1
+template <bool LowerTriangularL,
+          int RowsColsMax,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsMax, InputType, OutputType> >
+int choleskyDyn(hls::stream<InputType>& matrixAStrm, hls::stream<OutputType>& matrixLStrm, int n) {
+    InputType A[RowsColsMax][RowsColsMax];
+    OutputType L[RowsColsMax][RowsColsMax];
+
+    if (n < 1 || n > RowsColsMax) return 1;
+
 read_loop:
-    for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+    for (int i = 0; i < n; i++) {
+#pragma HLS loop_tripcount max = RowsColsMax
+    read_cols:
+        for (int j = 0; j < n; j++) {
 #pragma HLS PIPELINE II = 1
-        A[i / RowsColsA][i % RowsColsA] = matrixAStrm.read();
+#pragma HLS loop_tripcount max = RowsColsMax
+            A[i][j] = matrixAStrm.read();
+        }
     }
 
-    int ret = choleskyTop<LowerTriangularL, RowsColsA, TRAITS, InputType, OutputType>(A, L);
+    int ret = choleskyDynAlt2<LowerTriangularL, RowsColsMax, TRAITS, InputType, OutputType>(A, L, n);
 
 write_loop:
-    for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+    for (int i = 0; i < n; i++) {
+#pragma HLS loop_tripcount max = RowsColsMax
+    write_cols:
+        for (int j = 0; j < n; j++) {
 #pragma HLS PIPELINE II = 1
-        matrixLStrm.write(L[i / RowsColsA][i % RowsColsA]);
+#pragma HLS loop_tripcount max = RowsColsMax
+            matrixLStrm.write(L[i][j]);
+        }
     }
     return ret;
 }
 
+// =======================================================================
+// ʽзֽ⣺ -> зֽ ->   dataflow
+// A Ϊ HermitianL ĵ j ֻ A ĵ j Уǲ֣԰ж뼴зֽ⣬
+// L ĵ j Уʱ U ĵ j Уڵ j ɺ󼴿ʽ cholesky ͬ
+// ѭһڱֽ/ڼ롣
+template <int RowsColsA, class InputType>
+void choleskyStreamRead(hls::stream<InputType>& matrixAStrm, hls::stream<InputType>& rowStrm, int numMatrices) {
+matrix_loop:
+    for (int m = 0; m < numMatrices; m++) {
+        int r = 0;
+        int c = 0;
+    read_loop:
+        for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+            InputType a = matrixAStrm.read();
+            // ֻǣԽǣ
+            if (c >= r) rowStrm.write(a);
+            if (c == RowsColsA - 1) {
+                c = 0;
+                r++;
+            } else {
+                c++;
+            }
+        }
+    }
+}
+
+template <bool LowerTriangularL, int RowsColsA, typename CholeskyTraits, class InputType, class OutputType>
+void choleskyStreamFactor(hls::stream<InputType>& rowStrm,
+                          hls::stream<OutputType>& colStrm,
+                          hls::stream<int>& returnCodeStrm,
+                          int numMatrices) {
+    OutputType L_internal[RowsColsA][RowsColsA];
+    InputType A_row[RowsColsA];
+    typename CholeskyTraits::ACCUM_T diag_sum[RowsColsA];
+#pragma HLS ARRAY_PARTITION variable = diag_sum complete
+#pragma HLS ARRAY_PARTITION variable = A_row cyclic factor = CholeskyTraits::IU
+#pragma HLS ARRAY_PARTITION variable = L_internal cyclic dim = 1 factor = CholeskyTraits::IU
+
+matrix_loop:
+    for (int m = 0; m < numMatrices; m++) {
+        int return_code = 0;
+    init_diag:
+        for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+            diag_sum[i] = 0;
+        }
+
+    col_loop:
+        for (int j = 0; j < RowsColsA; j++) {
+        row_read:
+            for (int i = j; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = RowsColsA
+                A_row[i] = rowStrm.read();
+            }
+
+            // 1) Խ L[j][j] Alt2 ͬ rsqrt + ˷
+            typename CholeskyTraits::ACCUM_T Ajj = A_row[j];
+            typename CholeskyTraits::ADD_T Aminus = Ajj - diag_sum[j];
+            typename CholeskyTraits::DIAG_T Aminus_cast = Aminus;
+            if (cholesky_pivot_fail<false>(Aminus_cast)) return_code = 1;
+            typename CholeskyTraits::RECIP_DIAG_T inv_Ljj;
+            cholesky_rsqrt(hls::x_real(Aminus_cast), inv_Ljj);
+
+            typename CholeskyTraits::RECIP_DIAG_T Ljj_real = hls::x_real(Aminus_cast) * inv_Ljj;
+            typename CholeskyTraits::L_OUTPUT_T Ljj_out;
+            chol_assign_real(Ljj_out, Ljj_real);
+            L_internal[j][j] = Ljj_out;
+            colStrm.write(Ljj_out);
+
+            // 2)  j зǶԽǣA[i][j] ȡ A  j еĹ
+        iblock_loop:
+            for (int ib = j + 1; ib < RowsColsA; ib += CholeskyTraits::IU) {
+#pragma HLS loop_tripcount max = RowsColsA / CholeskyTraits::IU
+                typename CholeskyTraits::ACCUM_T psum[CholeskyTraits::IU];
+#pragma HLS ARRAY_PARTITION variable = psum complete
+
+            init_ps:
+                for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                    int ii = ib + u;
+                    if (ii < RowsColsA) psum[u] = (typename CholeskyTraits::ACCUM_T)hls::x_conj(A_row[ii]);
+                }
+
+            k_loop:
+                for (int k = 0; k < j; k++) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = RowsColsA
+                    OutputType top = -hls::x_conj(L_internal[j][k]);
+                lanes:
+                    for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                        int ii = ib + u;
+                        if (ii < RowsColsA) {
+                            typename CholeskyTraits::PROD_T pr =
+                                (typename CholeskyTraits::PROD_T)(L_internal[ii][k] * top);
+                            psum[u] = psum[u] + (typename CholeskyTraits::ACCUM_T)pr;
+                        }
+                    }
+                }
+
+            finalize_lanes:
+                for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                    int ii = ib + u;
+                    if (ii < RowsColsA) {
+                        typename CholeskyTraits::OFF_DIAG_T off = (typename CholeskyTraits::OFF_DIAG_T)psum[u];
+                        typename CholeskyTraits::OFF_DIAG_T Lij;
+                        cholesky_prod_sum_mult(off, inv_Ljj, Lij);
+
+                        typename CholeskyTraits::L_OUTPUT_T Lij_out = Lij;
+                        L_internal[ii][j] = Lij_out;
+                        colStrm.write(Lij_out);
+                        diag_sum[ii] =
+                            diag_sum[ii] + (typename CholeskyTraits::ACCUM_T)(hls::x_conj(Lij_out) * Lij_out);
+                    }
+                }
+            }
+        }
+        returnCodeStrm.write(return_code);
+    }
+}
+
+template <bool LowerTriangularL, int RowsColsA, class OutputType>
+void choleskyStreamWrite(hls::stream<OutputType>& colStrm, hls::stream<OutputType>& matrixLStrm, int numMatrices) {
+    // ʱյУ j е L ĵ j м
+    OutputType L_buf[RowsColsA][RowsColsA];
+
+matrix_loop:
+    for (int m = 0; m < numMatrices; m++) {
+    row_loop:
+        for (int j = 0; j < RowsColsA; j++) {
+            if (LowerTriangularL) {
+            col_read:
+                for (int i = j; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS loop_tripcount max = RowsColsA
+                    L_buf[i][j] = colStrm.read();
+                }
+            row_write:
+                for (int k = 0; k < RowsColsA; k++) {
+#pragma HLS PIPELINE II = 1
+                    OutputType v;
+                    if (k <= j)
+                        v = L_buf[j][k];
+                    else
+                        v = 0;
+                    matrixLStrm.write(v);
+                }
+            } else {
+            // ǣU ĵ j о L  j еĹ
+            u_row_write:
+                for (int k = 0; k < RowsColsA; k++) {
+#pragma HLS PIPELINE II = 1
+                    OutputType v;
+                    if (k >= j)
+                        v = hls::x_conj(colStrm.read());
+                    else
+                        v = 0;
+                    matrixLStrm.write(v);
+                }
+            }
+        }
+    }
+}
+
+// 㣺numMatrices 룬ÿ N*N Ԫأʽͬ choleskyһ
+// ֻ A ǣԽǣǱ A ϸ Hermitian ʱ cholesky λһ£
+// ߵĽȡڸԶȡһ룬֤һ
+template <bool LowerTriangularL,
+          int RowsColsA,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType> >
+void choleskyStream(hls::stream<InputType>& matrixAStrm,
+                    hls::stream<OutputType>& matrixLStrm,
+                    hls::stream<int>& returnCodeStrm,
+                    int numMatrices) {
+#pragma HLS DATAFLOW
+    // /лһǣN*(N+1)/2 Ԫأ㡢д
+    hls::stream<InputType> rowStrm;
+#pragma HLS STREAM variable = rowStrm depth = RowsColsA * (RowsColsA + 1) / 2
+    hls::stream<OutputType> colStrm;
+#pragma HLS STREAM variable = colStrm depth = RowsColsA * (RowsColsA + 1) / 2
+
+    choleskyStreamRead<RowsColsA, InputType>(matrixAStrm, rowStrm, numMatrices);
+    choleskyStreamFactor<LowerTriangularL, RowsColsA, TRAITS, InputType, OutputType>(rowStrm, colStrm,
+                                                                                    returnCodeStrm, numMatrices);
+    choleskyStreamWrite<LowerTriangularL, RowsColsA, OutputType>(colStrm, matrixLStrm, numMatrices);
+}
+
+// =======================================================================
+// BATCH н֯ͬһ㵥Ԫ
+// k ѭڲ㰴תpsum ۼ BATCH ģBATCH Сۼӳʱ k ѭ II=1
+// Խ rsqrt Ҳˮÿпյȡ
+template <bool LowerTriangularL, int RowsColsA, int BATCH, typename CholeskyTraits, class InputType, class OutputType>
+void choleskyBatchAlt2(const InputType A[BATCH][RowsColsA][RowsColsA],
+                       OutputType L_internal[BATCH][RowsColsA][RowsColsA],
+                       int return_code[BATCH]) {
+    typename CholeskyTraits::ACCUM_T diag_sum[BATCH][RowsColsA];
+    typename CholeskyTraits::RECIP_DIAG_T inv_diag[BATCH];
+    typename CholeskyTraits::ACCUM_T psum[BATCH][CholeskyTraits::IU];
+#pragma HLS ARRAY_PARTITION variable = diag_sum cyclic dim = 2 factor = CholeskyTraits::IU
+#pragma HLS ARRAY_PARTITION variable = psum complete dim = 2
+#pragma HLS ARRAY_PARTITION variable = A cyclic dim = CholeskyTraits::UNROLL_DIM + 1 factor = CholeskyTraits::IU
+#pragma HLS ARRAY_PARTITION variable = L_internal cyclic dim = 2 factor = CholeskyTraits::IU
+
+init_diag:
+    for (int i = 0; i < BATCH * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        diag_sum[i / RowsColsA][i % RowsColsA] = 0;
+    }
+init_rc:
+    for (int b = 0; b < BATCH; b++) {
+#pragma HLS PIPELINE II = 1
+        return_code[b] = 0;
+    }
+
+col_loop:
+    for (int j = 0; j < RowsColsA; j++) {
+    // 1) ĶԽǣˮͨ rsqrt
+    diag_loop:
+        for (int b = 0; b < BATCH; b++) {
+#pragma HLS PIPELINE II = 1
+            typename CholeskyTraits::ACCUM_T Ajj = A[b][j][j];
+            typename CholeskyTraits::ADD_T Aminus = Ajj - diag_sum[b][j];
+            typename CholeskyTraits::DIAG_T Aminus_cast = Aminus;
+            if (cholesky_pivot_fail<false>(Aminus_cast)) return_code[b] = 1;
+            typename CholeskyTraits::RECIP_DIAG_T inv_Ljj;
+            cholesky_rsqrt(hls::x_real(Aminus_cast), inv_Ljj);
+            inv_diag[b] = inv_Ljj;
+
+            typename CholeskyTraits::RECIP_DIAG_T Ljj_real = hls::x_real(Aminus_cast) * inv_Ljj;
+            typename CholeskyTraits::L_OUTPUT_T Ljj_out;
+            chol_assign_real(Ljj_out, Ljj_real);
+            L_internal[b][j][j] = Ljj_out;
+        }
+
+    // 2) ǶԽǣIU һ飬 (k, b) չƽˮ
+    iblock_loop:
+        for (int ib = j + 1; ib < RowsColsA; ib += CholeskyTraits::IU) {
+#pragma HLS loop_tripcount max = RowsColsA / CholeskyTraits::IU
+        init_ps:
+            for (int b = 0; b < BATCH; b++) {
+#pragma HLS PIPELINE II = 1
+                for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                    int ii = ib + u;
+                    if (ii < RowsColsA) {
+                        psum[b][u] = LowerTriangularL ? (typename CholeskyTraits::ACCUM_T)A[b][ii][j]
+                                                      : (typename CholeskyTraits::ACCUM_T)hls::x_conj(A[b][j][ii]);
+                    }
+                }
+            }
+
+        k_loop:
+            for (int kb = 0; kb < j * BATCH; kb++) {
+#pragma HLS PIPELINE II = 1
+// psum[b]  BATCH ĲŻض밴 BATCH 
+#pragma HLS DEPENDENCE variable = psum inter distance = BATCH true
+#pragma HLS loop_tripcount max = RowsColsA * BATCH
+                int k = kb / BATCH;
+                int b = kb % BATCH;
+                OutputType top = -hls::x_conj(L_internal[b][j][k]);
+            lanes:
+                for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                    int ii = ib + u;
+                    if (ii < RowsColsA) {
+                        typename CholeskyTraits::PROD_T pr =
+                            (typename CholeskyTraits::PROD_T)(L_internal[b][ii][k] * top);
+                        psum[b][u] = psum[b][u] + (typename CholeskyTraits::ACCUM_T)pr;
+                    }
+                }
+            }
+
+        finalize_lanes:
+            for (int b = 0; b < BATCH; b++) {
+#pragma HLS PIPELINE II = 1
+                for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                    int ii = ib + u;
+                    if (ii < RowsColsA) {
+                        typename CholeskyTraits::OFF_DIAG_T off = (typename CholeskyTraits::OFF_DIAG_T)psum[b][u];
+                        typename CholeskyTraits::OFF_DIAG_T Lij;
+                        cholesky_prod_sum_mult(off, inv_diag[b], Lij);
+
+                        typename CholeskyTraits::L_OUTPUT_T Lij_out = Lij;
+                        L_internal[b][ii][j] = Lij_out;
+                        diag_sum[b][ii] =
+                            diag_sum[b][ii] + (typename CholeskyTraits::ACCUM_T)(hls::x_conj(Lij_out) * Lij_out);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 㣺ÿεô BATCH Ϊ N*N ͬ cholesky
+// returnCodeStrm ˳ BATCH 
+template <bool LowerTriangularL,
+          int RowsColsA,
+          int BATCH,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType> >
+void choleskyBatch(hls::stream<InputType>& matrixAStrm,
+                   hls::stream<OutputType>& matrixLStrm,
+                   hls::stream<int>& returnCodeStrm) {
+    InputType A[BATCH][RowsColsA][RowsColsA];
+    OutputType L_internal[BATCH][RowsColsA][RowsColsA];
+    int return_code[BATCH];
+
+read_loop:
+    for (int i = 0; i < BATCH * RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        int b = i / (RowsColsA * RowsColsA);
+        int r = (i / RowsColsA) % RowsColsA;
+        int c = i % RowsColsA;
+        A[b][r][c] = matrixAStrm.read();
+    }
+
+    choleskyBatchAlt2<LowerTriangularL, RowsColsA, BATCH, TRAITS, InputType, OutputType>(A, L_internal, return_code);
+
+    // ֻЧǣһֱд 0Ҫѭ
+write_loop:
+    for (int i = 0; i < BATCH * RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        int b = i / (RowsColsA * RowsColsA);
+        int r = (i / RowsColsA) % RowsColsA;
+        int c = i % RowsColsA;
+        OutputType v;
+        if (LowerTriangularL && c <= r)
+            v = L_internal[b][r][c];
+        else if (!LowerTriangularL && r <= c)
+            v = hls::x_conj(L_internal[b][c][r]);
+        else
+            v = 0;
+        matrixLStrm.write(v);
+        if (r == RowsColsA - 1 && c == RowsColsA - 1) returnCodeStrm.write(return_code[b]);
+    }
+}
+
 } // namespace solver
 } // namespace xf
 
@@ -199,12 +199,24 @@ struct choleskyInverseTraits<RowsColsA,
         MATRIX_MULTIPLY_TRAITS;
 };
 
+// Layout of the internal U and U^-1 streams: packed upper when the input is packed
+template <class Layout>
+struct choleskyInverseInternalLayout {
+    typedef PackedUpper Type;
+};
+template <>
+struct choleskyInverseInternalLayout<FullLayout> {
+    typedef FullLayout Type;
+};
+
 /**
 * @brief CHOLESKY_INVERSE
 * @tparam RowsColsA              Defines the matrix dimensions
 * @tparam InputType              Input data type
 * @tparam OutputType             Output data type
 * @tparam CholeskyInverseTraits  Traits class
+* @tparam Layout                 Stream layout of A: FullLayout, or PackedLower/PackedUpper to stream one triangle only.
+*                                The inverse is always streamed in FullLayout.
 *
 * @param matrixAStrm             Stream of Square Hermitian/symmetric positive definite input matrix
 * @param matrixInverseAStrm      Stream of Inverse of input matrix
@@ -213,11 +225,13 @@ struct choleskyInverseTraits<RowsColsA,
 template <int RowsColsA,
           typename InputType,
           typename OutputType,
-          typename CholeskyInverseTraits = choleskyInverseTraits<RowsColsA, InputType, OutputType> >
+          typename CholeskyInverseTraits = choleskyInverseTraits<RowsColsA, InputType, OutputType>,
+          class Layout = FullLayout>
 void choleskyInverse(hls::stream<InputType>& matrixAStrm,
                      hls::stream<OutputType>& matrixInverseAStrm,
                      int& cholesky_success) {
 #pragma HLS DATAFLOW
+    typedef typename choleskyInverseInternalLayout<Layout>::Type INTERNAL_LAYOUT;
     hls::stream<typename CholeskyInverseTraits::CHOLESKY_OUT> matrixUStrm;
 #pragma HLS STREAM variable = matrixUStrm depth = 16
     hls::stream<typename CholeskyInverseTraits::BACK_SUBSTITUTE_OUT> matrixInverseUStrm;
@@ -227,17 +241,19 @@ void choleskyInverse(hls::stream<InputType>& matrixAStrm,
     // Run Cholesky, get upper-triangular result
     const bool LOWER_TRIANGULAR = false;
     cholesky_success = cholesky<LOWER_TRIANGULAR, RowsColsA, InputType, typename CholeskyInverseTraits::CHOLESKY_OUT,
-                                typename CholeskyInverseTraits::CHOLESKY_TRAITS>(matrixAStrm, matrixUStrm);
+                                typename CholeskyInverseTraits::CHOLESKY_TRAITS, Layout>(matrixAStrm, matrixUStrm);
 
     // Run back-substitution to compute U^-1
     // This doesn't work in-place, so use an additional array InverseU
     backSubstitute<RowsColsA, typename CholeskyInverseTraits::CHOLESKY_OUT,
                    typename CholeskyInverseTraits::BACK_SUBSTITUTE_OUT,
-                   typename CholeskyInverseTraits::BACK_SUBSTITUTE_TRAITS>(matrixUStrm, matrixInverseUStrm, U_singular);
+                   typename CholeskyInverseTraits::BACK_SUBSTITUTE_TRAITS, INTERNAL_LAYOUT>(
+        matrixUStrm, matrixInverseUStrm, U_singular);
     // A^-1 = U^-1*U^-t (equivalent to L-t*L-1)
     matrixMultiply<NoTranspose, ConjugateTranspose, RowsColsA, RowsColsA, RowsColsA, RowsColsA,
                    typename CholeskyInverseTraits::BACK_SUBSTITUTE_OUT, OutputType,
-                   typename CholeskyInverseTraits::MATRIX_MULTIPLY_TRAITS>(matrixInverseUStrm, matrixInverseAStrm);
+                   typename CholeskyInverseTraits::MATRIX_MULTIPLY_TRAITS, INTERNAL_LAYOUT>(matrixInverseUStrm,
+                                                                                          matrixInverseAStrm);
 }
 
 } // end namespace solver
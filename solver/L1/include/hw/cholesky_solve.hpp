@@ -0,0 +1,168 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cholesky_solve.hpp
+ * @brief This file contains the fused Cholesky solver
+ *   - choleskySolve : Entry point function, solves A*X = B by forward and backward substitution against the
+ *                     on-chip Cholesky factor, without forming the inverse
+ */
+
+#ifndef _XF_SOLVER_CHOLESKY_SOLVE_HPP_
+#define _XF_SOLVER_CHOLESKY_SOLVE_HPP_
+
+#include "ap_fixed.h"
+#include "hls_x_complex.h"
+#include "utils/std_complex_utils.h"
+#include "utils/x_matrix_utils.hpp"
+#include "hls_stream.h"
+#include <complex>
+
+#include "cholesky.hpp"
+
+namespace xf {
+namespace solver {
+
+// ===================================================================================================================
+// choleskySolveSubst: L*y = b then L^H*x = y for all right-hand sides, in place in X.
+// o The right-hand sides are interleaved in the inner loop, so each accumulator is revisited every NRHS cycles and
+//   the accumulation latency is hidden once NRHS covers it. The dependence is declared at that distance, so a
+//   smaller NRHS costs II rather than correctness.
+template <int RowsColsA, int NRHS, typename CholeskyTraits, class OutputType>
+void choleskySolveSubst(const OutputType L[RowsColsA][RowsColsA],
+                        const typename CholeskyTraits::RECIP_DIAG_T diag_recip[RowsColsA],
+                        OutputType X[RowsColsA][NRHS]) {
+    typename CholeskyTraits::ACCUM_T sum[NRHS];
+
+forward_loop:
+    for (int i = 0; i < RowsColsA; i++) {
+    forward_init:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            sum[c] = X[i][c];
+        }
+    forward_k:
+        for (int kc = 0; kc < i * NRHS; kc++) {
+#pragma HLS PIPELINE II = CholeskyTraits::INNER_II
+#pragma HLS DEPENDENCE variable = sum inter distance = NRHS true
+#pragma HLS loop_tripcount max = RowsColsA * NRHS
+            int k = kc / NRHS;
+            int c = kc % NRHS;
+            typename CholeskyTraits::PROD_T pr = (typename CholeskyTraits::PROD_T)(-L[i][k] * X[k][c]);
+            sum[c] = sum[c] + (typename CholeskyTraits::ACCUM_T)pr;
+        }
+    forward_scale:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            typename CholeskyTraits::OFF_DIAG_T y = (typename CholeskyTraits::OFF_DIAG_T)sum[c];
+            typename CholeskyTraits::OFF_DIAG_T y_scaled;
+            cholesky_prod_sum_mult(y, diag_recip[i], y_scaled);
+            X[i][c] = y_scaled;
+        }
+    }
+
+backward_loop:
+    for (int i = RowsColsA - 1; i >= 0; i--) {
+    backward_init:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            sum[c] = X[i][c];
+        }
+    backward_k:
+        for (int kc = (i + 1) * NRHS; kc < RowsColsA * NRHS; kc++) {
+#pragma HLS PIPELINE II = CholeskyTraits::INNER_II
+#pragma HLS DEPENDENCE variable = sum inter distance = NRHS true
+#pragma HLS loop_tripcount max = RowsColsA * NRHS
+            int k = kc / NRHS;
+            int c = kc % NRHS;
+            typename CholeskyTraits::PROD_T pr = (typename CholeskyTraits::PROD_T)(-hls::x_conj(L[k][i]) * X[k][c]);
+            sum[c] = sum[c] + (typename CholeskyTraits::ACCUM_T)pr;
+        }
+    backward_scale:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            typename CholeskyTraits::OFF_DIAG_T x = (typename CholeskyTraits::OFF_DIAG_T)sum[c];
+            typename CholeskyTraits::OFF_DIAG_T x_scaled;
+            cholesky_prod_sum_mult(x, diag_recip[i], x_scaled);
+            X[i][c] = x_scaled;
+        }
+    }
+}
+
+/**
+ * @brief choleskySolve: solves A*X = B for a Hermitian/symmetric positive definite A
+ *
+ * A is factored as L*L^H with the architecture selected by choleskyTop, then X is obtained by forward and backward
+ * substitution against L while it is still on chip, O(N^2) per right-hand side instead of forming A^-1.
+ *
+ * @tparam RowsColsA         Defines the matrix dimensions
+ * @tparam NRHS              Number of right-hand sides, the columns of B and X
+ * @tparam InputType         Input data type
+ * @tparam OutputType        Output data type, also used for L and the intermediate solution
+ * @tparam TRAITS            choleskyTraits class defining the internal types
+ *
+ * @param matrixAStrm        Stream of the input matrix, RowsColsA x RowsColsA, row by row
+ * @param matrixBStrm        Stream of the right-hand sides, RowsColsA x NRHS, row by row
+ * @param matrixXStrm        Stream of the solution, RowsColsA x NRHS, row by row
+ * @return                   0 = Success. 1 = A is not positive definite.
+ */
+template <int RowsColsA,
+          int NRHS,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<true, RowsColsA, InputType, OutputType> >
+int choleskySolve(hls::stream<InputType>& matrixAStrm,
+                  hls::stream<InputType>& matrixBStrm,
+                  hls::stream<OutputType>& matrixXStrm) {
+    InputType A[RowsColsA][RowsColsA];
+    OutputType L[RowsColsA][RowsColsA];
+    typename TRAITS::RECIP_DIAG_T diag_recip[RowsColsA];
+    OutputType X[RowsColsA][NRHS];
+
+read_loop:
+    for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        A[i / RowsColsA][i % RowsColsA] = matrixAStrm.read();
+    }
+read_b_loop:
+    for (int i = 0; i < RowsColsA * NRHS; i++) {
+#pragma HLS PIPELINE II = 1
+        X[i / NRHS][i % NRHS] = matrixBStrm.read();
+    }
+
+    // The upper triangle of L is never read, so its zero loop is skipped
+    int ret = choleskyTop<true, RowsColsA, choleskyPackedTraits<TRAITS>, InputType, OutputType>(A, L);
+
+diag_recip_loop:
+    for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        cholesky_recip(hls::x_real(L[i][i]), diag_recip[i]);
+    }
+
+    choleskySolveSubst<RowsColsA, NRHS, TRAITS, OutputType>(L, diag_recip, X);
+
+write_loop:
+    for (int i = 0; i < RowsColsA * NRHS; i++) {
+#pragma HLS PIPELINE II = 1
+        matrixXStrm.write(X[i / NRHS][i % NRHS]);
+    }
+    return ret;
+}
+
+} // namespace solver
+} // namespace xf
+
+#endif // _XF_SOLVER_CHOLESKY_SOLVE_HPP_
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cholesky_update.hpp
+ * @brief This file contains the rank-1 update and downdate of a Cholesky factor
+ *   - choleskyUpdate   : Entry point function, factor of A + x*x^H from the factor of A
+ *   - choleskyDowndate : Entry point function, factor of A - x*x^H from the factor of A
+ *   - choleskyRank1    : Rotation core shared by both
+ *
+ * L is read and written in the layout cholesky emits for the same LowerTriangularL and Layout, so a factor can be
+ * kept up to date as samples enter and leave a sliding window in O(N^2) instead of refactoring in O(N^3).
+ */
+
+#ifndef _XF_SOLVER_CHOLESKY_UPDATE_HPP_
+#define _XF_SOLVER_CHOLESKY_UPDATE_HPP_
+
+#include "ap_fixed.h"
+#include "hls_x_complex.h"
+#include "utils/std_complex_utils.h"
+#include "utils/x_matrix_utils.hpp"
+#include "hls_stream.h"
+#include <complex>
+
+#include "cholesky.hpp"
+
+namespace xf {
+namespace solver {
+
+// ===================================================================================================================
+// choleskyRank1: one Givens (update) or hyperbolic (downdate) rotation per column, applied in place to L.
+// o For column k with r = sqrt(L[k][k]^2 +/- |x[k]|^2), c = L[k][k]/r and s = x[k]/r:
+//     L[i][k] = c*L[i][k] +/- conj(s)*x[i]
+//     x[i]    = c*x[i] - s*L[i][k]        (old L[i][k])
+//   for all i > k. The rows are independent, so the inner loop pipelines at II=1.
+// o For an upper triangular factor the same rotation is applied to U = L^H.
+// o Returns 1 when a downdate leaves a non positive diagonal, i.e. A - x*x^H is not positive definite.
+template <bool LowerTriangularL, int RowsColsA, bool Downdate, typename CholeskyTraits, class InputType, class OutputType>
+int choleskyRank1(OutputType L[RowsColsA][RowsColsA], const InputType x[RowsColsA]) {
+    int return_code = 0;
+
+    typename CholeskyTraits::OFF_DIAG_T x_work[RowsColsA];
+
+init_x:
+    for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        x_work[i] = x[i];
+    }
+
+col_loop:
+    for (int k = 0; k < RowsColsA; k++) {
+        typename CholeskyTraits::OFF_DIAG_T xk = x_work[k];
+        typename CholeskyTraits::RECIP_DIAG_T Lkk = hls::x_real(L[k][k]);
+
+        // Rotated diagonal
+        typename CholeskyTraits::ACCUM_T Lkk_sq;
+        chol_assign_real(Lkk_sq, Lkk * Lkk);
+        typename CholeskyTraits::ACCUM_T xk_sq = (typename CholeskyTraits::PROD_T)(xk * hls::x_conj(xk));
+        typename CholeskyTraits::ACCUM_T rad;
+        if (Downdate) {
+            rad = Lkk_sq - xk_sq;
+        } else {
+            rad = Lkk_sq + xk_sq;
+        }
+        typename CholeskyTraits::DIAG_T rad_cast = rad;
+        typename CholeskyTraits::DIAG_T new_Lkk;
+        if (cholesky_sqrt_op(rad_cast, new_Lkk) || hls::x_real(new_Lkk) == 0) {
+            return_code = 1;
+        }
+        typename CholeskyTraits::RECIP_DIAG_T inv_r;
+        cholesky_recip(hls::x_real(new_Lkk), inv_r);
+        chol_assign_real(L[k][k], hls::x_real(new_Lkk));
+
+        // Rotation coefficients
+        typename CholeskyTraits::RECIP_DIAG_T c = Lkk * inv_r;
+        typename CholeskyTraits::OFF_DIAG_T s;
+        cholesky_prod_sum_mult(xk, inv_r, s);
+        typename CholeskyTraits::OFF_DIAG_T s_conj = hls::x_conj(s);
+
+    row_loop:
+        for (int i = k + 1; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = CholeskyTraits::INNER_II
+#pragma HLS loop_tripcount max = RowsColsA
+            typename CholeskyTraits::OFF_DIAG_T Lik;
+            if (LowerTriangularL) {
+                Lik = L[i][k];
+            } else {
+                Lik = hls::x_conj(L[k][i]);
+            }
+            typename CholeskyTraits::OFF_DIAG_T xi = x_work[i];
+
+            typename CholeskyTraits::OFF_DIAG_T c_Lik;
+            typename CholeskyTraits::OFF_DIAG_T c_xi;
+            cholesky_prod_sum_mult(Lik, c, c_Lik);
+            cholesky_prod_sum_mult(xi, c, c_xi);
+            typename CholeskyTraits::OFF_DIAG_T s_xi = s_conj * xi;
+            typename CholeskyTraits::OFF_DIAG_T s_Lik = s * Lik;
+
+            typename CholeskyTraits::OFF_DIAG_T new_Lik;
+            if (Downdate) {
+                new_Lik = c_Lik - s_xi;
+            } else {
+                new_Lik = c_Lik + s_xi;
+            }
+            x_work[i] = c_xi - s_Lik;
+
+            OutputType new_Lik_out = new_Lik;
+            if (LowerTriangularL) {
+                L[i][k] = new_Lik_out;
+            } else {
+                L[k][i] = hls::x_conj(new_Lik_out);
+            }
+        }
+    }
+    return return_code;
+}
+
+// ===================================================================================================================
+// choleskyRank1Stream: reads L and x, applies the rotation and writes the new L in the same layout.
+template <bool LowerTriangularL,
+          int RowsColsA,
+          bool Downdate,
+          typename TRAITS,
+          class Layout,
+          class InputType,
+          class OutputType>
+int choleskyRank1Stream(hls::stream<OutputType>& matrixLStrm,
+                        hls::stream<InputType>& vectorXStrm,
+                        hls::stream<OutputType>& matrixLUpdStrm) {
+    OutputType L[RowsColsA][RowsColsA];
+    InputType x[RowsColsA];
+
+    if (Layout::LayoutType == 0) {
+    read_loop:
+        for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+            L[i / RowsColsA][i % RowsColsA] = matrixLStrm.read();
+        }
+    } else {
+        // cholesky packs L on its own side
+        int r = 0;
+        int c = 0;
+    packed_read_loop:
+        for (int i = 0; i < layoutStreamSize<Layout, RowsColsA>::Value; i++) {
+#pragma HLS PIPELINE II = 1
+            L[r][c] = matrixLStrm.read();
+            if (LowerTriangularL)
+                layoutNext<PackedLower, RowsColsA>(r, c);
+            else
+                layoutNext<PackedUpper, RowsColsA>(r, c);
+        }
+    }
+read_x_loop:
+    for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        x[i] = vectorXStrm.read();
+    }
+
+    int ret = choleskyRank1<LowerTriangularL, RowsColsA, Downdate, TRAITS, InputType, OutputType>(L, x);
+
+    if (Layout::LayoutType == 0) {
+    write_loop:
+        for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+            matrixLUpdStrm.write(L[i / RowsColsA][i % RowsColsA]);
+        }
+    } else {
+        int r = 0;
+        int c = 0;
+    packed_write_loop:
+        for (int i = 0; i < layoutStreamSize<Layout, RowsColsA>::Value; i++) {
+#pragma HLS PIPELINE II = 1
+            matrixLUpdStrm.write(L[r][c]);
+            if (LowerTriangularL)
+                layoutNext<PackedLower, RowsColsA>(r, c);
+            else
+                layoutNext<PackedUpper, RowsColsA>(r, c);
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief choleskyUpdate: rank-1 update, computes the Cholesky factor of A + x*x^H from the factor of A
+ *
+ * @tparam LowerTriangularL  When false L is upper triangular, must match the cholesky call that produced it
+ * @tparam RowsColsA         Defines the matrix dimensions
+ * @tparam InputType         Data type of the update vector
+ * @tparam OutputType        Data type of the factor
+ * @tparam TRAITS            choleskyTraits class defining the internal types
+ * @tparam Layout            Stream layout of L, as passed to cholesky
+ *
+ * @param matrixLStrm        Stream of the current factor
+ * @param vectorXStrm        Stream of the update vector x, RowsColsA elements
+ * @param matrixLUpdStrm     Stream of the updated factor, same layout as matrixLStrm
+ * @return                   Always 0, an update cannot lose positive definiteness.
+ */
+template <bool LowerTriangularL,
+          int RowsColsA,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType>,
+          class Layout = FullLayout>
+int choleskyUpdate(hls::stream<OutputType>& matrixLStrm,
+                   hls::stream<InputType>& vectorXStrm,
+                   hls::stream<OutputType>& matrixLUpdStrm) {
+    return choleskyRank1Stream<LowerTriangularL, RowsColsA, false, TRAITS, Layout, InputType, OutputType>(
+        matrixLStrm, vectorXStrm, matrixLUpdStrm);
+}
+
+/**
+ * @brief choleskyDowndate: rank-1 downdate, computes the Cholesky factor of A - x*x^H from the factor of A
+ *
+ * @tparam LowerTriangularL  When false L is upper triangular, must match the cholesky call that produced it
+ * @tparam RowsColsA         Defines the matrix dimensions
+ * @tparam InputType         Data type of the downdate vector
+ * @tparam OutputType        Data type of the factor
+ * @tparam TRAITS            choleskyTraits class defining the internal types
+ * @tparam Layout            Stream layout of L, as passed to cholesky
+ *
+ * @param matrixLStrm        Stream of the current factor
+ * @param vectorXStrm        Stream of the downdate vector x, RowsColsA elements
+ * @param matrixLUpdStrm     Stream of the downdated factor, same layout as matrixLStrm
+ * @return                   0 = Success. 1 = A - x*x^H is not positive definite, the output is not valid.
+ */
+template <bool LowerTriangularL,
+          int RowsColsA,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType>,
+          class Layout = FullLayout>
+int choleskyDowndate(hls::stream<OutputType>& matrixLStrm,
+                     hls::stream<InputType>& vectorXStrm,
+                     hls::stream<OutputType>& matrixLUpdStrm) {
+    return choleskyRank1Stream<LowerTriangularL, RowsColsA, true, TRAITS, Layout, InputType, OutputType>(
+        matrixLStrm, vectorXStrm, matrixLUpdStrm);
+}
+
+} // namespace solver
+} // namespace xf
+
+#endif // _XF_SOLVER_CHOLESKY_UPDATE_HPP_
@@ -0,0 +1,350 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ldlt.hpp
+ * @brief This file contains the square-root-free LDL^H factorization and solver
+ *   - ldlt      : Entry point function, A = L*D*L^H with unit triangular L and real diagonal D
+ *   - ldltSolve : Entry point function, solves A*X = B through L*D*L^H without forming the inverse
+ *   - ldltCore  : Factorization core shared by both
+ *
+ * Internal types come from choleskyTraits, so a traits class written for cholesky can be reused. RECIP_DIAG_T
+ * holds D and 1/D, the other types play the same role as in choleskyAlt2.
+ * Unlike the Cholesky factor, L has a unit diagonal and its entries are not bounded by 1, so a fixed-point
+ * OutputType needs integer bits beyond the sign bit. L and the intermediate W = L*D are held in OutputType, and
+ * ldltCore rejects a fixed-point OutputType that cannot represent 1.0 at compile time.
+ */
+
+#ifndef _XF_SOLVER_LDLT_HPP_
+#define _XF_SOLVER_LDLT_HPP_
+
+#include "ap_fixed.h"
+#include "hls_x_complex.h"
+#include "utils/std_complex_utils.h"
+#include "utils/x_matrix_utils.hpp"
+#include "hls_stream.h"
+#include <complex>
+
+#include "cholesky.hpp"
+
+namespace xf {
+namespace solver {
+
+// ===================================================================================================================
+// ldltHoldsOne: whether a type can represent the unit diagonal of L exactly
+template <typename T>
+struct ldltHoldsOne {
+    static const bool value = true;
+};
+template <int W, int I, ap_q_mode Q, ap_o_mode O, int N>
+struct ldltHoldsOne<ap_fixed<W, I, Q, O, N> > {
+    static const bool value = (I >= 2);
+};
+template <int W, int I, ap_q_mode Q, ap_o_mode O, int N>
+struct ldltHoldsOne<ap_ufixed<W, I, Q, O, N> > {
+    static const bool value = (I >= 1);
+};
+template <typename T>
+struct ldltHoldsOne<hls::x_complex<T> > {
+    static const bool value = ldltHoldsOne<T>::value;
+};
+template <typename T>
+struct ldltHoldsOne<std::complex<T> > {
+    static const bool value = ldltHoldsOne<T>::value;
+};
+
+// ===================================================================================================================
+// ldltCore: column-by-column LDL^H, no square root on the critical path.
+// o For every column the pivot only needs one reciprocal, which is off the MAC path: the off-diagonal sums are
+//   accumulated unscaled (W = L*D) and scaled by 1/D at the end, the same IU-lane blocking as choleskyAlt2.
+// o L_internal holds the unit lower factor, D and D_recip the diagonal and its reciprocal.
+// o Returns 1 when a pivot is zero; negative pivots are valid, the input only has to be Hermitian.
+template <bool LowerTriangularL, int RowsColsA, typename CholeskyTraits, class InputType, class OutputType>
+int ldltCore(const InputType A[RowsColsA][RowsColsA],
+             OutputType L_internal[RowsColsA][RowsColsA],
+             typename CholeskyTraits::RECIP_DIAG_T D[RowsColsA],
+             typename CholeskyTraits::RECIP_DIAG_T D_recip[RowsColsA]) {
+    static_assert(ldltHoldsOne<OutputType>::value,
+                  "ldlt: a fixed-point OutputType needs at least 2 integer bits to hold the unit diagonal of L");
+    int return_code = 0;
+
+    OutputType W_internal[RowsColsA][RowsColsA];
+    typename CholeskyTraits::ACCUM_T diag_sum[RowsColsA];
+#pragma HLS ARRAY_PARTITION variable = diag_sum complete
+#pragma HLS ARRAY_PARTITION variable = A cyclic dim = CholeskyTraits::UNROLL_DIM factor = CholeskyTraits::IU
+#pragma HLS ARRAY_PARTITION variable = L_internal cyclic dim = 1 factor = CholeskyTraits::IU
+
+init_diag:
+    for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        diag_sum[i] = 0;
+    }
+
+col_loop:
+    for (int j = 0; j < RowsColsA; j++) {
+        // Pivot: D[j] = A[j][j] - sum(|L[j][k]|^2 * D[k])
+        typename CholeskyTraits::ACCUM_T Ajj = A[j][j];
+        typename CholeskyTraits::ADD_T Aminus = Ajj - diag_sum[j];
+        typename CholeskyTraits::DIAG_T Aminus_cast = Aminus;
+        typename CholeskyTraits::RECIP_DIAG_T Djj = hls::x_real(Aminus_cast);
+        typename CholeskyTraits::RECIP_DIAG_T inv_Djj;
+        if (Djj == 0) return_code = 1;
+        cholesky_recip(Djj, inv_Djj);
+        D[j] = Djj;
+        D_recip[j] = inv_Djj;
+        L_internal[j][j] = 1;
+
+    iblock_loop:
+        for (int ib = j + 1; ib < RowsColsA; ib += CholeskyTraits::IU) {
+#pragma HLS loop_tripcount max = RowsColsA / CholeskyTraits::IU
+            typename CholeskyTraits::ACCUM_T psum[CholeskyTraits::IU];
+#pragma HLS ARRAY_PARTITION variable = psum complete
+
+        init_ps:
+            for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                int ii = ib + u;
+                if (ii < RowsColsA) {
+                    psum[u] = LowerTriangularL ? (typename CholeskyTraits::ACCUM_T)A[ii][j]
+                                               : (typename CholeskyTraits::ACCUM_T)hls::x_conj(A[j][ii]);
+                }
+            }
+
+        // W[i][j] = A[i][j] - sum(L[i][k] * conj(W[j][k]))
+        k_loop:
+            for (int k = 0; k < j; k++) {
+#pragma HLS PIPELINE II = CholeskyTraits::INNER_II
+#pragma HLS loop_tripcount max = RowsColsA
+                OutputType top = -hls::x_conj(W_internal[j][k]);
+            lanes:
+                for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                    int ii = ib + u;
+                    if (ii < RowsColsA) {
+                        typename CholeskyTraits::PROD_T pr =
+                            (typename CholeskyTraits::PROD_T)(L_internal[ii][k] * top);
+                        psum[u] = psum[u] + (typename CholeskyTraits::ACCUM_T)pr;
+                    }
+                }
+            }
+
+        // L[i][j] = W[i][j] / D[j], and |L[i][j]|^2 * D[j] = conj(W[i][j]) * L[i][j] for the later pivots
+        finalize_lanes:
+            for (int u = 0; u < CholeskyTraits::IU; u++) {
+#pragma HLS UNROLL
+                int ii = ib + u;
+                if (ii < RowsColsA) {
+                    typename CholeskyTraits::OFF_DIAG_T off = (typename CholeskyTraits::OFF_DIAG_T)psum[u];
+                    typename CholeskyTraits::OFF_DIAG_T Lij;
+                    cholesky_prod_sum_mult(off, inv_Djj, Lij);
+
+                    OutputType Wij_out = off;
+                    typename CholeskyTraits::L_OUTPUT_T Lij_cast = Lij;
+                    OutputType Lij_out = Lij_cast;
+                    W_internal[ii][j] = Wij_out;
+                    L_internal[ii][j] = Lij_out;
+                    diag_sum[ii] = diag_sum[ii] + (typename CholeskyTraits::ACCUM_T)(hls::x_conj(Wij_out) * Lij_out);
+                }
+            }
+        }
+    }
+    return return_code;
+}
+
+/**
+ * @brief ldlt: square-root-free factorization A = L*D*L^H (or U^H*D*U)
+ *
+ * @tparam LowerTriangularL  When false the upper factor U = L^H is output
+ * @tparam RowsColsA         Defines the matrix dimensions
+ * @tparam InputType         Input data type
+ * @tparam OutputType        Output data type
+ * @tparam TRAITS            choleskyTraits class defining the internal types
+ *
+ * @param matrixAStrm        Stream of the Hermitian/symmetric input matrix
+ * @param matrixLStrm        Stream of the unit triangular factor, RowsColsA*RowsColsA elements
+ * @param matrixDStrm        Stream of the diagonal of D, RowsColsA elements
+ * @return                   0 = Success. 1 = a pivot of D is zero.
+ */
+template <bool LowerTriangularL,
+          int RowsColsA,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<LowerTriangularL, RowsColsA, InputType, OutputType> >
+int ldlt(hls::stream<InputType>& matrixAStrm,
+         hls::stream<OutputType>& matrixLStrm,
+         hls::stream<OutputType>& matrixDStrm) {
+    InputType A[RowsColsA][RowsColsA];
+    OutputType L_internal[RowsColsA][RowsColsA];
+    typename TRAITS::RECIP_DIAG_T D[RowsColsA];
+    typename TRAITS::RECIP_DIAG_T D_recip[RowsColsA];
+
+read_loop:
+    for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        A[i / RowsColsA][i % RowsColsA] = matrixAStrm.read();
+    }
+
+    int ret = ldltCore<LowerTriangularL, RowsColsA, TRAITS, InputType, OutputType>(A, L_internal, D, D_recip);
+
+write_loop:
+    for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        int r = i / RowsColsA;
+        int c = i % RowsColsA;
+        OutputType v;
+        if (LowerTriangularL && c <= r)
+            v = L_internal[r][c];
+        else if (!LowerTriangularL && r <= c)
+            v = hls::x_conj(L_internal[c][r]);
+        else
+            v = 0;
+        matrixLStrm.write(v);
+    }
+write_d_loop:
+    for (int i = 0; i < RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        OutputType d;
+        chol_assign_real(d, D[i]);
+        matrixDStrm.write(d);
+    }
+    return ret;
+}
+
+// ===================================================================================================================
+// ldltSolveSubst: L*y = b, z = y / D, then L^H*x = z for all right-hand sides, in place in X. L has a unit diagonal.
+// o The right-hand sides are interleaved in the inner loops as in choleskySolveSubst, so each accumulator is
+//   revisited every NRHS cycles and the accumulation latency is hidden once NRHS covers it.
+template <int RowsColsA, int NRHS, typename CholeskyTraits, class OutputType>
+void ldltSolveSubst(const OutputType L[RowsColsA][RowsColsA],
+                    const typename CholeskyTraits::RECIP_DIAG_T D_recip[RowsColsA],
+                    OutputType X[RowsColsA][NRHS]) {
+    typename CholeskyTraits::ACCUM_T sum[NRHS];
+
+forward_loop:
+    for (int i = 0; i < RowsColsA; i++) {
+    forward_init:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            sum[c] = X[i][c];
+        }
+    forward_k:
+        for (int kc = 0; kc < i * NRHS; kc++) {
+#pragma HLS PIPELINE II = CholeskyTraits::INNER_II
+#pragma HLS DEPENDENCE variable = sum inter distance = NRHS true
+#pragma HLS loop_tripcount max = RowsColsA * NRHS
+            int k = kc / NRHS;
+            int c = kc % NRHS;
+            typename CholeskyTraits::PROD_T pr = (typename CholeskyTraits::PROD_T)(-L[i][k] * X[k][c]);
+            sum[c] = sum[c] + (typename CholeskyTraits::ACCUM_T)pr;
+        }
+    forward_store:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            X[i][c] = sum[c];
+        }
+    }
+
+// y feeds the later rows unscaled, so the 1/D scaling runs after the whole forward pass
+scale_loop:
+    for (int i = 0; i < RowsColsA * NRHS; i++) {
+#pragma HLS PIPELINE II = 1
+        typename CholeskyTraits::OFF_DIAG_T y = (typename CholeskyTraits::OFF_DIAG_T)X[i / NRHS][i % NRHS];
+        typename CholeskyTraits::OFF_DIAG_T z;
+        cholesky_prod_sum_mult(y, D_recip[i / NRHS], z);
+        X[i / NRHS][i % NRHS] = z;
+    }
+
+backward_loop:
+    for (int i = RowsColsA - 1; i >= 0; i--) {
+    backward_init:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            sum[c] = X[i][c];
+        }
+    backward_k:
+        for (int kc = (i + 1) * NRHS; kc < RowsColsA * NRHS; kc++) {
+#pragma HLS PIPELINE II = CholeskyTraits::INNER_II
+#pragma HLS DEPENDENCE variable = sum inter distance = NRHS true
+#pragma HLS loop_tripcount max = RowsColsA * NRHS
+            int k = kc / NRHS;
+            int c = kc % NRHS;
+            typename CholeskyTraits::PROD_T pr = (typename CholeskyTraits::PROD_T)(-hls::x_conj(L[k][i]) * X[k][c]);
+            sum[c] = sum[c] + (typename CholeskyTraits::ACCUM_T)pr;
+        }
+    backward_store:
+        for (int c = 0; c < NRHS; c++) {
+#pragma HLS PIPELINE II = 1
+            X[i][c] = sum[c];
+        }
+    }
+}
+
+/**
+ * @brief ldltSolve: solves A*X = B with A = L*D*L^H, by forward substitution, diagonal scaling and backward
+ * substitution against the on-chip factor.
+ *
+ * @tparam RowsColsA         Defines the matrix dimensions
+ * @tparam NRHS              Number of right-hand sides, the columns of B and X
+ * @tparam InputType         Input data type
+ * @tparam OutputType        Output data type
+ * @tparam TRAITS            choleskyTraits class defining the internal types
+ *
+ * @param matrixAStrm        Stream of the Hermitian/symmetric input matrix
+ * @param matrixBStrm        Stream of the right-hand sides, RowsColsA x NRHS, row by row
+ * @param matrixXStrm        Stream of the solution, RowsColsA x NRHS, row by row
+ * @return                   0 = Success. 1 = a pivot of D is zero.
+ */
+template <int RowsColsA,
+          int NRHS,
+          class InputType,
+          class OutputType,
+          typename TRAITS = choleskyTraits<true, RowsColsA, InputType, OutputType> >
+int ldltSolve(hls::stream<InputType>& matrixAStrm,
+              hls::stream<InputType>& matrixBStrm,
+              hls::stream<OutputType>& matrixXStrm) {
+    InputType A[RowsColsA][RowsColsA];
+    OutputType L_internal[RowsColsA][RowsColsA];
+    typename TRAITS::RECIP_DIAG_T D[RowsColsA];
+    typename TRAITS::RECIP_DIAG_T D_recip[RowsColsA];
+    OutputType X[RowsColsA][NRHS];
+
+read_loop:
+    for (int i = 0; i < RowsColsA * RowsColsA; i++) {
+#pragma HLS PIPELINE II = 1
+        A[i / RowsColsA][i % RowsColsA] = matrixAStrm.read();
+    }
+read_b_loop:
+    for (int i = 0; i < RowsColsA * NRHS; i++) {
+#pragma HLS PIPELINE II = 1
+        X[i / NRHS][i % NRHS] = matrixBStrm.read();
+    }
+
+    int ret = ldltCore<true, RowsColsA, TRAITS, InputType, OutputType>(A, L_internal, D, D_recip);
+
+    ldltSolveSubst<RowsColsA, NRHS, TRAITS, OutputType>(L_internal, D_recip, X);
+
+write_loop:
+    for (int i = 0; i < RowsColsA * NRHS; i++) {
+#pragma HLS PIPELINE II = 1
+        matrixXStrm.write(X[i / NRHS][i % NRHS]);
+    }
+    return ret;
+}
+
+} // namespace solver
+} // namespace xf
+
+#endif // _XF_SOLVER_LDLT_HPP_
@@ -568,6 +568,48 @@ void matrixMultiplyTop(const InputType A[RowsA][ColsA], const InputType B[RowsB]
     }
 }
 
+// ===================================================================================================================
+// matrixMultiplyReadPacked: reads a triangular A carried in a packed layout, the missing triangle is zero.
+// The loop still visits all RowsA*ColsA positions to zero-fill the array, so a packed A saves stream traffic but
+// not read latency.
+template <class LayoutA, int RowsA, int ColsA, typename InputType>
+void matrixMultiplyReadPacked(hls::stream<InputType>& matrixAStrm, InputType A[RowsA][ColsA]) {
+    assert(RowsA == ColsA);
+    for (int r = 0; r < RowsA; r++) {
+        for (int c = 0; c < ColsA; c++) {
+#pragma HLS PIPELINE II = 1
+            bool inStream = (LayoutA::LayoutType == 1 ? c <= r : c >= r);
+            InputType a;
+            if (inStream)
+                a = matrixAStrm.read();
+            else
+                a = 0;
+            A[r][c] = a;
+        }
+    }
+}
+
+// Same, writing both operands of the single-stream matrixMultiply in the one pass over the stream
+template <class LayoutA, int RowsA, int ColsA, typename InputType>
+void matrixMultiplyReadPacked(hls::stream<InputType>& matrixAStrm,
+                              InputType A1[RowsA][ColsA],
+                              InputType A2[RowsA][ColsA]) {
+    assert(RowsA == ColsA);
+    for (int r = 0; r < RowsA; r++) {
+        for (int c = 0; c < ColsA; c++) {
+#pragma HLS PIPELINE II = 1
+            bool inStream = (LayoutA::LayoutType == 1 ? c <= r : c >= r);
+            InputType a;
+            if (inStream)
+                a = matrixAStrm.read();
+            else
+                a = 0;
+            A1[r][c] = a;
+            A2[r][c] = a;
+        }
+    }
+}
+
 /**
  * @brief matrixMultiply entry point function for calculating matrix power.
  *
@@ -581,6 +623,8 @@ void matrixMultiplyTop(const InputType A[RowsA][ColsA], const InputType B[RowsB]
  *  @tparam InputType         Input data type
  *  @tparam OutputType        Output data type
  *  @tparam TRAITS            Traits class
+ *  @tparam LayoutA           Stream layout of A: FullLayout, or PackedLower/PackedUpper for a triangular A. A packed
+ * A streams RowsA*(RowsA+1)/2 elements, but the read still takes RowsA*ColsA cycles to zero-fill the missing triangle.
  *
  *  @param matrixAStrm        Stream of input matrix
  *  @param matrixCStrm        Stream of A^2 product output matrix
@@ -595,18 +639,23 @@ template <
     typename InputType,
     typename OutputType,
     typename TRAITS =
-        matrixMultiplyTraits<TransposeFormA1, TransposeFormA2, RowsA, ColsA, RowsA, ColsA, InputType, OutputType> >
+        matrixMultiplyTraits<TransposeFormA1, TransposeFormA2, RowsA, ColsA, RowsA, ColsA, InputType, OutputType>,
+    class LayoutA = FullLayout>
 void matrixMultiply(hls::stream<InputType>& matrixAStrm, hls::stream<OutputType>& matrixCStrm) {
     InputType A1[RowsA][ColsA];
     InputType A2[RowsA][ColsA];
     OutputType C[RowsC][ColsC];
 
-    for (int r = 0; r < RowsA; r++) {
+    if (LayoutA::LayoutType == 0) {
+        for (int r = 0; r < RowsA; r++) {
 #pragma HLS PIPELINE
-        for (int c = 0; c < ColsA; c++) {
-            matrixAStrm.read(A1[r][c]);
-            A2[r][c] = A1[r][c];
+            for (int c = 0; c < ColsA; c++) {
+                matrixAStrm.read(A1[r][c]);
+                A2[r][c] = A1[r][c];
+            }
         }
+    } else {
+        matrixMultiplyReadPacked<LayoutA, RowsA, ColsA, InputType>(matrixAStrm, A1, A2);
     }
     matrixMultiplyTop<TransposeFormA1, TransposeFormA2, RowsA, ColsA, RowsA, ColsA, RowsC, ColsC, TRAITS, InputType,
                       OutputType>(A1, A2, C);
@@ -632,6 +681,8 @@ void matrixMultiply(hls::stream<InputType>& matrixAStrm, hls::stream<OutputType>
  *  @tparam InputType         Input data type
  *  @tparam OutputType        Output data type
  *  @tparam TRAITS            Traits class
+ *  @tparam LayoutA           Stream layout of A: FullLayout, or PackedLower/PackedUpper for a triangular A. A packed
+ * A streams RowsA*(RowsA+1)/2 elements, but the read still takes RowsA*ColsA cycles to zero-fill the missing triangle.
  *
  *  @param matrixAStrm        Stream of First input matrix
  *  @param matrixBStrm        Stream of Second input matrix
@@ -648,7 +699,8 @@ template <class TransposeFormA,
           typename InputType,
           typename OutputType,
           typename TRAITS =
-              matrixMultiplyTraits<TransposeFormA, TransposeFormB, RowsA, ColsA, RowsB, ColsB, InputType, OutputType> >
+              matrixMultiplyTraits<TransposeFormA, TransposeFormB, RowsA, ColsA, RowsB, ColsB, InputType, OutputType>,
+          class LayoutA = FullLayout>
 void matrixMultiply(hls::stream<InputType>& matrixAStrm,
                     hls::stream<InputType>& matrixBStrm,
                     hls::stream<OutputType>& matrixCStrm) {
@@ -656,11 +708,15 @@ void matrixMultiply(hls::stream<InputType>& matrixAStrm,
     InputType B[RowsB][ColsB];
     OutputType C[RowsC][ColsC];
 
-    for (int r = 0; r < RowsA; r++) {
+    if (LayoutA::LayoutType == 0) {
+        for (int r = 0; r < RowsA; r++) {
 #pragma HLS PIPELINE
-        for (int c = 0; c < ColsA; c++) {
-            matrixAStrm.read(A[r][c]);
+            for (int c = 0; c < ColsA; c++) {
+                matrixAStrm.read(A[r][c]);
+            }
         }
+    } else {
+        matrixMultiplyReadPacked<LayoutA, RowsA, ColsA, InputType>(matrixAStrm, A);
     }
     for (int r = 0; r < RowsB; r++) {
 #pragma HLS PIPELINE
@@ -70,6 +70,42 @@ InputType GetMatrixElement(const InputType A[RowsA][ColsA], unsigned Row, unsign
     return TransposeForm::template GetElement<RowsA, ColsA, InputType>(A, Row, Col);
 }
 
+// ===================================================================================================================
+// Stream Layouts for square matrices
+// o FullLayout  : all elements, row by row.
+// o PackedLower : lower triangle only, row by row: [0][0], [1][0], [1][1], [2][0], ... (RowsCols*(RowsCols+1)/2)
+// o PackedUpper : upper triangle only, row by row: [0][0], [0][1], ... [0][N-1], [1][1], ... (RowsCols*(RowsCols+1)/2)
+// What the missing triangle means is up to the function: for a Hermitian input it is implied by symmetry, for a
+// triangular input it is zero.
+struct FullLayout {
+    const static int LayoutType = 0;
+};
+
+struct PackedLower {
+    const static int LayoutType = 1;
+};
+
+struct PackedUpper {
+    const static int LayoutType = 2;
+};
+
+// Number of elements carried on the stream
+template <class Layout, int RowsCols>
+struct layoutStreamSize {
+    const static int Value = (Layout::LayoutType == 0 ? RowsCols * RowsCols : RowsCols * (RowsCols + 1) / 2);
+};
+
+// Advances (Row, Col) to the next element carried on the stream
+template <class Layout, int RowsCols>
+void layoutNext(int& Row, int& Col) {
+    if (Layout::LayoutType == 1 ? (Col == Row) : (Col == RowsCols - 1)) {
+        Row++;
+        Col = (Layout::LayoutType == 2 ? Row : 0);
+    } else {
+        Col++;
+    }
+}
+
 // ===================================================================================================================
 // Common math operations and constants. Wrappers/templates to select the correct function based on type.
 
@@ -28,5 +28,8 @@
 #include "hw/svd.hpp"
 #include "hw/cholesky_inverse.hpp"
 #include "hw/cholesky.hpp"
+#include "hw/cholesky_solve.hpp"
+#include "hw/cholesky_update.hpp"
+#include "hw/ldlt.hpp"
 
 #endif
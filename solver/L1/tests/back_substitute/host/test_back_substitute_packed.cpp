@@ -0,0 +1,108 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for backSubstitute with packed stream layouts.
+// The upper Cholesky factor U of each shared input matrix is inverted
+// from the full layout, and from its packed triangle through the kernel:
+// U itself for PackedUpper, U^H for PackedLower. The packed result must
+// be the matching triangle of the full-layout U^-1, or of its conjugate
+// transpose, bit for bit, with the same singular flag.
+// ======================================================================
+
+#include "kernel_back_substitute_packed.hpp"
+#include "hw/cholesky.hpp"
+#include "hw/back_substitute.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+
+int main(int argc, char* argv[]) {
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    MATRIX_IN_T U[DIM][DIM];
+    MATRIX_OUT_T B_expected[DIM][DIM];
+
+    printf("Running packed backSubstitute on %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM,
+           LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Mismatches" << std::endl;
+
+    for (unsigned int imat = 0; imat < NUM_MAT_TYPES; imat++) {
+        std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(imat + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_IN_T> matrixUStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) matrixAStrm.write(A[r][c]);
+        xf::solver::cholesky<false, DIM, MATRIX_IN_T, MATRIX_IN_T>(matrixAStrm, matrixUStrm);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) U[r][c] = matrixUStrm.read();
+
+        hls::stream<MATRIX_IN_T> fullUStrm;
+        hls::stream<MATRIX_OUT_T> fullBStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) fullUStrm.write(U[r][c]);
+        int singular_expected;
+        xf::solver::backSubstitute<DIM, MATRIX_IN_T, MATRIX_OUT_T>(fullUStrm, fullBStrm, singular_expected);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) B_expected[r][c] = fullBStrm.read();
+
+        hls::stream<MATRIX_IN_T> packedUStrm;
+        hls::stream<MATRIX_OUT_T> packedBStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) {
+                if (LOWER_TRIANGULAR && c <= r) packedUStrm.write(hls::x_conj(U[c][r]));
+                if (!LOWER_TRIANGULAR && c >= r) packedUStrm.write(U[r][c]);
+            }
+        int singular;
+        kernel_back_substitute_packed(packedUStrm, packedBStrm, singular);
+
+        unsigned int mismatch = 0;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) {
+                if (LOWER_TRIANGULAR && c <= r && packedBStrm.read() != hls::x_conj(B_expected[c][r])) mismatch++;
+                if (!LOWER_TRIANGULAR && c >= r && packedBStrm.read() != B_expected[r][c]) mismatch++;
+            }
+
+        std::cout << "RESULTS_TABLE," << imat + 1 << "," << mismatch << std::endl;
+        if (singular != singular_expected || mismatch != 0) {
+            std::cout << "ERROR: matrix type " << imat + 1 << " packed backSubstitute differs, singular " << singular
+                      << " (expected " << singular_expected << ")" << std::endl;
+            pass_fail = 1;
+        }
+        if (!packedUStrm.empty() || !packedBStrm.empty()) {
+            std::cout << "ERROR: packed streams not fully consumed" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
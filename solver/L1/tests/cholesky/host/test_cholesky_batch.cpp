@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for choleskyBatch.
+// Each batch result is compared against the single-matrix cholesky run on
+// the same input: L must match bit for bit and the return codes must agree.
+// One slot of the second batch holds a negated (indefinite) matrix so the
+// per-matrix return code is checked as well.
+// ======================================================================
+
+#include "kernel_cholesky_batch.hpp"
+#include "hw/cholesky.hpp"
+#include "src/utils.hpp"
+#include "src/type_test_utils.hpp"
+
+#include <stdio.h>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+const unsigned int NUM_BATCHES = 2;
+
+int main(int argc, char* argv[]) {
+    MATRIX_IN_T A[BATCH][DIM][DIM];
+    MATRIX_OUT_T L[BATCH][DIM][DIM];
+    MATRIX_OUT_T L_expected[DIM][DIM];
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    std::string data_path = std::string(DATA_PATH);
+    if (x_is_complex(A[0][0][0]) == true) {
+        data_path.append(x_is_fixed(A[0][0][0]) ? "/complex_fixed/" : "/complex_float/");
+    } else {
+        data_path.append(x_is_fixed(A[0][0][0]) ? "/fixed/" : "/float/");
+    }
+
+    printf("Running %u batches of %u %d x %d matrices with LowerTriangular set to %d\n", NUM_BATCHES, BATCH, DIM,
+           DIM, LOWER_TRIANGULAR);
+
+    for (unsigned int t = 0; t < NUM_BATCHES; t++) {
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_OUT_T> matrixLStrm;
+        hls::stream<int> returnCodeStrm;
+
+        for (unsigned int b = 0; b < BATCH; b++) {
+            unsigned int imat = (t * BATCH + b) % NUM_MAT_TYPES;
+            std::string file_A = data_path + "A_matType_" + std::to_string(imat + 1) + "_0.txt";
+            readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A[b]), DIM * DIM);
+            if (t == 1 && b == 1) {
+                for (int r = 0; r < DIM; r++)
+                    for (int c = 0; c < DIM; c++) A[b][r][c] = -A[b][r][c];
+            }
+            for (int r = 0; r < DIM; r++)
+                for (int c = 0; c < DIM; c++) matrixAStrm.write(A[b][r][c]);
+        }
+
+        kernel_cholesky_batch(matrixAStrm, matrixLStrm, returnCodeStrm);
+
+        for (unsigned int b = 0; b < BATCH; b++) {
+            for (int r = 0; r < DIM; r++)
+                for (int c = 0; c < DIM; c++) L[b][r][c] = matrixLStrm.read();
+            int ret = returnCodeStrm.read();
+
+            hls::stream<MATRIX_IN_T> refAStrm;
+            hls::stream<MATRIX_OUT_T> refLStrm;
+            for (int r = 0; r < DIM; r++)
+                for (int c = 0; c < DIM; c++) refAStrm.write(A[b][r][c]);
+            int ret_expected =
+                xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T>(refAStrm, refLStrm);
+            for (int r = 0; r < DIM; r++)
+                for (int c = 0; c < DIM; c++) L_expected[r][c] = refLStrm.read();
+
+            unsigned int mismatch = 0;
+            if (ret_expected == 0) {
+                for (int r = 0; r < DIM; r++)
+                    for (int c = 0; c < DIM; c++)
+                        if (L[b][r][c] != L_expected[r][c]) mismatch++;
+            }
+            if (ret != ret_expected || mismatch != 0) {
+                std::cout << "ERROR: batch " << t << " matrix " << b << " return code " << ret << " (expected "
+                          << ret_expected << "), " << mismatch << " mismatching elements" << std::endl;
+                pass_fail = 1;
+            }
+            if (t == 1 && b == 1 && ret == 0) {
+                std::cout << "ERROR: indefinite matrix not reported" << std::endl;
+                pass_fail = 1;
+            }
+        }
+        if (!matrixLStrm.empty() || !returnCodeStrm.empty()) {
+            std::cout << "ERROR: unexpected extra output" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
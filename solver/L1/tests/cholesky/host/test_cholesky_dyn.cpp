@@ -0,0 +1,135 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for choleskyDyn.
+// For every input matrix type, the leading n x n block of A is factored
+// for each n from 1 to DIM through one kernel sized for DIM. L and the
+// return code must match cholesky<n> on the same block bit for bit. The
+// negated type 1 matrix must be reported as indefinite at every n, and an
+// n outside [1, DIM] must return 1 without touching either stream.
+// ======================================================================
+
+#include "kernel_cholesky_dyn.hpp"
+#include "hw/cholesky.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+const unsigned int NUM_MATRICES = NUM_MAT_TYPES + 1;
+
+// cholesky<N> on the leading N x N block of A, N counting down to 1 at compile time
+template <int N>
+int refCholesky(const MATRIX_IN_T A[DIM][DIM], MATRIX_OUT_T L[DIM][DIM], int n) {
+    if (n != N) return refCholesky<N - 1>(A, L, n);
+    hls::stream<MATRIX_IN_T> refAStrm;
+    hls::stream<MATRIX_OUT_T> refLStrm;
+    for (int r = 0; r < N; r++)
+        for (int c = 0; c < N; c++) refAStrm.write(A[r][c]);
+    int ret = xf::solver::cholesky<LOWER_TRIANGULAR, N, MATRIX_IN_T, MATRIX_OUT_T>(refAStrm, refLStrm);
+    for (int r = 0; r < N; r++)
+        for (int c = 0; c < N; c++) L[r][c] = refLStrm.read();
+    return ret;
+}
+
+template <>
+int refCholesky<0>(const MATRIX_IN_T A[DIM][DIM], MATRIX_OUT_T L[DIM][DIM], int n) {
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    MATRIX_OUT_T L[DIM][DIM];
+    MATRIX_OUT_T L_expected[DIM][DIM];
+
+    printf("Running choleskyDyn on up to %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM,
+           LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,N,Return Code,Expected Return Code,Mismatches" << std::endl;
+
+    for (unsigned int m = 0; m < NUM_MATRICES; m++) {
+        // The last matrix reuses type 1 negated, which is not positive definite
+        bool negate = (m == NUM_MAT_TYPES);
+        std::string file_A =
+            std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(negate ? 1 : m + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+        if (negate) {
+            for (int r = 0; r < DIM; r++)
+                for (int c = 0; c < DIM; c++) A[r][c] = -A[r][c];
+        }
+
+        for (int n = 1; n <= DIM; n++) {
+            hls::stream<MATRIX_IN_T> matrixAStrm;
+            hls::stream<MATRIX_OUT_T> matrixLStrm;
+            for (int r = 0; r < n; r++)
+                for (int c = 0; c < n; c++) matrixAStrm.write(A[r][c]);
+            int ret = kernel_cholesky_dyn(matrixAStrm, matrixLStrm, n);
+            for (int r = 0; r < n; r++)
+                for (int c = 0; c < n; c++) L[r][c] = matrixLStrm.read();
+
+            int ret_expected = refCholesky<DIM>(A, L_expected, n);
+            unsigned int mismatch = 0;
+            if (ret_expected == 0) {
+                for (int r = 0; r < n; r++)
+                    for (int c = 0; c < n; c++)
+                        if (L[r][c] != L_expected[r][c]) mismatch++;
+            }
+            std::cout << "RESULTS_TABLE," << m + 1 << "," << n << "," << ret << "," << ret_expected << "," << mismatch
+                      << std::endl;
+            if (ret != ret_expected || mismatch != 0) {
+                std::cout << "ERROR: matrix " << m << " at n = " << n << " return code " << ret << " (expected "
+                          << ret_expected << "), " << mismatch << " mismatching elements" << std::endl;
+                pass_fail = 1;
+            }
+            if (negate && ret == 0) {
+                std::cout << "ERROR: indefinite matrix not reported at n = " << n << std::endl;
+                pass_fail = 1;
+            }
+            if (!matrixAStrm.empty() || !matrixLStrm.empty()) {
+                std::cout << "ERROR: unexpected data left in the streams at n = " << n << std::endl;
+                pass_fail = 1;
+            }
+        }
+    }
+
+    // Out of range dimensions are rejected before anything is read
+    const int bad_n[2] = {0, (int)DIM + 1};
+    for (int i = 0; i < 2; i++) {
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_OUT_T> matrixLStrm;
+        matrixAStrm.write(A[0][0]);
+        int ret = kernel_cholesky_dyn(matrixAStrm, matrixLStrm, bad_n[i]);
+        if (ret != 1 || matrixAStrm.size() != 1 || !matrixLStrm.empty()) {
+            std::cout << "ERROR: n = " << bad_n[i] << " returned " << ret << " or touched the streams" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
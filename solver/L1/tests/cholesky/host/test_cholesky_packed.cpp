@@ -0,0 +1,120 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for cholesky with packed stream layouts.
+// Each shared input matrix is factored three times: from the full
+// layout, from the packed triangle on the side of L (the kernel), and
+// from the packed triangle on the other side, which the function mirrors.
+// Both packed runs must stream out the triangle of L only, and match the
+// full-layout L on it bit for bit.
+// ======================================================================
+
+#include "kernel_cholesky_packed.hpp"
+#include "hw/cholesky.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+
+typedef xf::solver::choleskyTraits<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T> TRAITS;
+
+// Streams the lower (lower = true) or upper triangle of M row by row
+template <typename T>
+void writePacked(const T M[DIM][DIM], bool lower, hls::stream<T>& strm) {
+    for (int r = 0; r < DIM; r++)
+        for (int c = 0; c < DIM; c++)
+            if (lower ? c <= r : c >= r) strm.write(M[r][c]);
+}
+
+// Compares a packed L with the triangle of the full-layout L, returns the number of mismatches
+unsigned int comparePacked(hls::stream<MATRIX_OUT_T>& strm, const MATRIX_OUT_T L_expected[DIM][DIM]) {
+    unsigned int mismatch = 0;
+    for (int r = 0; r < DIM; r++)
+        for (int c = 0; c < DIM; c++)
+            if (LOWER_TRIANGULAR ? c <= r : c >= r)
+                if (strm.read() != L_expected[r][c]) mismatch++;
+    if (!strm.empty()) mismatch++;
+    return mismatch;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    MATRIX_OUT_T L_expected[DIM][DIM];
+
+    printf("Running packed cholesky on %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM, LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Same Side Mismatches,Mirrored Mismatches" << std::endl;
+
+    for (unsigned int imat = 0; imat < NUM_MAT_TYPES; imat++) {
+        std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(imat + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+
+        hls::stream<MATRIX_IN_T> fullAStrm;
+        hls::stream<MATRIX_OUT_T> fullLStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) fullAStrm.write(A[r][c]);
+        int ret_expected = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T>(fullAStrm, fullLStrm);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) L_expected[r][c] = fullLStrm.read();
+
+        // A on the side of L through the kernel
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_OUT_T> matrixLStrm;
+        writePacked(A, LOWER_TRIANGULAR, matrixAStrm);
+        int ret = kernel_cholesky_packed(matrixAStrm, matrixLStrm);
+        unsigned int mismatch = comparePacked(matrixLStrm, L_expected);
+
+        // A on the other side
+        hls::stream<MATRIX_IN_T> mirrorAStrm;
+        hls::stream<MATRIX_OUT_T> mirrorLStrm;
+        writePacked(A, !LOWER_TRIANGULAR, mirrorAStrm);
+        int ret_mirror;
+        if (LOWER_TRIANGULAR)
+            ret_mirror = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T, TRAITS,
+                                              xf::solver::PackedUpper>(mirrorAStrm, mirrorLStrm);
+        else
+            ret_mirror = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T, TRAITS,
+                                              xf::solver::PackedLower>(mirrorAStrm, mirrorLStrm);
+        unsigned int mirror_mismatch = comparePacked(mirrorLStrm, L_expected);
+
+        std::cout << "RESULTS_TABLE," << imat + 1 << "," << mismatch << "," << mirror_mismatch << std::endl;
+        if (ret != ret_expected || ret_mirror != ret_expected || mismatch != 0 || mirror_mismatch != 0) {
+            std::cout << "ERROR: matrix type " << imat + 1 << " packed cholesky returned " << ret << " and "
+                      << ret_mirror << " (expected " << ret_expected << ")" << std::endl;
+            pass_fail = 1;
+        }
+        if (!matrixAStrm.empty() || !mirrorAStrm.empty()) {
+            std::cout << "ERROR: packed A not fully consumed" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
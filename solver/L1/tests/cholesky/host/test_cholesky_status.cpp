@@ -0,0 +1,126 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for choleskyStatus.
+// The nine positive definite input types must report -1 and produce the
+// same L as cholesky, bit for bit. Three extra matrices check the pivot
+// predicate: a negated type 1 fails at column 0, an indefinite matrix
+// fails at column 1, and a singular matrix with an exact zero pivot also
+// fails at column 1 without writing L. cholesky reports only the negative
+// pivots, so it returns 0 for the singular matrix.
+// ======================================================================
+
+#include "kernel_cholesky_status.hpp"
+#include "hw/cholesky.hpp"
+#include "src/utils.hpp"
+
+#include <cmath>
+#include <stdio.h>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const int NUM_MAT_TYPES = 9;
+const int NUM_MATRICES = NUM_MAT_TYPES + 3;
+
+int main(int argc, char* argv[]) {
+    MATRIX_IN_T A[NUM_MATRICES][DIM][DIM];
+    int status_expected[NUM_MATRICES];
+    int ret_expected[NUM_MATRICES];
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    hls::stream<MATRIX_IN_T> matrixAStrm;
+    hls::stream<MATRIX_OUT_T> matrixLStrm;
+    hls::stream<int> statusStrm;
+
+    for (int m = 0; m < NUM_MATRICES; m++) {
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) A[m][r][c] = (r == c) ? 1 : 0;
+        status_expected[m] = -1;
+        ret_expected[m] = 0;
+    }
+    for (int m = 0; m < NUM_MAT_TYPES; m++) {
+        std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(m + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A[m]), DIM * DIM);
+    }
+    // Negated type 1: the first pivot is negative
+    for (int r = 0; r < DIM; r++)
+        for (int c = 0; c < DIM; c++) A[NUM_MAT_TYPES][r][c] = -A[0][r][c];
+    status_expected[NUM_MAT_TYPES] = 0;
+    ret_expected[NUM_MAT_TYPES] = 1;
+    // Indefinite: the second pivot is 1 - 2 * 2
+    A[NUM_MAT_TYPES + 1][0][1] = 2;
+    A[NUM_MAT_TYPES + 1][1][0] = 2;
+    status_expected[NUM_MAT_TYPES + 1] = 1;
+    ret_expected[NUM_MAT_TYPES + 1] = 1;
+    // Singular: the second pivot is exactly 0, which choleskyStatus reports and cholesky does not
+    A[NUM_MAT_TYPES + 2][0][1] = 1;
+    A[NUM_MAT_TYPES + 2][1][0] = 1;
+    status_expected[NUM_MAT_TYPES + 2] = 1;
+
+    for (int m = 0; m < NUM_MATRICES; m++)
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) matrixAStrm.write(A[m][r][c]);
+
+    printf("Running choleskyStatus on %d %d x %d matrices with LowerTriangular set to %d\n", NUM_MATRICES, DIM, DIM,
+           LOWER_TRIANGULAR);
+    kernel_cholesky_status(matrixAStrm, matrixLStrm, statusStrm, NUM_MATRICES);
+
+    for (int m = 0; m < NUM_MATRICES; m++) {
+        int status = statusStrm.read();
+
+        hls::stream<MATRIX_IN_T> refAStrm;
+        hls::stream<MATRIX_OUT_T> refLStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) refAStrm.write(A[m][r][c]);
+        int ret = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T>(refAStrm, refLStrm);
+
+        // L is only written for matrices that pass, and must then be finite and match cholesky
+        unsigned int mismatch = 0;
+        if (status < 0) {
+            for (int r = 0; r < DIM; r++) {
+                for (int c = 0; c < DIM; c++) {
+                    MATRIX_OUT_T l = matrixLStrm.read();
+                    MATRIX_OUT_T l_expected = refLStrm.read();
+                    if (l != l_expected || !std::isfinite(hls::x_real(l)) || !std::isfinite(hls::x_imag(l)))
+                        mismatch++;
+                }
+            }
+        }
+        std::cout << "RESULTS_TABLE," << m << "," << status << "," << ret << std::endl;
+        if (status != status_expected[m] || ret != ret_expected[m] || mismatch != 0) {
+            std::cout << "ERROR: matrix " << m << " status " << status << " (expected " << status_expected[m]
+                      << "), cholesky returned " << ret << " (expected " << ret_expected[m] << "), " << mismatch
+                      << " mismatching elements" << std::endl;
+            pass_fail = 1;
+        }
+    }
+    if (!matrixLStrm.empty() || !statusStrm.empty()) {
+        std::cout << "ERROR: unexpected extra output" << std::endl;
+        pass_fail = 1;
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for choleskyStream.
+// All input matrix types, followed by type 1 negated, are streamed through
+// one call. Each L is compared against the single-matrix cholesky run on the
+// same (exactly Hermitian) input: L must match bit for bit and the return
+// codes must agree. The negated matrix must be reported as indefinite.
+// ======================================================================
+
+#include "kernel_cholesky_stream.hpp"
+#include "hw/cholesky.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+const unsigned int NUM_MATRICES = NUM_MAT_TYPES + 1;
+
+int main(int argc, char* argv[]) {
+    MATRIX_IN_T A[NUM_MATRICES][DIM][DIM];
+    MATRIX_OUT_T L[DIM][DIM];
+    MATRIX_OUT_T L_expected[DIM][DIM];
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    printf("Running choleskyStream on %u %d x %d matrices with LowerTriangular set to %d\n", NUM_MATRICES, DIM, DIM,
+           LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Return Code,Expected Return Code,Mismatches" << std::endl;
+
+    hls::stream<MATRIX_IN_T> matrixAStrm;
+    hls::stream<MATRIX_OUT_T> matrixLStrm;
+    hls::stream<int> returnCodeStrm;
+
+    for (unsigned int m = 0; m < NUM_MATRICES; m++) {
+        // The last matrix reuses type 1 negated, which is not positive definite
+        bool negate = (m == NUM_MAT_TYPES);
+        std::string file_A =
+            std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(negate ? 1 : m + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A[m]), DIM * DIM);
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                if (negate) A[m][r][c] = -A[m][r][c];
+                matrixAStrm.write(A[m][r][c]);
+            }
+        }
+    }
+
+    kernel_cholesky_stream(matrixAStrm, matrixLStrm, returnCodeStrm, NUM_MATRICES);
+
+    for (unsigned int m = 0; m < NUM_MATRICES; m++) {
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) L[r][c] = matrixLStrm.read();
+        int ret = returnCodeStrm.read();
+
+        hls::stream<MATRIX_IN_T> refAStrm;
+        hls::stream<MATRIX_OUT_T> refLStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) refAStrm.write(A[m][r][c]);
+        int ret_expected = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T>(refAStrm, refLStrm);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) L_expected[r][c] = refLStrm.read();
+
+        unsigned int mismatch = 0;
+        if (ret_expected == 0) {
+            for (int r = 0; r < DIM; r++)
+                for (int c = 0; c < DIM; c++)
+                    if (L[r][c] != L_expected[r][c]) mismatch++;
+        }
+        std::cout << "RESULTS_TABLE," << m + 1 << "," << ret << "," << ret_expected << "," << mismatch << std::endl;
+        if (ret != ret_expected || mismatch != 0) {
+            std::cout << "ERROR: matrix " << m << " return code " << ret << " (expected " << ret_expected << "), "
+                      << mismatch << " mismatching elements" << std::endl;
+            pass_fail = 1;
+        }
+        if (m == NUM_MAT_TYPES && ret == 0) {
+            std::cout << "ERROR: indefinite matrix not reported" << std::endl;
+            pass_fail = 1;
+        }
+    }
+    if (!matrixAStrm.empty() || !matrixLStrm.empty() || !returnCodeStrm.empty()) {
+        std::cout << "ERROR: unexpected data left in the streams" << std::endl;
+        pass_fail = 1;
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for the systolic Cholesky architecture (ARCH 3).
+// Every input matrix type, followed by type 1 negated, is factored by the
+// ARCH 3 kernel and by the default architecture. The return codes must agree
+// and the negated matrix must be reported as indefinite. For the positive
+// definite inputs the reconstruction error
+//   norm1( L*L^H - A ) / ( N * norm1(A) * EPS )
+// must stay under the LAPACK threshold and L must match the default
+// architecture to within rounding.
+// ======================================================================
+
+#include "kernel_cholesky_systolic.hpp"
+#include "hw/cholesky.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+const unsigned int NUM_MATRICES = NUM_MAT_TYPES + 1;
+
+int main(int argc, char* argv[]) {
+    double ratio_threshold = 30.0; // Defined in lapack-X.Y.Z/TESTING/[s|d|c|x]test.in
+    double match_threshold = 1e-5; // Element difference to the default architecture, relative to sqrt(A_ii)
+    unsigned int pass_fail = 0;    // Pass=0 Fail =1
+    const double eps = std::numeric_limits<MATRIX_OUT_T>::epsilon();
+
+    MATRIX_IN_T A[DIM][DIM];
+    MATRIX_OUT_T L[DIM][DIM];
+    MATRIX_OUT_T L_expected[DIM][DIM];
+
+    printf("Running systolic cholesky on %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM,
+           LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Return Code,Expected Return Code,Ratio,Max Diff" << std::endl;
+
+    for (unsigned int m = 0; m < NUM_MATRICES; m++) {
+        // The last matrix reuses type 1 negated, which is not positive definite
+        bool negate = (m == NUM_MAT_TYPES);
+        std::string file_A =
+            std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(negate ? 1 : m + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_OUT_T> matrixLStrm;
+        hls::stream<MATRIX_IN_T> refAStrm;
+        hls::stream<MATRIX_OUT_T> refLStrm;
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                if (negate) A[r][c] = -A[r][c];
+                matrixAStrm.write(A[r][c]);
+                refAStrm.write(A[r][c]);
+            }
+        }
+        int ret = kernel_cholesky_systolic(matrixAStrm, matrixLStrm);
+        int ret_expected = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T>(refAStrm, refLStrm);
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                L[r][c] = matrixLStrm.read();
+                L_expected[r][c] = refLStrm.read();
+            }
+        }
+
+        double ratio = 0;
+        double maxDiff = 0;
+        if (ret_expected == 0) {
+            // norm1( L*L^H - A ), with L = U^H for the upper triangular factor
+            double normR = 0;
+            double normA = 0;
+            for (int c = 0; c < DIM; c++) {
+                double sR = 0;
+                double sA = 0;
+                for (int r = 0; r < DIM; r++) {
+                    double s = 0;
+                    for (int k = 0; k < DIM; k++) {
+                        if (LOWER_TRIANGULAR)
+                            s += (double)L[r][k] * L[c][k];
+                        else
+                            s += (double)L[k][r] * L[k][c];
+                    }
+                    sR += std::fabs(s - A[r][c]);
+                    sA += std::fabs(A[r][c]);
+
+                    // |L_rc| is bounded by sqrt(A_ii) of its row in L (column in U)
+                    double scale = std::sqrt(std::fabs((double)A[LOWER_TRIANGULAR ? r : c][LOWER_TRIANGULAR ? r : c]));
+                    double diff = std::fabs((double)L[r][c] - L_expected[r][c]) / scale;
+                    if (!(diff <= maxDiff)) maxDiff = diff;
+                }
+                if (sR > normR) normR = sR;
+                if (sA > normA) normA = sA;
+            }
+            ratio = normR / (DIM * normA * eps);
+        }
+
+        std::cout << "RESULTS_TABLE," << m + 1 << "," << ret << "," << ret_expected << "," << ratio << "," << maxDiff
+                  << std::endl;
+        if (ret != ret_expected || !(ratio <= ratio_threshold) || !(maxDiff <= match_threshold)) {
+            std::cout << "ERROR: matrix " << m << " return code " << ret << " (expected " << ret_expected
+                      << "), ratio " << ratio << ", max diff " << maxDiff << std::endl;
+            pass_fail = 1;
+        }
+        if (negate && ret == 0) {
+            std::cout << "ERROR: indefinite matrix not reported" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
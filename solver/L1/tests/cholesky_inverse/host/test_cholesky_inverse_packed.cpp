@@ -0,0 +1,109 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for choleskyInverse with packed stream layouts.
+// Each shared input matrix is inverted from the full layout, and from its
+// packed lower or upper triangle through the kernel, which carries the
+// factor and its inverse packed between the stages. The packed run must
+// match the full-layout inverse bit for bit, with the same success flag,
+// and A * A^-1 must be the identity up to the rounding of its terms.
+// ======================================================================
+
+#include "kernel_cholesky_inverse_packed.hpp"
+#include "hw/cholesky_inverse.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <cmath>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+
+int main(int argc, char* argv[]) {
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    MATRIX_OUT_T Ainv[DIM][DIM];
+
+    printf("Running packed choleskyInverse on %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM,
+           LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Mismatches,Max Rel Identity Error" << std::endl;
+
+    for (unsigned int imat = 0; imat < NUM_MAT_TYPES; imat++) {
+        std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(imat + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+
+        hls::stream<MATRIX_IN_T> fullAStrm;
+        hls::stream<MATRIX_OUT_T> fullInvStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) fullAStrm.write(A[r][c]);
+        int success_expected;
+        xf::solver::choleskyInverse<DIM, MATRIX_IN_T, MATRIX_OUT_T>(fullAStrm, fullInvStrm, success_expected);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) Ainv[r][c] = fullInvStrm.read();
+
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_OUT_T> matrixInverseAStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++)
+                if (LOWER_TRIANGULAR ? c <= r : c >= r) matrixAStrm.write(A[r][c]);
+        int success;
+        kernel_cholesky_inverse_packed(matrixAStrm, matrixInverseAStrm, success);
+
+        unsigned int mismatch = 0;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++)
+                if (matrixInverseAStrm.read() != Ainv[r][c]) mismatch++;
+
+        double maxErr = 0;
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                double s = 0;
+                double scale = 0;
+                for (int k = 0; k < DIM; k++) {
+                    s += (double)A[r][k] * Ainv[k][c];
+                    scale += std::fabs((double)A[r][k] * Ainv[k][c]);
+                }
+                double err = std::fabs(s - (r == c ? 1.0 : 0.0)) / scale;
+                if (err > maxErr) maxErr = err;
+            }
+        }
+
+        std::cout << "RESULTS_TABLE," << imat + 1 << "," << mismatch << "," << maxErr << std::endl;
+        if (success != success_expected || mismatch != 0 || (success == 0 && !(maxErr < 1e-3))) {
+            std::cout << "ERROR: matrix type " << imat + 1 << " packed choleskyInverse differs, success " << success
+                      << " (expected " << success_expected << ")" << std::endl;
+            pass_fail = 1;
+        }
+        if (!matrixAStrm.empty() || !matrixInverseAStrm.empty()) {
+            std::cout << "ERROR: packed streams not fully consumed" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for choleskyUpdate and choleskyDowndate.
+// The input matrices are shared with the cholesky test. The factor of each
+// A is updated with x, then the result is downdated with the same x. Each
+// factor F is accepted when the reconstruction error
+//   norm1( F*F^H - M ) / ( N * norm1(M) * EPS )
+// stays under the LAPACK threshold, with M = A + x*x^H after the update and
+// M = A after the downdate. Downdating the factor of A with twice its first
+// column leaves an indefinite matrix, which must return 1.
+// ======================================================================
+
+#include "kernel_cholesky_update.hpp"
+#include "hw/cholesky.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+
+// norm1( F*F^H - M ) / ( N * norm1(M) * EPS ), F is stored as L (lower) or U = L^H (upper)
+double reconRatio(const MATRIX_OUT_T F[DIM][DIM], const double M[DIM][DIM]) {
+    const double eps = std::numeric_limits<MATRIX_OUT_T>::epsilon();
+    double normR = 0;
+    double normM = 0;
+    for (int c = 0; c < DIM; c++) {
+        double sR = 0;
+        double sM = 0;
+        for (int r = 0; r < DIM; r++) {
+            double s = 0;
+            for (int k = 0; k < DIM; k++) {
+                if (LOWER_TRIANGULAR)
+                    s += (double)F[r][k] * F[c][k];
+                else
+                    s += (double)F[k][r] * F[k][c];
+            }
+            sR += std::fabs(s - M[r][c]);
+            sM += std::fabs(M[r][c]);
+        }
+        if (sR > normR) normR = sR;
+        if (sM > normM) normM = sM;
+    }
+    return normR / (DIM * normM * eps);
+}
+
+int kernelCall(const MATRIX_OUT_T L[DIM][DIM], const MATRIX_IN_T x[DIM], MATRIX_OUT_T L_upd[DIM][DIM], int downdate) {
+    hls::stream<MATRIX_OUT_T> matrixLStrm;
+    hls::stream<MATRIX_IN_T> vectorXStrm;
+    hls::stream<MATRIX_OUT_T> matrixLUpdStrm;
+    for (int r = 0; r < DIM; r++)
+        for (int c = 0; c < DIM; c++) matrixLStrm.write(L[r][c]);
+    for (int i = 0; i < DIM; i++) vectorXStrm.write(x[i]);
+    int ret = kernel_cholesky_update(matrixLStrm, vectorXStrm, matrixLUpdStrm, downdate);
+    for (int r = 0; r < DIM; r++)
+        for (int c = 0; c < DIM; c++) L_upd[r][c] = matrixLUpdStrm.read();
+    return ret;
+}
+
+int main(int argc, char* argv[]) {
+    double ratio_threshold = 30.0; // Defined in lapack-X.Y.Z/TESTING/[s|d|c|x]test.in
+    unsigned int pass_fail = 0;    // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    MATRIX_IN_T x[DIM];
+    MATRIX_OUT_T L[DIM][DIM];
+    MATRIX_OUT_T L_upd[DIM][DIM];
+    MATRIX_OUT_T L_dnd[DIM][DIM];
+    double M[DIM][DIM];
+
+    printf("Running choleskyUpdate/choleskyDowndate on %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM,
+           LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Update Ret,Update Ratio,Downdate Ret,Downdate Ratio,Indefinite Ret" << std::endl;
+
+    for (unsigned int imat = 0; imat < NUM_MAT_TYPES; imat++) {
+        std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(imat + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_OUT_T> matrixLStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) matrixAStrm.write(A[r][c]);
+        int ret = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_OUT_T>(matrixAStrm, matrixLStrm);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) L[r][c] = matrixLStrm.read();
+        if (ret != 0) {
+            std::cout << "ERROR: cholesky returned " << ret << " for matrix type " << imat + 1 << std::endl;
+            pass_fail = 1;
+            continue;
+        }
+
+        // x scaled to the diagonal of A so that x*x^H is comparable to A
+        for (int i = 0; i < DIM; i++) x[i] = ((i & 1) ? -0.5f : 0.75f) * std::sqrt(A[i][i]);
+
+        // A + x*x^H
+        int ret_upd = kernelCall(L, x, L_upd, 0);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) M[r][c] = (double)A[r][c] + (double)x[r] * x[c];
+        double ratio_upd = reconRatio(L_upd, M);
+
+        // (A + x*x^H) - x*x^H
+        int ret_dnd = kernelCall(L_upd, x, L_dnd, 1);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) M[r][c] = A[r][c];
+        double ratio_dnd = reconRatio(L_dnd, M);
+
+        // A - 4*l0*l0^H has a negative first pivot, l0 being the first column of L (first row of U)
+        MATRIX_IN_T x_bad[DIM];
+        for (int i = 0; i < DIM; i++) x_bad[i] = 2 * (LOWER_TRIANGULAR ? L[i][0] : L[0][i]);
+        int ret_bad = kernelCall(L, x_bad, L_dnd, 1);
+
+        std::cout << "RESULTS_TABLE," << imat + 1 << "," << ret_upd << "," << ratio_upd << "," << ret_dnd << ","
+                  << ratio_dnd << "," << ret_bad << std::endl;
+
+        if (ret_upd != 0 || !(ratio_upd <= ratio_threshold)) {
+            std::cout << "ERROR: update return code " << ret_upd << ", ratio " << ratio_upd << std::endl;
+            pass_fail = 1;
+        }
+        if (ret_dnd != 0 || !(ratio_dnd <= ratio_threshold)) {
+            std::cout << "ERROR: downdate return code " << ret_dnd << ", ratio " << ratio_dnd << std::endl;
+            pass_fail = 1;
+        }
+        if (ret_bad != 1) {
+            std::cout << "ERROR: indefinite downdate returned " << ret_bad << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for ldlt.
+// The input matrices are shared with the cholesky test. The factors are
+// accepted when the reconstruction error
+//   norm1( L*D*L^H - A ) / ( N * norm1(A) * EPS )
+// stays under the LAPACK threshold, L has a unit diagonal and the unused
+// triangle is zero. A negated (negative definite) matrix must factor as
+// well, and a singular matrix with a zero pivot must return 1.
+// ======================================================================
+
+#include "kernel_ldlt.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+
+// Column-sum (1-) norm of an N x N row-major matrix
+template <int N>
+double norm1(const double M[N][N]) {
+    double n = 0;
+    for (int c = 0; c < N; c++) {
+        double s = 0;
+        for (int r = 0; r < N; r++) s += std::fabs(M[r][c]);
+        if (s > n) n = s;
+    }
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    double ratio_threshold = 30.0; // Defined in lapack-X.Y.Z/TESTING/[s|d|c|x]test.in
+    const double eps = std::numeric_limits<MATRIX_OUT_T>::epsilon();
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    double A_dbl[DIM][DIM];
+    double L_dbl[DIM][DIM];
+    double D_dbl[DIM];
+    double R_dbl[DIM][DIM];
+
+    printf("Running ldlt on %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM, LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Return Code,DUT Ratio" << std::endl;
+
+    // Types 1..9, type 1 negated, then a singular matrix
+    for (unsigned int imat = 0; imat <= NUM_MAT_TYPES + 1; imat++) {
+        bool negate = (imat == NUM_MAT_TYPES);
+        bool singular = (imat == NUM_MAT_TYPES + 1);
+        if (singular) {
+            // The second pivot is 1 - 1 * 1 = 0
+            for (int r = 0; r < DIM; r++)
+                for (int c = 0; c < DIM; c++) A[r][c] = (r == c || r + c == 1) ? 1 : 0;
+        } else {
+            std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" +
+                                 std::to_string(negate ? 1 : imat + 1) + "_0.txt";
+            readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+        }
+
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_OUT_T> matrixLStrm;
+        hls::stream<MATRIX_OUT_T> matrixDStrm;
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                if (negate) A[r][c] = -A[r][c];
+                A_dbl[r][c] = A[r][c];
+                matrixAStrm.write(A[r][c]);
+            }
+        }
+
+        int ret = kernel_ldlt(matrixAStrm, matrixLStrm, matrixDStrm);
+
+        unsigned int bad_shape = 0;
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                double v = matrixLStrm.read();
+                // Work with the lower factor whichever triangle was output
+                bool inTri = LOWER_TRIANGULAR ? (c <= r) : (r <= c);
+                if (!inTri && v != 0) bad_shape++;
+                if (r == c && v != 1) bad_shape++;
+                if (LOWER_TRIANGULAR)
+                    L_dbl[r][c] = v;
+                else
+                    L_dbl[c][r] = v;
+            }
+        }
+        for (int i = 0; i < DIM; i++) D_dbl[i] = matrixDStrm.read();
+
+        if (singular) {
+            std::cout << "RESULTS_TABLE,-2," << ret << ",-" << std::endl;
+            if (ret != 1) {
+                std::cout << "ERROR: singular A returned " << ret << std::endl;
+                pass_fail = 1;
+            }
+            continue;
+        }
+
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                double s = 0;
+                for (int k = 0; k < DIM; k++) s += L_dbl[r][k] * D_dbl[k] * L_dbl[c][k];
+                R_dbl[r][c] = s - A_dbl[r][c];
+            }
+        }
+        double DUT_ratio = norm1<DIM>(R_dbl) / (DIM * norm1<DIM>(A_dbl) * eps);
+        std::cout << "RESULTS_TABLE," << (negate ? -1 : (int)imat + 1) << "," << ret << "," << DUT_ratio << std::endl;
+
+        if (ret != 0 || bad_shape != 0 || !(DUT_ratio <= ratio_threshold)) {
+            std::cout << "ERROR: return code " << ret << ", " << bad_shape << " misplaced elements, DUT_ratio("
+                      << DUT_ratio << ") > ratio_threshold(" << ratio_threshold << ")" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for ldltSolve.
+// The input matrices are shared with the cholesky test. B is built from a
+// known X, and the solution is accepted when the backward error
+//   norm1( A*X - B ) / ( N * norm1(A) * norm1(X) * EPS )
+// stays under the LAPACK threshold. LDL^H needs no positive definiteness,
+// so a negated (negative definite) matrix must be solved as well.
+// ======================================================================
+
+#include "kernel_ldlt_solve.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+
+// Column-sum (1-) norm of an R x C row-major matrix
+template <int R, int C>
+double norm1(const double M[R][C]) {
+    double n = 0;
+    for (int c = 0; c < C; c++) {
+        double s = 0;
+        for (int r = 0; r < R; r++) s += std::fabs(M[r][c]);
+        if (s > n) n = s;
+    }
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    double ratio_threshold = 30.0; // Defined in lapack-X.Y.Z/TESTING/[s|d|c|x]test.in
+    const double eps = std::numeric_limits<MATRIX_OUT_T>::epsilon();
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    double A_dbl[DIM][DIM];
+    double X_true[DIM][NRHS];
+    double X_dbl[DIM][NRHS];
+    double B_dbl[DIM][NRHS];
+    double R_dbl[DIM][NRHS];
+
+    // Known solution, distinct per column
+    for (int r = 0; r < DIM; r++)
+        for (int c = 0; c < NRHS; c++) X_true[r][c] = ((c & 1) ? -1.0 : 1.0) * (r + c + 1) / (DIM + NRHS);
+
+    printf("Running ldltSolve on %d x %d matrices with %d right-hand sides\n", DIM, DIM, NRHS);
+    std::cout << "RESULTS_TABLE,IMAT,Return Code,DUT Ratio" << std::endl;
+
+    for (unsigned int imat = 0; imat <= NUM_MAT_TYPES; imat++) {
+        // The last pass reuses type 1 negated, which is negative definite
+        bool negate = (imat == NUM_MAT_TYPES);
+        std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" +
+                             std::to_string(negate ? 1 : imat + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_IN_T> matrixBStrm;
+        hls::stream<MATRIX_OUT_T> matrixXStrm;
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                if (negate) A[r][c] = -A[r][c];
+                A_dbl[r][c] = A[r][c];
+                matrixAStrm.write(A[r][c]);
+            }
+        }
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < NRHS; c++) {
+                double s = 0;
+                for (int k = 0; k < DIM; k++) s += A_dbl[r][k] * X_true[k][c];
+                MATRIX_IN_T b = s;
+                B_dbl[r][c] = b;
+                matrixBStrm.write(b);
+            }
+        }
+
+        int ret = kernel_ldlt_solve(matrixAStrm, matrixBStrm, matrixXStrm);
+
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < NRHS; c++) X_dbl[r][c] = matrixXStrm.read();
+
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < NRHS; c++) {
+                double s = 0;
+                for (int k = 0; k < DIM; k++) s += A_dbl[r][k] * X_dbl[k][c];
+                R_dbl[r][c] = s - B_dbl[r][c];
+            }
+        }
+        double DUT_ratio = norm1<DIM, NRHS>(R_dbl) / (DIM * norm1<DIM, DIM>(A_dbl) * norm1<DIM, NRHS>(X_dbl) * eps);
+        std::cout << "RESULTS_TABLE," << (negate ? -1 : (int)imat + 1) << "," << ret << "," << DUT_ratio << std::endl;
+
+        if (ret != 0 || !(DUT_ratio <= ratio_threshold)) {
+            std::cout << "ERROR: return code " << ret << ", DUT_ratio(" << DUT_ratio << ") > ratio_threshold("
+                      << ratio_threshold << ")" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ======================================================================
+// Testbench for matrixMultiply with a packed triangular A.
+// The Cholesky factor of each shared input matrix is streamed packed and
+// multiplied by its own conjugate transpose. The product must match the
+// full-layout matrixMultiply on the zero-filled factor bit for bit, and
+// reconstruct the input matrix. The two-stream matrixMultiply is checked
+// the same way with a small fixed B.
+// ======================================================================
+
+#include "kernel_matrix_multiply_packed.hpp"
+#include "hw/cholesky.hpp"
+#include "hw/matrix_multiply.hpp"
+#include "src/utils.hpp"
+
+#include <stdio.h>
+#include <cmath>
+#include <string>
+
+#define STRINGIZE(x) #x
+#define TOSTR(x) STRINGIZE(x)
+#define DATA_PATH TOSTR(_DATA_PATH)
+
+const unsigned int NUM_MAT_TYPES = 9;
+
+typedef xf::solver::NoTranspose NT;
+typedef xf::solver::ConjugateTranspose CT;
+
+int main(int argc, char* argv[]) {
+    unsigned int pass_fail = 0; // Pass=0 Fail =1
+
+    MATRIX_IN_T A[DIM][DIM];
+    MATRIX_IN_T L[DIM][DIM];
+    MATRIX_OUT_T C[DIM][DIM];
+    MATRIX_OUT_T C_expected[DIM][DIM];
+
+    printf("Running packed matrixMultiply on %d x %d matrices with LowerTriangular set to %d\n", DIM, DIM,
+           LOWER_TRIANGULAR);
+    std::cout << "RESULTS_TABLE,IMAT,Power Mismatches,Product Mismatches,Max Rel Error" << std::endl;
+
+    for (unsigned int imat = 0; imat < NUM_MAT_TYPES; imat++) {
+        std::string file_A = std::string(DATA_PATH) + "/float/A_matType_" + std::to_string(imat + 1) + "_0.txt";
+        readTxt(file_A, reinterpret_cast<MATRIX_IN_T*>(A), DIM * DIM);
+
+        hls::stream<MATRIX_IN_T> matrixAStrm;
+        hls::stream<MATRIX_IN_T> matrixLStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) matrixAStrm.write(A[r][c]);
+        int ret = xf::solver::cholesky<LOWER_TRIANGULAR, DIM, MATRIX_IN_T, MATRIX_IN_T>(matrixAStrm, matrixLStrm);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) L[r][c] = matrixLStrm.read();
+        if (ret != 0) {
+            std::cout << "ERROR: cholesky returned " << ret << " for matrix type " << imat + 1 << std::endl;
+            pass_fail = 1;
+            continue;
+        }
+
+        // L * L^H, or U^H * U, from the packed factor
+        hls::stream<MATRIX_IN_T> packedStrm;
+        hls::stream<MATRIX_OUT_T> matrixCStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++)
+                if (LOWER_TRIANGULAR ? c <= r : c >= r) packedStrm.write(L[r][c]);
+        kernel_matrix_multiply_packed(packedStrm, matrixCStrm);
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) C[r][c] = matrixCStrm.read();
+
+        hls::stream<MATRIX_IN_T> fullStrm;
+        hls::stream<MATRIX_OUT_T> refCStrm;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++) fullStrm.write(L[r][c]);
+        if (LOWER_TRIANGULAR)
+            xf::solver::matrixMultiply<NT, CT, DIM, DIM, DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T>(fullStrm, refCStrm);
+        else
+            xf::solver::matrixMultiply<CT, NT, DIM, DIM, DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T>(fullStrm, refCStrm);
+
+        unsigned int powerMismatch = 0;
+        double maxRelErr = 0;
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                C_expected[r][c] = refCStrm.read();
+                if (C[r][c] != C_expected[r][c]) powerMismatch++;
+                double err = std::fabs((double)C[r][c] - A[r][c]) / (std::fabs((double)A[r][c]) + 1.0);
+                if (err > maxRelErr) maxRelErr = err;
+            }
+        }
+
+        // L * B through the two-stream matrixMultiply, B is kept small so the product cannot overflow
+        typedef xf::solver::matrixMultiplyTraits<NT, NT, DIM, DIM, DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T> TRAITS;
+        hls::stream<MATRIX_IN_T> packed2Strm;
+        hls::stream<MATRIX_IN_T> full2Strm;
+        hls::stream<MATRIX_IN_T> matrixBStrm;
+        hls::stream<MATRIX_IN_T> refBStrm;
+        hls::stream<MATRIX_OUT_T> prodStrm;
+        hls::stream<MATRIX_OUT_T> refProdStrm;
+        for (int r = 0; r < DIM; r++) {
+            for (int c = 0; c < DIM; c++) {
+                if (LOWER_TRIANGULAR ? c <= r : c >= r) packed2Strm.write(L[r][c]);
+                full2Strm.write(L[r][c]);
+                MATRIX_IN_T b = r - 2 * c + 1;
+                matrixBStrm.write(b);
+                refBStrm.write(b);
+            }
+        }
+        if (LOWER_TRIANGULAR)
+            xf::solver::matrixMultiply<NT, NT, DIM, DIM, DIM, DIM, DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T, TRAITS,
+                                       xf::solver::PackedLower>(packed2Strm, matrixBStrm, prodStrm);
+        else
+            xf::solver::matrixMultiply<NT, NT, DIM, DIM, DIM, DIM, DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T, TRAITS,
+                                       xf::solver::PackedUpper>(packed2Strm, matrixBStrm, prodStrm);
+        xf::solver::matrixMultiply<NT, NT, DIM, DIM, DIM, DIM, DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T>(full2Strm, refBStrm,
+                                                                                                  refProdStrm);
+        unsigned int productMismatch = 0;
+        for (int r = 0; r < DIM; r++)
+            for (int c = 0; c < DIM; c++)
+                if (prodStrm.read() != refProdStrm.read()) productMismatch++;
+
+        std::cout << "RESULTS_TABLE," << imat + 1 << "," << powerMismatch << "," << productMismatch << ","
+                  << maxRelErr << std::endl;
+        if (powerMismatch != 0 || productMismatch != 0 || !(maxRelErr < 1e-4)) {
+            std::cout << "ERROR: matrix type " << imat + 1 << " packed result differs" << std::endl;
+            pass_fail = 1;
+        }
+        if (!packedStrm.empty() || !packed2Strm.empty()) {
+            std::cout << "ERROR: packed A not fully consumed" << std::endl;
+            pass_fail = 1;
+        }
+    }
+
+    if (pass_fail) {
+        std::cout << "TB:Fail" << std::endl;
+    } else {
+        std::cout << "TB:Pass" << std::endl;
+    }
+    std::cout << "" << std::endl;
+    return (pass_fail);
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kernel_matrix_multiply_packed.hpp"
+#include "xf_solver_L1.hpp"
+
+extern void kernel_matrix_multiply_packed(hls::stream<MATRIX_IN_T>& matrixAStrm,
+                                          hls::stream<MATRIX_OUT_T>& matrixCStrm) {
+    if (LOWER_TRIANGULAR) {
+        typedef xf::solver::matrixMultiplyTraits<xf::solver::NoTranspose, xf::solver::ConjugateTranspose, DIM, DIM,
+                                                 DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T>
+            TRAITS;
+        xf::solver::matrixMultiply<xf::solver::NoTranspose, xf::solver::ConjugateTranspose, DIM, DIM, DIM, DIM,
+                                   MATRIX_IN_T, MATRIX_OUT_T, TRAITS, xf::solver::PackedLower>(matrixAStrm,
+                                                                                               matrixCStrm);
+    } else {
+        typedef xf::solver::matrixMultiplyTraits<xf::solver::ConjugateTranspose, xf::solver::NoTranspose, DIM, DIM,
+                                                 DIM, DIM, MATRIX_IN_T, MATRIX_OUT_T>
+            TRAITS;
+        xf::solver::matrixMultiply<xf::solver::ConjugateTranspose, xf::solver::NoTranspose, DIM, DIM, DIM, DIM,
+                                   MATRIX_IN_T, MATRIX_OUT_T, TRAITS, xf::solver::PackedUpper>(matrixAStrm,
+                                                                                               matrixCStrm);
+    }
+}
@@ -0,0 +1,427 @@
+/*
+ * (c) Copyright 2019-2022 Xilinx, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Host-side range analysis and bit-width selection for the fixed-point choleskyTraits.
+//
+// The input/output types come from the dut_type.hpp of a Cholesky test case, the matrices from its data files.
+// 1. The C model of cholesky (choleskyTop with the stock choleskyTraits) is run over the matrix set and its error
+//    against a double-precision factorization is measured. Unless -err is given this is the error bound.
+// 2. A bit-accurate model of the ARCH=2 (choleskyAlt2) datapath records the peak magnitude of every internal type,
+//    which fixes its integer bits, then the fractional bits of each type are reduced one at a time while the
+//    error stays within the bound.
+// 3. The result is printed as a choleskyTraitsTuned struct deriving from choleskyTraits, ready to be passed as the
+//    TRAITS argument of cholesky.
+// Rebuilding with -DCHOLESKY_TUNED_TRAITS='"<emitted header>"' runs the C model with the emitted struct as well,
+// so the selection can be checked against the real datapath.
+//
+// Build:
+//   g++ -std=c++14 -O2 -I$XILINX_HLS/include -I../../../L1/include/hw -I../../../L1/tests/cholesky/<case> \
+//       -DMATRIX_DIM=3 cholesky_traits_model.cpp -o cholesky_traits_model
+// Run:
+//   ./cholesky_traits_model [-err <max |L - L_ref|>] [-guard <bits>] [-o <header>] <A file> [<A file> ...]
+
+#include "hls_stream.h"
+#include "ap_fixed.h"
+#include "hls_x_complex.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cholesky.hpp"
+#include "dut_type.hpp"
+
+#ifdef CHOLESKY_TUNED_TRAITS
+#include CHOLESKY_TUNED_TRAITS
+#endif
+
+#if XF_SOLVER_FORCE_ARCH != 2
+#error "cholesky_traits_model models the ARCH=2 datapath, build with XF_SOLVER_FORCE_ARCH=2"
+#endif
+
+#ifndef MATRIX_DIM
+#define MATRIX_DIM 3
+#endif
+
+namespace {
+
+typedef std::complex<double> cd;
+
+const int DIM = MATRIX_DIM;
+
+// ---------------------------------------------------------------------------------------------
+// Fixed-point formats
+// ---------------------------------------------------------------------------------------------
+template <class T>
+struct fixedFormat {
+    static const bool IsFixed = false;
+    static const bool IsComplex = false;
+    static const int W = 0;
+    static const int I = 0;
+};
+template <int W1, int I1, ap_q_mode Q1, ap_o_mode O1, int N1>
+struct fixedFormat<ap_fixed<W1, I1, Q1, O1, N1> > {
+    static const bool IsFixed = true;
+    static const bool IsComplex = false;
+    static const int W = W1;
+    static const int I = I1;
+};
+template <class T>
+struct fixedFormat<hls::x_complex<T> > : fixedFormat<T> {
+    static const bool IsComplex = true;
+};
+template <class T>
+struct fixedFormat<std::complex<T> > : fixedFormat<T> {
+    static const bool IsComplex = true;
+};
+
+template <class T>
+T fromDouble(cd v, T*) {
+    return T(v.real());
+}
+template <class T>
+hls::x_complex<T> fromDouble(cd v, hls::x_complex<T>*) {
+    return hls::x_complex<T>(T(v.real()), T(v.imag()));
+}
+template <class T>
+std::complex<T> fromDouble(cd v, std::complex<T>*) {
+    return std::complex<T>(T(v.real()), T(v.imag()));
+}
+template <class T>
+cd toDouble(const T& v) {
+    return cd((double)hls::x_real(v), (double)hls::x_imag(v));
+}
+
+struct Fmt {
+    int W;
+    int I;
+};
+
+enum { T_PROD = 0, T_ACCUM, T_ADD, T_DIAG, T_RECIP, T_OFF_DIAG, T_NUM };
+const char* c_typeName[T_NUM] = {"PROD_T", "ACCUM_T", "ADD_T", "DIAG_T", "RECIP_DIAG_T", "OFF_DIAG_T"};
+
+int bitWidth(int n) {
+    int v = 0;
+    for (; n > 0; n /= 2) ++v;
+    return v;
+}
+
+// Formats of the stock ap_fixed choleskyTraits
+void stockFormats(Fmt fmt[T_NUM], Fmt in, Fmt out) {
+    fmt[T_PROD] = {in.W + in.W, in.I + in.I};
+    fmt[T_ACCUM] = {in.W + in.W + bitWidth(DIM), in.I + in.I + bitWidth(DIM)};
+    fmt[T_ADD] = {in.W + 1, in.I + 1};
+    fmt[T_DIAG] = {(in.W + 1) * 2, in.I + 1};
+    fmt[T_OFF_DIAG] = {(in.W + 1) * 2, in.I + 1};
+    fmt[T_RECIP] = {2 + (out.W - out.I) + out.W, 2 + (out.W - out.I)};
+}
+
+// ---------------------------------------------------------------------------------------------
+// Bit-accurate model of the choleskyAlt2 datapath
+// ---------------------------------------------------------------------------------------------
+// AP_RND_CONV + AP_SAT conversion, or truncation as done by the ap_fixed division
+double quant(double x, Fmt f, bool trunc = false) {
+    double s = std::ldexp(1.0, f.W - f.I);
+    double y = trunc ? std::trunc(x * s) : std::nearbyint(x * s);
+    double lo = -std::ldexp(1.0, f.W - 1);
+    double hi = std::ldexp(1.0, f.W - 1) - 1;
+    return std::min(std::max(y, lo), hi) / s;
+}
+
+struct Model {
+    Fmt fmt[T_NUM];
+    Fmt out;
+    double peak[T_NUM];
+
+    void see(int t, cd v) { peak[t] = std::max(peak[t], std::max(std::fabs(v.real()), std::fabs(v.imag()))); }
+    cd q(int t, cd v) {
+        see(t, v);
+        return cd(quant(v.real(), fmt[t]), quant(v.imag(), fmt[t]));
+    }
+    double q(int t, double v) {
+        see(t, v);
+        return quant(v, fmt[t]);
+    }
+    cd qOut(cd v) { return cd(quant(v.real(), out), quant(v.imag(), out)); }
+
+    // Returns false when a pivot is not positive
+    bool factor(const std::vector<cd>& A, std::vector<cd>& L) {
+        std::vector<cd> diagSum(DIM, 0);
+        L.assign(DIM * DIM, 0);
+        for (int j = 0; j < DIM; j++) {
+            cd Ajj = q(T_ACCUM, A[j * DIM + j]);
+            cd Aminus = q(T_ADD, Ajj - diagSum[j]);
+            double x = q(T_DIAG, Aminus).real();
+            if (x <= 0) return false;
+            // cholesky_rsqrt for ap_fixed
+            double s = q(T_DIAG, std::sqrt(x));
+            double sc = q(T_RECIP, s);
+            if (sc <= 0) return false;
+            see(T_RECIP, 1.0 / sc);
+            double invLjj = quant(1.0 / sc, fmt[T_RECIP], true);
+            double Ljj = q(T_RECIP, x * invLjj);
+            L[j * DIM + j] = qOut(Ljj);
+            for (int i = j + 1; i < DIM; i++) {
+                cd psum = q(T_ACCUM, A[i * DIM + j]);
+                for (int k = 0; k < j; k++) {
+                    cd pr = q(T_PROD, L[i * DIM + k] * -std::conj(L[j * DIM + k]));
+                    psum = q(T_ACCUM, psum + pr);
+                }
+                cd off = q(T_OFF_DIAG, psum);
+                cd Lij = q(T_OFF_DIAG, off * invLjj);
+                cd Lout = qOut(Lij);
+                L[i * DIM + j] = Lout;
+                diagSum[i] = q(T_ACCUM, diagSum[i] + q(T_ACCUM, std::conj(Lout) * Lout));
+            }
+        }
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------
+// Reference and error
+// ---------------------------------------------------------------------------------------------
+void refCholesky(const std::vector<cd>& A, std::vector<cd>& L) {
+    L.assign(DIM * DIM, 0);
+    for (int j = 0; j < DIM; j++) {
+        double d = A[j * DIM + j].real();
+        for (int k = 0; k < j; k++) d -= std::norm(L[j * DIM + k]);
+        L[j * DIM + j] = std::sqrt(d);
+        for (int i = j + 1; i < DIM; i++) {
+            cd s = A[i * DIM + j];
+            for (int k = 0; k < j; k++) s -= L[i * DIM + k] * std::conj(L[j * DIM + k]);
+            L[i * DIM + j] = s / L[j * DIM + j].real();
+        }
+    }
+}
+
+double maxError(const std::vector<cd>& L, const std::vector<cd>& Lref) {
+    double e = 0;
+    for (int i = 0; i < DIM; i++) {
+        for (int j = 0; j <= i; j++) {
+            double d = std::abs(L[i * DIM + j] - Lref[i * DIM + j]);
+            if (!(d == d)) return DBL_MAX;
+            e = std::max(e, d);
+        }
+    }
+    return e;
+}
+
+struct MatrixSet {
+    std::vector<std::vector<cd> > A;
+    std::vector<std::vector<cd> > Lref;
+};
+
+double modelError(Model& m, const MatrixSet& set) {
+    double e = 0;
+    std::vector<cd> L;
+    for (size_t n = 0; n < set.A.size(); ++n) {
+        if (!m.factor(set.A[n], L)) return DBL_MAX;
+        e = std::max(e, maxError(L, set.Lref[n]));
+    }
+    return e;
+}
+
+// Runs the C model with the given traits over the set
+template <class TRAITS>
+double cModelError(const MatrixSet& set) {
+    double e = 0;
+    for (size_t n = 0; n < set.A.size(); ++n) {
+        MATRIX_IN_T A[DIM][DIM];
+        MATRIX_OUT_T L[DIM][DIM];
+        for (int i = 0; i < DIM * DIM; i++) A[i / DIM][i % DIM] = fromDouble(set.A[n][i], (MATRIX_IN_T*)0);
+        if (xf::solver::choleskyTop<true, DIM, TRAITS, MATRIX_IN_T, MATRIX_OUT_T>(A, L)) return DBL_MAX;
+        std::vector<cd> Lc(DIM * DIM);
+        for (int i = 0; i < DIM * DIM; i++) Lc[i] = toDouble(L[i / DIM][i % DIM]);
+        e = std::max(e, maxError(Lc, set.Lref[n]));
+    }
+    return e;
+}
+
+// One value, or "real imag", per line; commas are accepted as separators
+bool readMatrix(const char* file, std::vector<cd>& A) {
+    std::ifstream in(file);
+    if (!in.is_open()) return false;
+    A.clear();
+    std::string line;
+    while (std::getline(in, line) && (int)A.size() < DIM * DIM) {
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::stringstream ss(line);
+        double re = 0, im = 0;
+        if (!(ss >> re)) continue;
+        ss >> im;
+        // The factorization sees the values as converted to the input type
+        A.push_back(toDouble(fromDouble(cd(re, im), (MATRIX_IN_T*)0)));
+    }
+    return (int)A.size() == DIM * DIM;
+}
+
+std::string typeString(Fmt f, bool isComplex) {
+    std::stringstream ss;
+    ss << "ap_fixed<" << f.W << ", " << f.I << ", AP_RND_CONV, AP_SAT, 0>";
+    return isComplex ? "hls::x_complex<" + ss.str() + " >" : ss.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    typedef fixedFormat<MATRIX_IN_T> InFmt;
+    typedef fixedFormat<MATRIX_OUT_T> OutFmt;
+    if (!InFmt::IsFixed || !OutFmt::IsFixed) {
+        std::cout << "MATRIX_IN_T and MATRIX_OUT_T must be ap_fixed or complex ap_fixed" << std::endl;
+        return 1;
+    }
+
+    double errBound = -1;
+    int guard = 0;
+    std::string outFile;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-err" && i + 1 < argc) {
+            errBound = atof(argv[++i]);
+        } else if (a == "-guard" && i + 1 < argc) {
+            guard = atoi(argv[++i]);
+        } else if (a == "-o" && i + 1 < argc) {
+            outFile = argv[++i];
+        } else {
+            files.push_back(a);
+        }
+    }
+    if (files.empty()) {
+        std::cout << "Usage: " << argv[0] << " [-err <max |L - L_ref|>] [-guard <bits>] [-o <header>] <A file> [<A file> ...]"
+                  << std::endl;
+        return 1;
+    }
+
+    MatrixSet set;
+    for (size_t f = 0; f < files.size(); ++f) {
+        std::vector<cd> A, Lref;
+        if (!readMatrix(files[f].c_str(), A)) {
+            std::cout << "Cannot read a " << DIM << "x" << DIM << " matrix from: " << files[f] << std::endl;
+            return 1;
+        }
+        refCholesky(A, Lref);
+        if (!(Lref[DIM * DIM - 1].real() > 0)) {
+            std::cout << "Skipping non positive definite matrix: " << files[f] << std::endl;
+            continue;
+        }
+        set.A.push_back(A);
+        set.Lref.push_back(Lref);
+    }
+    if (set.A.empty()) return 1;
+
+    const Fmt in = {InFmt::W, InFmt::I};
+    const Fmt out = {OutFmt::W, OutFmt::I};
+    Model m;
+    m.out = out;
+    stockFormats(m.fmt, in, out);
+    Fmt stock[T_NUM];
+    std::copy(m.fmt, m.fmt + T_NUM, stock);
+
+    // 1. Stock traits through the C model
+    double stockErr = cModelError<xf::solver::choleskyTraits<true, DIM, MATRIX_IN_T, MATRIX_OUT_T> >(set);
+    std::fill(m.peak, m.peak + T_NUM, 0.0);
+    double stockModelErr = modelError(m, set);
+    std::cout << set.A.size() << " matrices, " << DIM << "x" << DIM << std::endl;
+    std::cout << "stock traits: C model error " << stockErr << ", datapath model error " << stockModelErr
+              << std::endl;
+    if (errBound < 0) errBound = stockErr;
+    std::cout << "error bound:  " << errBound << std::endl;
+
+    // 2. Integer bits from the peak magnitudes, then the fractional bits one type at a time
+    Fmt best[T_NUM];
+    for (int t = 0; t < T_NUM; ++t) {
+        int I = 1;
+        while (std::ldexp(1.0, I - 1) <= m.peak[t]) ++I;
+        I += guard;
+        best[t].I = I;
+        best[t].W = I + std::max(stock[t].W - stock[t].I, 0);
+    }
+    std::copy(best, best + T_NUM, m.fmt);
+    if (modelError(m, set) > errBound) {
+        std::cout << "The stock fractional widths do not meet the bound, relax -err or add -guard bits" << std::endl;
+        return 1;
+    }
+    // Two passes, the widest types first since they are the most expensive
+    const int c_order[T_NUM] = {T_ACCUM, T_PROD, T_OFF_DIAG, T_DIAG, T_RECIP, T_ADD};
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int o = 0; o < T_NUM; ++o) {
+            int t = c_order[o];
+            int lo = 0;
+            int hi = best[t].W - best[t].I;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                std::copy(best, best + T_NUM, m.fmt);
+                m.fmt[t].W = best[t].I + mid;
+                if (modelError(m, set) <= errBound)
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            best[t].W = best[t].I + lo;
+        }
+    }
+    std::copy(best, best + T_NUM, m.fmt);
+    double tunedErr = modelError(m, set);
+
+    std::cout << std::left << std::setw(14) << "type" << std::right << std::setw(12) << "stock W,I" << std::setw(12)
+              << "tuned W,I" << std::setw(12) << "peak" << std::endl;
+    int stockBits = 0;
+    int tunedBits = 0;
+    for (int t = 0; t < T_NUM; ++t) {
+        std::stringstream s0, s1;
+        s0 << stock[t].W << "," << stock[t].I;
+        s1 << best[t].W << "," << best[t].I;
+        std::cout << std::left << std::setw(14) << c_typeName[t] << std::right << std::setw(12) << s0.str()
+                  << std::setw(12) << s1.str() << std::setw(12) << m.peak[t] << std::endl;
+        stockBits += stock[t].W;
+        tunedBits += best[t].W;
+    }
+    std::cout << "datapath model error with tuned traits " << tunedErr << ", " << tunedBits << " bits vs "
+              << stockBits << std::endl;
+
+    // 3. Emit the traits
+    std::stringstream hdr;
+    hdr << "// Generated by cholesky_traits_model: " << DIM << "x" << DIM << ", " << set.A.size()
+        << " matrices, max |L - L_ref| " << tunedErr << " (bound " << errBound << ")\n";
+    hdr << "template <bool LowerTriangularL, int RowsColsA, typename InputType, typename OutputType>\n";
+    hdr << "struct choleskyTraitsTuned : xf::solver::choleskyTraits<LowerTriangularL, RowsColsA, InputType, "
+           "OutputType> {\n";
+    for (int t = 0; t < T_NUM; ++t) {
+        hdr << "    typedef " << typeString(best[t], InFmt::IsComplex && t != T_RECIP) << " " << c_typeName[t]
+            << ";\n";
+    }
+    hdr << "};\n";
+    std::cout << std::endl << hdr.str();
+    if (!outFile.empty()) {
+        std::ofstream of(outFile.c_str());
+        of << hdr.str();
+    }
+
+#ifdef CHOLESKY_TUNED_TRAITS
+    std::cout << "C model error with " << CHOLESKY_TUNED_TRAITS << ": "
+              << cModelError<choleskyTraitsTuned<true, DIM, MATRIX_IN_T, MATRIX_OUT_T> >(set) << std::endl;
+#endif
+    return 0;
+}